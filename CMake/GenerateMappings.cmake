@@ -1,5 +1,10 @@
 # Usage:
-# cmake -P GenerateMappings.cmake <path/to/mappings.h.in> <path/to/mappings.h>
+# cmake -P GenerateMappings.cmake <path/to/mappings.h.in> <path/to/mappings.h> [path/to/gamecontrollerdb.txt]
+#
+# The mappings are parsed here and written out as sorted tables of pre-parsed
+# _GLFWmapping structs, one per platform, so that GLFW does not have to parse
+# them at initialization.  If no database file is given, the latest version is
+# downloaded from SDL_GameControllerDB.
 
 set(source_url "https://raw.githubusercontent.com/gabomdq/SDL_GameControllerDB/master/gamecontrollerdb.txt")
 set(source_path "${CMAKE_CURRENT_BINARY_DIR}/gamecontrollerdb.txt")
@@ -10,24 +15,240 @@ if (NOT EXISTS "${template_path}")
     message(FATAL_ERROR "Failed to find template file ${template_path}")
 endif()
 
-file(DOWNLOAD "${source_url}" "${source_path}"
-     STATUS download_status
-     TLS_VERIFY on)
+if (CMAKE_ARGV5)
+    set(database_path "${CMAKE_ARGV5}")
+    if (NOT EXISTS "${database_path}")
+        message(FATAL_ERROR "Failed to find database file ${database_path}")
+    endif()
+else()
+    set(database_path "${source_path}")
+
+    file(DOWNLOAD "${source_url}" "${source_path}"
+         STATUS download_status
+         TLS_VERIFY on)
 
-list(GET download_status 0 status_code)
-list(GET download_status 1 status_message)
+    list(GET download_status 0 status_code)
+    list(GET download_status 1 status_message)
 
-if (status_code)
-    message(FATAL_ERROR "Failed to download ${source_url}: ${status_message}")
+    if (status_code)
+        message(FATAL_ERROR "Failed to download ${source_url}: ${status_message}")
+    endif()
 endif()
 
-file(STRINGS "${source_path}" lines)
+# The platforms with a table of their own, as mapping platform names and the
+# identifiers used for their variables below
+set(platform_names "Windows" "Mac OS X" "Linux" "Android")
+set(platform_ids win32 cocoa linux android)
+
+# The gamepad buttons and axes in the order of their GLFW tokens
+set(button_fields a b x y leftshoulder rightshoulder back start guide
+                  leftstick rightstick dpup dpright dpdown dpleft)
+set(axis_fields leftx lefty rightx righty lefttrigger righttrigger)
+
+# Formats a multiple of one half as a float literal
+function(format_halves value result)
+    set(sign "")
+    if (value LESS 0)
+        set(sign "-")
+        math(EXPR value "-(${value})")
+    endif()
+    math(EXPR whole "${value} / 2")
+    math(EXPR fraction "${value} % 2")
+    if (fraction)
+        set(${result} "${sign}${whole}.5f" PARENT_SCOPE)
+    elseif (whole)
+        set(${result} "${sign}${whole}.f" PARENT_SCOPE)
+    else()
+        set(${result} "0.f" PARENT_SCOPE)
+    endif()
+endfunction()
+
+# Converts a mapping element like a2, +a3~, b10 or h0.4 with the specified
+# output range into an initializer for _GLFWmapelement, matching what
+# parseMapping in input.c would produce
+function(parse_element value output_from output_to result)
+    if (NOT "${value}" MATCHES "^([+-]?)([abh])([0-9]+)(\\.([0-9]+))?(~?)")
+        set(${result} "{0}" PARENT_SCOPE)
+        return()
+    endif()
+
+    # Buttons and hat bits go from zero to one
+    set(input_from 0)
+    set(input_to 1)
+    set(index ${CMAKE_MATCH_3})
+
+    if ("${CMAKE_MATCH_2}" STREQUAL "a")
+        set(type 1)
+        set(input_from -1)
+        if ("${CMAKE_MATCH_1}" STREQUAL "+")
+            set(input_from 0)
+        elseif ("${CMAKE_MATCH_1}" STREQUAL "-")
+            set(input_from 0)
+            set(input_to -1)
+        endif()
+        if ("${CMAKE_MATCH_6}" STREQUAL "~")
+            set(from ${input_from})
+            set(input_from ${input_to})
+            set(input_to ${from})
+        endif()
+    elseif ("${CMAKE_MATCH_2}" STREQUAL "b")
+        set(type 2)
+    else()
+        set(type 3)
+        if ("${CMAKE_MATCH_5}" STREQUAL "")
+            set(CMAKE_MATCH_5 0)
+        endif()
+        math(EXPR index "(${CMAKE_MATCH_3} << 4) | ${CMAKE_MATCH_5}")
+    endif()
+
+    # The scale and offset are multiples of one half for every combination of
+    # input and output ranges, so they are calculated in halves
+    math(EXPR scale "2 * (${output_to} - (${output_from})) / (${input_to} - (${input_from}))")
+    math(EXPR offset "2 * ${output_from} - (${input_from}) * ${scale}")
+    format_halves(${scale} scale)
+    format_halves(${offset} offset)
+
+    if (output_from LESS output_to)
+        set(range "${output_from},${output_to}")
+    else()
+        set(range "${output_to},${output_from}")
+    endif()
+
+    set(${result} "{${type},${index},${range},${scale},${offset}}" PARENT_SCOPE)
+endfunction()
+
+# Applies the GUID conversion done by _glfwPlatformUpdateGamepadGUID
+function(update_guid platform guid result)
+    string(SUBSTRING "${guid}" 0 4 vendor)
+    if ("${platform}" STREQUAL "win32")
+        string(SUBSTRING "${guid}" 20 12 tail)
+        if ("${tail}" STREQUAL "504944564944")
+            string(SUBSTRING "${guid}" 4 4 product)
+            set(guid "03000000${vendor}0000${product}000000000000")
+        endif()
+    elseif ("${platform}" STREQUAL "cocoa")
+        string(SUBSTRING "${guid}" 4 12 middle)
+        string(SUBSTRING "${guid}" 20 12 tail)
+        if ("${middle}" STREQUAL "000000000000" AND
+            "${tail}" STREQUAL "000000000000")
+            string(SUBSTRING "${guid}" 16 4 product)
+            set(guid "03000000${vendor}0000${product}000000000000")
+        endif()
+    endif()
+    set(${result} "${guid}" PARENT_SCOPE)
+endfunction()
+
+# Parses a mapping line and adds it to the tables of the platforms it is for,
+# replacing any earlier mapping with the same GUID
+macro(add_mapping line)
+    if ("${line}" MATCHES "^([0-9a-fA-F]+),([^,]*),(.*)$")
+        string(TOLOWER "${CMAKE_MATCH_1}" guid)
+        set(name "${CMAKE_MATCH_2}")
+        string(REPLACE "," ";" fields "${CMAKE_MATCH_3}")
+        string(LENGTH "${guid}" guid_length)
+        string(LENGTH "${name}" name_length)
+
+        set(valid TRUE)
+        if (NOT guid_length EQUAL 32 OR name_length GREATER 127)
+            set(valid FALSE)
+        endif()
+
+        foreach(field ${button_fields})
+            set(element_${field} "{0}")
+        endforeach()
+        foreach(field ${axis_fields})
+            set(element_${field}_0 "{0}")
+            set(element_${field}_1 "{0}")
+        endforeach()
+        set(platform "")
+
+        foreach(field ${fields})
+            if ("${field}" MATCHES "^platform:(.*)$")
+                set(platform "${CMAKE_MATCH_1}")
+            elseif ("${field}" MATCHES "^([+-]?)([a-z]+):(.*)$")
+                set(modifier "${CMAKE_MATCH_1}")
+                set(key "${CMAKE_MATCH_2}")
+                set(value "${CMAKE_MATCH_3}")
+
+                list(FIND button_fields "${key}" button_index)
+                list(FIND axis_fields "${key}" axis_index)
+
+                if (button_index GREATER -1)
+                    parse_element("${value}" 0 1 element_${key})
+                elseif (axis_index GREATER -1)
+                    # A full range replaces both halves of the gamepad axis
+                    if ("${modifier}" STREQUAL "+")
+                        parse_element("${value}" 0 1 element_${key}_0)
+                    elseif ("${modifier}" STREQUAL "-")
+                        parse_element("${value}" 0 -1 element_${key}_1)
+                    else()
+                        parse_element("${value}" -1 1 element_${key}_0)
+                        set(element_${key}_1 "{0}")
+                    endif()
+                endif()
+            endif()
+        endforeach()
+
+        if (valid)
+            string(REPLACE "\\" "\\\\" name "${name}")
+            string(REPLACE "\"" "\\\"" name "${name}")
+
+            set(buttons "")
+            foreach(field ${button_fields})
+                string(APPEND buttons "${element_${field}},")
+            endforeach()
+            set(axes "")
+            foreach(field ${axis_fields})
+                string(APPEND axes "{${element_${field}_0},${element_${field}_1}},")
+            endforeach()
+            string(REGEX REPLACE ",$" "" buttons "${buttons}")
+            string(REGEX REPLACE ",$" "" axes "${axes}")
+
+            foreach(index RANGE 3)
+                list(GET platform_names ${index} platform_name)
+                list(GET platform_ids ${index} platform_id)
+
+                if ("${platform}" STREQUAL "" OR
+                    "${platform}" STREQUAL "${platform_name}")
+                    update_guid(${platform_id} "${guid}" platform_guid)
+                    list(APPEND guids_${platform_id} "${platform_guid}")
+                    set(row_${platform_id}_${platform_guid}
+                        "{ \"${name}\", \"${platform_guid}\",\n  { ${buttons} },\n  { ${axes} } },\n")
+                endif()
+            endforeach()
+        endif()
+    endif()
+endmacro()
+
+file(STRINGS "${database_path}" lines)
 foreach(line ${lines})
     if ("${line}" MATCHES "^[0-9a-fA-F].*$")
-        set(GLFW_GAMEPAD_MAPPINGS "${GLFW_GAMEPAD_MAPPINGS}\"${line}\",\n")
+        add_mapping("${line}")
     endif()
 endforeach()
 
+# The GLFW specific mappings are listed in comments in the template
+file(STRINGS "${template_path}" lines REGEX "^// [0-9a-fA-F]+,.*$")
+foreach(line ${lines})
+    string(SUBSTRING "${line}" 3 -1 line)
+    add_mapping("${line}")
+endforeach()
+
+foreach(platform_id ${platform_ids})
+    set(table "")
+    if (guids_${platform_id})
+        list(REMOVE_DUPLICATES guids_${platform_id})
+        list(SORT guids_${platform_id})
+        foreach(guid ${guids_${platform_id}})
+            string(APPEND table "${row_${platform_id}_${guid}}")
+        endforeach()
+    endif()
+    string(TOUPPER "GLFW_${platform_id}_MAPPINGS" variable)
+    set(${variable} "${table}")
+endforeach()
+
 configure_file("${template_path}" "${target_path}" @ONLY NEWLINE_STYLE UNIX)
-file(REMOVE "${source_path}")
 
+if (NOT CMAKE_ARGV5)
+    file(REMOVE "${source_path}")
+endif()
@@ -1209,6 +1209,9 @@ int glfwShowSoftInput(int show);
 
 #define GLFW_CONNECTED              0x00040001
 #define GLFW_DISCONNECTED           0x00040002
+#define GLFW_JOYSTICK_AXIS_EVENT    0x00040003
+#define GLFW_JOYSTICK_BUTTON_EVENT  0x00040004
+#define GLFW_JOYSTICK_HAT_EVENT     0x00040005
 
 /*! @addtogroup init
  *  @{ */
@@ -1711,6 +1714,33 @@ typedef void (* GLFWcharfun)(GLFWwindow*,unsigned int);
  */
 typedef void (* GLFWcharmodsfun)(GLFWwindow*,unsigned int,int);
 
+/*! @brief The function pointer type for text input callbacks.
+ *
+ *  This is the function pointer type for text input callbacks.  It is called
+ *  once per platform text event with all the characters produced by that
+ *  event, such as a string committed by an input method.
+ *  A text input callback function has the following signature:
+ *  @code
+ *  void function_name(GLFWwindow* window, const char* text, int mods)
+ *  @endcode
+ *
+ *  @param[in] window The window that received the event.
+ *  @param[in] text The UTF-8 encoded, null-terminated text.  Control
+ *  characters are removed before the callback is called.
+ *  @param[in] mods Bit field describing which [modifier keys](@ref mods) were
+ *  held down.
+ *
+ *  @pointer_lifetime The text is valid until the callback function returns.
+ *
+ *  @sa @ref input_char
+ *  @sa @ref glfwSetTextCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWtextfun)(GLFWwindow*,const char*,int);
+
 /*! @brief The function pointer type for path drop callbacks.
  *
  *  This is the function pointer type for path drop callbacks.  A path drop
@@ -1777,6 +1807,70 @@ typedef void (* GLFWmonitorfun)(GLFWmonitor*,int);
  */
 typedef void (* GLFWjoystickfun)(int,int);
 
+/*! @brief The function pointer type for joystick axis callbacks.
+ *
+ *  This is the function pointer type for joystick axis callbacks.  A joystick
+ *  axis callback function has the following signature:
+ *  @code
+ *  void function_name(int jid, int axis, float value)
+ *  @endcode
+ *
+ *  @param[in] jid The joystick whose axis moved.
+ *  @param[in] axis The index of the axis, as used by @ref glfwGetJoystickAxes.
+ *  @param[in] value The new position of the axis, in the range -1.0 to 1.0.
+ *
+ *  @sa @ref joystick_axis
+ *  @sa @ref glfwSetJoystickAxisCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWjoystickaxisfun)(int,int,float);
+
+/*! @brief The function pointer type for joystick button callbacks.
+ *
+ *  This is the function pointer type for joystick button callbacks.
+ *  A joystick button callback function has the following signature:
+ *  @code
+ *  void function_name(int jid, int button, int action)
+ *  @endcode
+ *
+ *  @param[in] jid The joystick whose button changed state.
+ *  @param[in] button The index of the button, as used by @ref
+ *  glfwGetJoystickButtons.
+ *  @param[in] action One of `GLFW_PRESS` or `GLFW_RELEASE`.
+ *
+ *  @sa @ref joystick_button
+ *  @sa @ref glfwSetJoystickButtonCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWjoystickbuttonfun)(int,int,int);
+
+/*! @brief The function pointer type for joystick hat callbacks.
+ *
+ *  This is the function pointer type for joystick hat callbacks.  A joystick
+ *  hat callback function has the following signature:
+ *  @code
+ *  void function_name(int jid, int hat, int state)
+ *  @endcode
+ *
+ *  @param[in] jid The joystick whose hat changed state.
+ *  @param[in] hat The index of the hat, as used by @ref glfwGetJoystickHats.
+ *  @param[in] state The new [hat state](@ref hat_state).
+ *
+ *  @sa @ref joystick_hat
+ *  @sa @ref glfwSetJoystickHatCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWjoystickhatfun)(int,int,int);
+
 /*! @brief Video mode type.
  *
  *  This describes a single video mode.
@@ -1889,6 +1983,250 @@ typedef struct GLFWgamepadstate
     float axes[6];
 } GLFWgamepadstate;
 
+/*! @brief Latency statistics.
+ *
+ *  This describes the distribution of latency samples collected for a window.
+ *  All durations are in seconds and the percentiles are approximate, with
+ *  a relative error of a few percent.
+ *
+ *  @sa @ref glfwGetInputLatency
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+typedef struct GLFWlatencystats
+{
+    /*! The number of samples.
+     */
+    unsigned int count;
+    /*! The mean of the samples.
+     */
+    double mean;
+    /*! The median of the samples.
+     */
+    double p50;
+    /*! The 95th percentile of the samples.
+     */
+    double p95;
+    /*! The 99th percentile of the samples.
+     */
+    double p99;
+    /*! The largest sample.
+     */
+    double max;
+} GLFWlatencystats;
+
+/*! @brief Frame time statistics.
+ *
+ *  This describes the distribution of the intervals between consecutive frames
+ *  of a window.  All durations are in seconds and the percentiles are
+ *  approximate, with a relative error of a few percent.
+ *
+ *  @sa @ref glfwGetFrameTimeStats
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+typedef struct GLFWframestats
+{
+    /*! The number of intervals.
+     */
+    unsigned int count;
+    /*! The mean of the intervals.
+     */
+    double mean;
+    /*! The median of the intervals.
+     */
+    double p50;
+    /*! The 95th percentile of the intervals.
+     */
+    double p95;
+    /*! The 99th percentile of the intervals.
+     */
+    double p99;
+    /*! The longest interval.
+     */
+    double max;
+    /*! The number of intervals more than twice as long as the moving average
+     *  of the intervals before them.
+     */
+    unsigned int stutters;
+} GLFWframestats;
+
+/*! @brief Buffer swap timing.
+ *
+ *  This describes when a buffer swap of a window was requested and, where the
+ *  presentation engine reports it, when the frame reached the display.  All
+ *  times are in seconds, in the same time base as @ref glfwGetTime.
+ *
+ *  @sa @ref glfwGetFrameTimings
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+typedef struct GLFWframetiming
+{
+    /*! The sequence number of the swap, starting at one for the first call to
+     *  @ref glfwSwapBuffers for the window.
+     */
+    uint64_t frame;
+    /*! The time @ref glfwSwapBuffers was called.
+     */
+    double swapStart;
+    /*! The time @ref glfwSwapBuffers returned.
+     */
+    double swapEnd;
+    /*! The time the frame was presented, or the time the swap returned if the
+     *  presentation time is not known.
+     */
+    double present;
+    /*! The media stream counter, usually the number of vertical retraces, at
+     *  presentation, or zero if not known.
+     */
+    int64_t msc;
+    /*! The unadjusted system time of the presentation in microseconds, or zero
+     *  if not known.
+     */
+    int64_t ust;
+    /*! `GLFW_TRUE` if the presentation engine reported the presentation of
+     *  this frame, or `GLFW_FALSE` otherwise.
+     */
+    int presented;
+    /*! `GLFW_TRUE` if the presentation of this frame may still be reported, or
+     *  `GLFW_FALSE` otherwise.
+     */
+    int pending;
+} GLFWframetiming;
+
+/*! @brief The maximum number of joystick axes in a snapshot.
+ *
+ *  @ingroup input
+ */
+#define GLFW_SNAPSHOT_AXES          32
+/*! @brief The maximum number of joystick buttons in a snapshot.
+ *
+ *  @ingroup input
+ */
+#define GLFW_SNAPSHOT_BUTTONS       128
+/*! @brief The maximum number of joystick hats in a snapshot.
+ *
+ *  @ingroup input
+ */
+#define GLFW_SNAPSHOT_HATS          8
+
+/*! @brief Window input state snapshot.
+ *
+ *  This describes the keyboard and mouse state of a window as it was at the
+ *  end of the most recent call to @ref glfwPollEvents or one of the wait
+ *  functions.
+ *
+ *  @sa @ref glfwGetInputSnapshot
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef struct GLFWinputsnapshot
+{
+    /*! The number of snapshots published before this one.  It increases by one
+     *  each time the events are processed.
+     */
+    unsigned int serial;
+    /*! The [time](@ref glfwGetTime) at which the snapshot was published.
+     */
+    double time;
+    /*! The state of each [key](@ref keys), `GLFW_PRESS` or `GLFW_RELEASE`.
+     */
+    unsigned char keys[GLFW_KEY_LAST + 1];
+    /*! The state of each [mouse button](@ref buttons), `GLFW_PRESS` or
+     *  `GLFW_RELEASE`.
+     */
+    unsigned char mouseButtons[GLFW_MOUSE_BUTTON_LAST + 1];
+    /*! The cursor position, in screen coordinates, relative to the upper-left
+     *  corner of the content area.
+     */
+    double cursorX;
+    double cursorY;
+    /*! The [modifier keys](@ref mods) of the most recent input event.
+     */
+    int mods;
+} GLFWinputsnapshot;
+
+/*! @brief Joystick state snapshot.
+ *
+ *  This describes the state of a joystick as it was at the end of the most
+ *  recent call to @ref glfwPollEvents or one of the wait functions.  Joysticks
+ *  with more elements than the snapshot can hold report only the first ones.
+ *
+ *  @sa @ref glfwGetJoystickSnapshot
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef struct GLFWjoysticksnapshot
+{
+    /*! The number of snapshots published before this one.
+     */
+    unsigned int serial;
+    /*! The [time](@ref glfwGetTime) at which the snapshot was published.
+     */
+    double time;
+    /*! The number of valid elements in the axes array.
+     */
+    int axisCount;
+    /*! The number of valid elements in the buttons array.
+     */
+    int buttonCount;
+    /*! The number of valid elements in the hats array.
+     */
+    int hatCount;
+    /*! The state of each axis, in the range -1.0 to 1.0.
+     */
+    float axes[GLFW_SNAPSHOT_AXES];
+    /*! The state of each button, `GLFW_PRESS` or `GLFW_RELEASE`.
+     */
+    unsigned char buttons[GLFW_SNAPSHOT_BUTTONS];
+    /*! The state of each [hat](@ref hat_state).
+     */
+    unsigned char hats[GLFW_SNAPSHOT_HATS];
+} GLFWjoysticksnapshot;
+
+/*! @brief Timestamped joystick state change.
+ *
+ *  This describes a single change of a joystick axis, button or hat, as
+ *  stored in the joystick event buffer.
+ *
+ *  @sa @ref joystick_events
+ *  @sa @ref glfwGetJoystickEvents
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef struct GLFWjoystickevent
+{
+    /*! The time of the change, in the same time base as @ref glfwGetTime.
+     *  Where the platform provides device timestamps, this is when the device
+     *  reported the change rather than when GLFW processed it.
+     */
+    double time;
+    /*! One of `GLFW_JOYSTICK_AXIS_EVENT`, `GLFW_JOYSTICK_BUTTON_EVENT` or
+     *  `GLFW_JOYSTICK_HAT_EVENT`.
+     */
+    int type;
+    /*! The index of the axis, button or hat that changed.
+     */
+    int index;
+    /*! The new axis position, `GLFW_PRESS` or `GLFW_RELEASE` for buttons, or
+     *  the new [hat state](@ref hat_state).
+     */
+    float value;
+} GLFWjoystickevent;
+
 enum {
   GLFW_INPUT_UNDEFINED = 0,
   GLFW_INPUT_FIXED = 1,     // Fixed input device like a mouse.
@@ -2904,7 +3242,10 @@ GLFWAPI void glfwWindowHintString(int hint, const char* value);
  *  @remark @wayland Screensaver inhibition requires the idle-inhibit protocol
  *  to be implemented in the user's compositor.
  *
- *  @thread_safety This function must only be called from the main thread.
+ *  @thread_safety This function must only be called from the main thread,
+ *  except on the null platform, where it may be called from any thread to
+ *  create a windowed mode window.  The window hints are shared by all threads
+ *  and must not be changed while another thread is creating a window.
  *
  *  @sa @ref window_creation
  *  @sa @ref glfwDestroyWindow
@@ -2933,7 +3274,9 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height, const char* title, G
  *
  *  @reentrancy This function must not be called from a callback.
  *
- *  @thread_safety This function must only be called from the main thread.
+ *  @thread_safety This function must only be called from the main thread,
+ *  except on the null platform, where it may be called from any thread as
+ *  long as no events for the window are being processed.
  *
  *  @sa @ref window_creation
  *  @sa @ref glfwCreateWindow
@@ -2944,6 +3287,65 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height, const char* title, G
  */
 GLFWAPI void glfwDestroyWindow(GLFWwindow* window);
 
+/*! @brief Creates a context without a window.
+ *
+ *  This function creates an OpenGL or OpenGL ES context that has no window and
+ *  shares objects with the context of the specified window.  It is intended
+ *  for worker threads that upload resources or compile shaders for a window
+ *  without rendering anything themselves.
+ *
+ *  The new context uses the same client API, context creation API, version,
+ *  profile, robustness and release behavior as the context it shares with.
+ *  If `share` is `NULL`, these are instead taken from the current
+ *  [window hints](@ref window_hints), as are the framebuffer attributes used
+ *  to choose the pixel format of the context.
+ *
+ *  The context has no default framebuffer that can be presented.  With EGL it
+ *  is created without a surface where `EGL_KHR_surfaceless_context` is
+ *  available and with a single pixel pbuffer where it is not.  With GLX it is
+ *  created with a single pixel pbuffer and with OSMesa it renders into a
+ *  single pixel color buffer.  Render into framebuffer objects instead.
+ *
+ *  The returned handle may be used with @ref glfwMakeContextCurrent, @ref
+ *  glfwGetCurrentContext, @ref glfwDestroyWindow and the native context access
+ *  functions.  @ref glfwSwapBuffers and @ref glfwSwapInterval have no effect
+ *  for it.  Other window functions must not be called with it.
+ *
+ *  Like the context of any window, it may be made current on any thread, but
+ *  on only one thread at a time.
+ *
+ *  @param[in] share The window whose context to share resources with, or
+ *  `NULL` to not share resources.
+ *  @return The handle of the created context, or `NULL` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_API_UNAVAILABLE, @ref
+ *  GLFW_VERSION_UNAVAILABLE, @ref GLFW_FORMAT_UNAVAILABLE, @ref
+ *  GLFW_NO_WINDOW_CONTEXT and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @win32 WGL contexts can only be made current with the device
+ *  context of a window, so a context created with the native context creation
+ *  API is instead the context of a hidden window one pixel in size.  It has
+ *  a default framebuffer, the framebuffer hints apply to it and @ref
+ *  glfwSwapBuffers and @ref glfwSwapInterval act on it as for any window.
+ *  Contexts created with EGL or OSMesa are windowless as on other platforms.
+ *
+ *  @remark @macos A context created with the native context creation API is
+ *  never attached to a view.
+ *
+ *  @thread_safety This function must only be called from the main thread,
+ *  except on the null platform, where it may be called from any thread.
+ *
+ *  @sa @ref context_sharing
+ *  @sa @ref glfwDestroyWindow
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup context
+ */
+GLFWAPI GLFWwindow* glfwCreateSharedContext(GLFWwindow* share);
+
 /*! @brief Checks the close flag of the specified window.
  *
  *  This function returns the value of the close flag of the specified window.
@@ -4452,108 +4854,353 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout);
  */
 GLFWAPI void glfwPostEmptyEvent(void);
 
-/*! @brief Returns the value of an input option for the specified window.
+/*! @brief Enables or disables the input latency probe of a window.
  *
- *  This function returns the value of an input option for the specified window.
- *  The mode must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
- *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS or
- *  @ref GLFW_RAW_MOUSE_MOTION.
+ *  This function enables or disables measurement of the input-to-swap latency
+ *  of the specified window.  While enabled, the time at which each input event
+ *  reaches the window is noted, and the next call to @ref glfwSwapBuffers or
+ *  @ref glfwMarkFrameSubmitted for that window completes one sample: the time
+ *  from the oldest input event since the previous frame to the end of the
+ *  swap.  Samples are accumulated in a fixed-size histogram that can be
+ *  queried with @ref glfwGetInputLatency.
  *
- *  @param[in] window The window to query.
- *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
- *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS` or
- *  `GLFW_RAW_MOUSE_MOTION`.
+ *  Input events are timestamped when they are delivered to GLFW by the
+ *  platform, so time spent in the window system and kernel is not included.
  *
- *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
- *  GLFW_INVALID_ENUM.
+ *  Buffer swaps completing samples may be made on any thread.  The statistics
+ *  stay consistent while they are being queried on the main thread.
+ *
+ *  @param[in] window The window whose latency to measure.
+ *  @param[in] enabled `GLFW_TRUE` to enable the probe, or `GLFW_FALSE` to
+ *  disable it.  Collected samples are kept either way.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
  *
  *  @thread_safety This function must only be called from the main thread.
  *
- *  @sa @ref glfwSetInputMode
+ *  @sa @ref glfwGetInputLatency
+ *  @sa @ref glfwResetInputLatency
  *
- *  @since Added in version 3.0.
+ *  @since Added in version 3.4.
  *
- *  @ingroup input
+ *  @ingroup window
  */
-GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
+GLFWAPI void glfwSetInputLatencyProbe(GLFWwindow* window, int enabled);
 
-/*! @brief Sets an input option for the specified window.
+/*! @brief Notes that a frame of the specified window has been submitted.
  *
- *  This function sets an input mode option for the specified window.  The mode
- *  must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
- *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS or
- *  @ref GLFW_RAW_MOUSE_MOTION.
+ *  This function completes a latency sample and a frame time sample like @ref
+ *  glfwSwapBuffers does, for windows that present their frames without it,
+ *  for example by calling `vkQueuePresentKHR`.  Call it right after the frame
+ *  has been submitted.
  *
- *  If the mode is `GLFW_CURSOR`, the value must be one of the following cursor
- *  modes:
- *  - `GLFW_CURSOR_NORMAL` makes the cursor visible and behaving normally.
- *  - `GLFW_CURSOR_HIDDEN` makes the cursor invisible when it is over the
- *    content area of the window but does not restrict the cursor from leaving.
- *  - `GLFW_CURSOR_DISABLED` hides and grabs the cursor, providing virtual
- *    and unlimited cursor movement.  This is useful for implementing for
- *    example 3D camera controls.
+ *  @param[in] window The window whose frame was submitted.
  *
- *  If the mode is `GLFW_STICKY_KEYS`, the value must be either `GLFW_TRUE` to
- *  enable sticky keys, or `GLFW_FALSE` to disable it.  If sticky keys are
- *  enabled, a key press will ensure that @ref glfwGetKey returns `GLFW_PRESS`
- *  the next time it is called even if the key had been released before the
- *  call.  This is useful when you are only interested in whether keys have been
- *  pressed but not when or in which order.
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
  *
- *  If the mode is `GLFW_STICKY_MOUSE_BUTTONS`, the value must be either
- *  `GLFW_TRUE` to enable sticky mouse buttons, or `GLFW_FALSE` to disable it.
- *  If sticky mouse buttons are enabled, a mouse button press will ensure that
- *  @ref glfwGetMouseButton returns `GLFW_PRESS` the next time it is called even
- *  if the mouse button had been released before the call.  This is useful when
- *  you are only interested in whether mouse buttons have been pressed but not
- *  when or in which order.
+ *  @thread_safety This function may be called from any thread, but not
+ *  concurrently with @ref glfwSwapBuffers or itself for the same window.
  *
- *  If the mode is `GLFW_LOCK_KEY_MODS`, the value must be either `GLFW_TRUE` to
- *  enable lock key modifier bits, or `GLFW_FALSE` to disable them.  If enabled,
- *  callbacks that receive modifier bits will also have the @ref
- *  GLFW_MOD_CAPS_LOCK bit set when the event was generated with Caps Lock on,
- *  and the @ref GLFW_MOD_NUM_LOCK bit when Num Lock was on.
+ *  @sa @ref glfwSetInputLatencyProbe
+ *  @sa @ref glfwSetFrameTimeProbe
  *
- *  If the mode is `GLFW_RAW_MOUSE_MOTION`, the value must be either `GLFW_TRUE`
- *  to enable raw (unscaled and unaccelerated) mouse motion when the cursor is
- *  disabled, or `GLFW_FALSE` to disable it.  If raw motion is not supported,
- *  attempting to set this will emit @ref GLFW_PLATFORM_ERROR.  Call @ref
- *  glfwRawMouseMotionSupported to check for support.
+ *  @since Added in version 3.4.
  *
- *  @param[in] window The window whose input mode to set.
- *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
- *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS` or
- *  `GLFW_RAW_MOUSE_MOTION`.
- *  @param[in] value The new value of the specified input mode.
+ *  @ingroup window
+ */
+GLFWAPI void glfwMarkFrameSubmitted(GLFWwindow* window);
+
+/*! @brief Retrieves the input latency statistics of the specified window.
  *
- *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
- *  GLFW_INVALID_ENUM and @ref GLFW_PLATFORM_ERROR.
+ *  This function retrieves the distribution of the input-to-swap latency
+ *  samples collected by the [latency probe](@ref glfwSetInputLatencyProbe) of
+ *  the specified window.
+ *
+ *  @param[in] window The window to query.
+ *  @param[out] stats Where to store the statistics.
+ *  @return `GLFW_TRUE` if any samples have been collected, or `GLFW_FALSE`
+ *  otherwise or if an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
  *
  *  @thread_safety This function must only be called from the main thread.
  *
- *  @sa @ref glfwGetInputMode
+ *  @sa @ref glfwSetInputLatencyProbe
+ *  @sa @ref glfwResetInputLatency
  *
- *  @since Added in version 3.0.  Replaces `glfwEnable` and `glfwDisable`.
+ *  @since Added in version 3.4.
  *
- *  @ingroup input
+ *  @ingroup window
  */
-GLFWAPI void glfwSetInputMode(GLFWwindow* window, int mode, int value);
+GLFWAPI int glfwGetInputLatency(GLFWwindow* window, GLFWlatencystats* stats);
 
-/*! @brief Returns whether raw mouse motion is supported.
+/*! @brief Discards the input latency samples of the specified window.
  *
- *  This function returns whether raw mouse motion is supported on the current
- *  system.  This status does not change after GLFW has been initialized so you
- *  only need to check this once.  If you attempt to enable raw motion on
- *  a system that does not support it, @ref GLFW_PLATFORM_ERROR will be emitted.
+ *  @param[in] window The window whose samples to discard.
  *
- *  Raw mouse motion is closer to the actual motion of the mouse across
- *  a surface.  It is not affected by the scaling and acceleration applied to
- *  the motion of the desktop cursor.  That processing is suitable for a cursor
- *  while raw motion is better for controlling for example a 3D camera.  Because
- *  of this, raw mouse motion is only provided when the cursor is disabled.
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
  *
- *  @return `GLFW_TRUE` if raw mouse motion is supported on the current machine,
- *  or `GLFW_FALSE` otherwise.
+ *  @thread_safety This function must only be called from the main thread, and
+ *  not concurrently with @ref glfwSwapBuffers or @ref glfwMarkFrameSubmitted
+ *  for the same window on another thread.
+ *
+ *  @sa @ref glfwGetInputLatency
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwResetInputLatency(GLFWwindow* window);
+
+/*! @brief Enables or disables the frame time probe of a window.
+ *
+ *  This function enables or disables measurement of the intervals between
+ *  consecutive frames of the specified window.  While enabled, each call to
+ *  @ref glfwSwapBuffers or @ref glfwMarkFrameSubmitted for that window adds the
+ *  time since the previous one to a fixed-size histogram that can be queried
+ *  with @ref glfwGetFrameTimeStats.
+ *
+ *  Each sample takes constant time and no memory is allocated, so the probe
+ *  can be left enabled in release builds.
+ *
+ *  @param[in] window The window whose frame times to measure.
+ *  @param[in] enabled `GLFW_TRUE` to enable the probe, or `GLFW_FALSE` to
+ *  disable it.  Collected samples are kept either way.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref glfwGetFrameTimeStats
+ *  @sa @ref glfwResetFrameTimeStats
+ *  @sa @ref glfwSetFrameTimeTitle
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwSetFrameTimeProbe(GLFWwindow* window, int enabled);
+
+/*! @brief Retrieves the frame time statistics of the specified window.
+ *
+ *  This function retrieves the distribution of the frame intervals collected
+ *  by the [frame time probe](@ref glfwSetFrameTimeProbe) of the specified
+ *  window.
+ *
+ *  @param[in] window The window to query.
+ *  @param[out] stats Where to store the statistics.
+ *  @return `GLFW_TRUE` if any intervals have been collected, or `GLFW_FALSE`
+ *  otherwise or if an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread, but not
+ *  concurrently with @ref glfwSwapBuffers or @ref glfwMarkFrameSubmitted for
+ *  the same window.
+ *
+ *  @sa @ref glfwSetFrameTimeProbe
+ *  @sa @ref glfwResetFrameTimeStats
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwGetFrameTimeStats(GLFWwindow* window, GLFWframestats* stats);
+
+/*! @brief Discards the frame time samples of the specified window.
+ *
+ *  @param[in] window The window whose samples to discard.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread, but not
+ *  concurrently with @ref glfwSwapBuffers or @ref glfwMarkFrameSubmitted for
+ *  the same window.
+ *
+ *  @sa @ref glfwGetFrameTimeStats
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwResetFrameTimeStats(GLFWwindow* window);
+
+/*! @brief Shows frame time statistics in the title of the specified window.
+ *
+ *  This function sets the title of the specified window to the specified
+ *  string, followed by a summary of the [frame time](@ref glfwSetFrameTimeProbe)
+ *  statistics of the window once there are any.  The summary is refreshed
+ *  about twice a second while the probe is enabled, when events are
+ *  processed.
+ *
+ *  Titles longer than 255 bytes are truncated at the last complete code point
+ *  that fits.  An empty title shows only the summary.  Setting the title with
+ *  @ref glfwSetWindowTitle does not remove the hook.
+ *
+ *  @param[in] window The window whose title to set.
+ *  @param[in] title The UTF-8 encoded title to show before the summary, or
+ *  `NULL` to restore that title without the summary and remove the hook.  Only
+ *  `NULL` removes the hook.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @pointer_lifetime The specified string is copied before this function
+ *  returns.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref glfwSetFrameTimeProbe
+ *  @sa @ref glfwSetWindowTitle
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwSetFrameTimeTitle(GLFWwindow* window, const char* title);
+
+/*! @brief Retrieves the timings of the most recent buffer swaps of a window.
+ *
+ *  This function retrieves the timings of up to `count` of the most recent
+ *  calls to @ref glfwSwapBuffers for the specified window, oldest first.  The
+ *  times at which each swap was called and returned are always known.  Up to
+ *  32 swaps are kept per window.
+ *
+ *  Where the context creation API provides presentation feedback, the time,
+ *  media stream counter (MSC) and unadjusted system time (UST) of presentation
+ *  are also reported.  Feedback is gathered when this function is called and
+ *  only the latest presented frame is reported precisely, so call it once per
+ *  frame to get the presentation of every frame.  Frames whose presentation
+ *  is not known fall back to the time their swap returned.
+ *
+ *  @param[in] window The window to query.
+ *  @param[out] timings Where to store the timings.
+ *  @param[in] count The maximum number of timings to store.
+ *  @return The number of timings stored, or zero if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark @x11 Presentation feedback requires `GLX_OML_sync_control` and the
+ *  native context creation API.  The presentation time is only converted when
+ *  the GLFW timer uses the monotonic clock.
+ *
+ *  @remark Presentation feedback is not yet available with EGL, WGL, NSGL or
+ *  OSMesa, or on Wayland.
+ *
+ *  @thread_safety This function may be called from any thread, but not
+ *  concurrently with @ref glfwSwapBuffers for the same window.
+ *
+ *  @sa @ref buffer_swap
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwGetFrameTimings(GLFWwindow* window, GLFWframetiming* timings, int count);
+
+/*! @brief Returns the value of an input option for the specified window.
+ *
+ *  This function returns the value of an input option for the specified window.
+ *  The mode must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS or
+ *  @ref GLFW_RAW_MOUSE_MOTION.
+ *
+ *  @param[in] window The window to query.
+ *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
+ *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS` or
+ *  `GLFW_RAW_MOUSE_MOTION`.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_ENUM.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref glfwSetInputMode
+ *
+ *  @since Added in version 3.0.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
+
+/*! @brief Sets an input option for the specified window.
+ *
+ *  This function sets an input mode option for the specified window.  The mode
+ *  must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS or
+ *  @ref GLFW_RAW_MOUSE_MOTION.
+ *
+ *  If the mode is `GLFW_CURSOR`, the value must be one of the following cursor
+ *  modes:
+ *  - `GLFW_CURSOR_NORMAL` makes the cursor visible and behaving normally.
+ *  - `GLFW_CURSOR_HIDDEN` makes the cursor invisible when it is over the
+ *    content area of the window but does not restrict the cursor from leaving.
+ *  - `GLFW_CURSOR_DISABLED` hides and grabs the cursor, providing virtual
+ *    and unlimited cursor movement.  This is useful for implementing for
+ *    example 3D camera controls.
+ *
+ *  If the mode is `GLFW_STICKY_KEYS`, the value must be either `GLFW_TRUE` to
+ *  enable sticky keys, or `GLFW_FALSE` to disable it.  If sticky keys are
+ *  enabled, a key press will ensure that @ref glfwGetKey returns `GLFW_PRESS`
+ *  the next time it is called even if the key had been released before the
+ *  call.  This is useful when you are only interested in whether keys have been
+ *  pressed but not when or in which order.
+ *
+ *  If the mode is `GLFW_STICKY_MOUSE_BUTTONS`, the value must be either
+ *  `GLFW_TRUE` to enable sticky mouse buttons, or `GLFW_FALSE` to disable it.
+ *  If sticky mouse buttons are enabled, a mouse button press will ensure that
+ *  @ref glfwGetMouseButton returns `GLFW_PRESS` the next time it is called even
+ *  if the mouse button had been released before the call.  This is useful when
+ *  you are only interested in whether mouse buttons have been pressed but not
+ *  when or in which order.
+ *
+ *  If the mode is `GLFW_LOCK_KEY_MODS`, the value must be either `GLFW_TRUE` to
+ *  enable lock key modifier bits, or `GLFW_FALSE` to disable them.  If enabled,
+ *  callbacks that receive modifier bits will also have the @ref
+ *  GLFW_MOD_CAPS_LOCK bit set when the event was generated with Caps Lock on,
+ *  and the @ref GLFW_MOD_NUM_LOCK bit when Num Lock was on.
+ *
+ *  If the mode is `GLFW_RAW_MOUSE_MOTION`, the value must be either `GLFW_TRUE`
+ *  to enable raw (unscaled and unaccelerated) mouse motion when the cursor is
+ *  disabled, or `GLFW_FALSE` to disable it.  If raw motion is not supported,
+ *  attempting to set this will emit @ref GLFW_PLATFORM_ERROR.  Call @ref
+ *  glfwRawMouseMotionSupported to check for support.
+ *
+ *  @param[in] window The window whose input mode to set.
+ *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
+ *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS` or
+ *  `GLFW_RAW_MOUSE_MOTION`.
+ *  @param[in] value The new value of the specified input mode.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref glfwGetInputMode
+ *
+ *  @since Added in version 3.0.  Replaces `glfwEnable` and `glfwDisable`.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwSetInputMode(GLFWwindow* window, int mode, int value);
+
+/*! @brief Returns whether raw mouse motion is supported.
+ *
+ *  This function returns whether raw mouse motion is supported on the current
+ *  system.  This status does not change after GLFW has been initialized so you
+ *  only need to check this once.  If you attempt to enable raw motion on
+ *  a system that does not support it, @ref GLFW_PLATFORM_ERROR will be emitted.
+ *
+ *  Raw mouse motion is closer to the actual motion of the mouse across
+ *  a surface.  It is not affected by the scaling and acceleration applied to
+ *  the motion of the desktop cursor.  That processing is suitable for a cursor
+ *  while raw motion is better for controlling for example a 3D camera.  Because
+ *  of this, raw mouse motion is only provided when the cursor is disabled.
+ *
+ *  @return `GLFW_TRUE` if raw mouse motion is supported on the current machine,
+ *  or `GLFW_FALSE` otherwise.
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
  *
@@ -5082,6 +5729,47 @@ GLFWAPI GLFWcharfun glfwSetCharCallback(GLFWwindow* window, GLFWcharfun callback
  */
 GLFWAPI GLFWcharmodsfun glfwSetCharModsCallback(GLFWwindow* window, GLFWcharmodsfun callback);
 
+/*! @brief Sets the text input callback.
+ *
+ *  This function sets the text input callback of the specified window, which
+ *  is called once for each batch of text delivered by the platform, for
+ *  example a string committed by an input method.
+ *
+ *  The [character](@ref glfwSetCharCallback) and
+ *  [character with modifiers](@ref glfwSetCharModsCallback) callbacks are
+ *  still called for each code point of the text, before the text input
+ *  callback is called.  Applications that consume whole strings should use
+ *  this callback to avoid the per-character overhead.
+ *
+ *  Text is never batched across key events.  A key that is repeated several
+ *  times in a single platform event is reported as alternating
+ *  [key](@ref glfwSetKeyCallback) and text events, one pair per repeat.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(GLFWwindow* window, const char* text, int mods)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWtextfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_char
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWtextfun glfwSetTextCallback(GLFWwindow* window, GLFWtextfun callback);
+
 /*! @brief Sets the multitouch event callback.
  *
  *  This function sets the multitouch event callback of the specified window,
@@ -5429,6 +6117,67 @@ GLFWAPI const unsigned char* glfwGetJoystickButtons(int jid, int* count);
  */
 GLFWAPI const unsigned char* glfwGetJoystickHats(int jid, int* count);
 
+/*! @brief Sets the size of the event buffer of the specified joystick.
+ *
+ *  This function enables, resizes or disables the event buffer of the
+ *  specified joystick slot.  While enabled, every change of an axis, button
+ *  or hat is stored with its timestamp, so that changes between calls to
+ *  @ref glfwGetJoystickEvents are not lost.  When the buffer is full the
+ *  oldest change is discarded.
+ *
+ *  The buffer belongs to the joystick slot and is emptied when a joystick is
+ *  connected to it.  Resizing the buffer discards any stored changes.
+ *
+ *  @param[in] jid The [joystick](@ref joysticks) whose buffer to set.
+ *  @param[in] size The maximum number of changes to store, or zero to disable
+ *  the buffer.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE and @ref GLFW_OUT_OF_MEMORY.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_events
+ *  @sa @ref glfwGetJoystickEvents
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwSetJoystickEventBufferSize(int jid, int size);
+
+/*! @brief Retrieves the buffered changes of the specified joystick.
+ *
+ *  This function moves up to `max` of the oldest buffered changes of the
+ *  specified joystick into the provided array, in the order they occurred.
+ *  Changes that do not fit remain buffered for the next call.
+ *
+ *  The event buffer must first be enabled with @ref
+ *  glfwSetJoystickEventBufferSize.
+ *
+ *  On Linux and Android the timestamps come from the input device events.
+ *  On other platforms they are taken when GLFW processes the change.
+ *
+ *  @param[in] jid The [joystick](@ref joysticks) to query.
+ *  @param[out] events The array to store the changes in.
+ *  @param[in] max The size of the `events` array.
+ *  @return The number of changes stored, or zero if there were none, the
+ *  joystick is not present or an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_events
+ *  @sa @ref glfwSetJoystickEventBufferSize
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetJoystickEvents(int jid, GLFWjoystickevent* events, int max);
+
 /*! @brief Returns the name of the specified joystick.
  *
  *  This function returns the name, encoded as UTF-8, of the specified joystick.
@@ -5591,6 +6340,10 @@ GLFWAPI int glfwJoystickIsGamepad(int jid);
  *  called by joystick functions.  The function will then return whatever it
  *  returns if the joystick is not present.
  *
+ *  @remark @linux Devices are probed on a background thread, so joysticks
+ *  already present at initialization are connected by the first event
+ *  processing calls after @ref glfwInit.
+ *
  *  @param[in] callback The new callback, or `NULL` to remove the currently set
  *  callback.
  *  @return The previously set callback, or `NULL` if no callback was set or the
@@ -5615,6 +6368,108 @@ GLFWAPI int glfwJoystickIsGamepad(int jid);
  */
 GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun callback);
 
+/*! @brief Sets the joystick axis callback.
+ *
+ *  This function sets the joystick axis callback, or removes the currently
+ *  set callback.  This is called when a joystick axis changes position.
+ *
+ *  On Linux the device file descriptors are watched by the event loop, so
+ *  @ref glfwWaitEvents returns as soon as a joystick reports new input.  On
+ *  other platforms the callback is called when the joystick is polled, either
+ *  by joystick functions or by [event processing](@ref events).
+ *
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(int jid, int axis, float value)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWjoystickaxisfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_axis
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWjoystickaxisfun glfwSetJoystickAxisCallback(GLFWjoystickaxisfun callback);
+
+/*! @brief Sets the joystick button callback.
+ *
+ *  This function sets the joystick button callback, or removes the currently
+ *  set callback.  This is called when a joystick button is pressed or released.
+ *
+ *  On Linux the device file descriptors are watched by the event loop, so
+ *  @ref glfwWaitEvents returns as soon as a joystick reports new input.  On
+ *  other platforms the callback is called when the joystick is polled, either
+ *  by joystick functions or by [event processing](@ref events).
+ *
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(int jid, int button, int action)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWjoystickbuttonfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_button
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWjoystickbuttonfun glfwSetJoystickButtonCallback(GLFWjoystickbuttonfun callback);
+
+/*! @brief Sets the joystick hat callback.
+ *
+ *  This function sets the joystick hat callback, or removes the currently
+ *  set callback.  This is called when a joystick hat changes state.
+ *
+ *  On Linux the device file descriptors are watched by the event loop, so
+ *  @ref glfwWaitEvents returns as soon as a joystick reports new input.  On
+ *  other platforms the callback is called when the joystick is polled, either
+ *  by joystick functions or by [event processing](@ref events).
+ *
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(int jid, int hat, int state)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWjoystickhatfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_hat
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWjoystickhatfun glfwSetJoystickHatCallback(GLFWjoystickhatfun callback);
+
 /*! @brief Adds the specified SDL_GameControllerDB gamepad mappings.
  *
  *  This function parses the specified ASCII encoded string and updates the
@@ -5717,6 +6572,215 @@ GLFWAPI const char* glfwGetGamepadName(int jid);
  */
 GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state);
 
+/*! @brief Retrieves the state of all joysticks remapped as gamepads.
+ *
+ *  This function retrieves the state of every connected joystick that has
+ *  a gamepad mapping, remapped to an Xbox-like gamepad.  This is equivalent to
+ *  calling @ref glfwGetGamepadState for each joystick ID but is cheaper when
+ *  many gamepads are in use.
+ *
+ *  The states are stored at the index of their joystick ID, so the array must
+ *  have room for `GLFW_JOYSTICK_LAST + 1` elements.  The states of joysticks
+ *  that are not present or do not have a gamepad mapping are zeroed.  Call
+ *  @ref glfwJoystickIsGamepad to tell them apart from gamepads at rest.
+ *
+ *  @param[out] states Where to store the gamepad input states, indexed by
+ *  [joystick ID](@ref joysticks).
+ *  @param[out] count Where to store one more than the highest joystick ID
+ *  whose gamepad state was retrieved, or zero if there are no gamepads.
+ *  @return `GLFW_TRUE` if the state of at least one gamepad was retrieved, or
+ *  `GLFW_FALSE` if there are no gamepads or an [error](@ref error_handling)
+ *  occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref gamepad
+ *  @sa @ref glfwGetGamepadState
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetAllGamepadStates(GLFWgamepadstate* states, int* count);
+
+/*! @brief Retrieves the most recently published input state of a window.
+ *
+ *  This function copies the keyboard and mouse state of the specified window
+ *  as it was published at the end of the most recent call to @ref
+ *  glfwPollEvents, @ref glfwWaitEvents or @ref glfwWaitEventsTimeout.
+ *
+ *  Unlike @ref glfwGetKey and related functions, this function does not take
+ *  any locks and may be called from any thread, for example by a simulation or
+ *  render thread sampling input while the main thread processes events.  The
+ *  snapshot is always internally consistent.  Sticky keys and buttons are not
+ *  reported by snapshots.
+ *
+ *  @param[in] window The window to query.
+ *  @param[out] snapshot Where to store the input state.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if no events have been
+ *  processed since the window was created or an [error](@ref error_handling)
+ *  occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread, but the window
+ *  must not be destroyed concurrently.
+ *
+ *  @sa @ref glfwGetJoystickSnapshot
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetInputSnapshot(GLFWwindow* window, GLFWinputsnapshot* snapshot);
+
+/*! @brief Retrieves the most recently published state of a joystick.
+ *
+ *  This function copies the state of the specified joystick as it was
+ *  published at the end of the most recent call to @ref glfwPollEvents, @ref
+ *  glfwWaitEvents or @ref glfwWaitEventsTimeout.
+ *
+ *  Joystick snapshots are published only once this function has been called,
+ *  so the first call for a joystick may report it as not present.
+ *
+ *  @param[in] jid The [joystick](@ref joysticks) to query.
+ *  @param[out] snapshot Where to store the joystick state.
+ *  @return `GLFW_TRUE` if the joystick was present in the snapshot, or
+ *  `GLFW_FALSE` otherwise or if an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_ENUM.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref glfwGetInputSnapshot
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetJoystickSnapshot(int jid, GLFWjoysticksnapshot* snapshot);
+
+/*! @brief Starts recording input events to a file.
+ *
+ *  This function starts recording the input events of all windows and
+ *  joysticks to a compact binary log at the specified path.  Each event is
+ *  stored with a timestamp in [timer ticks](@ref glfwGetTimerFrequency) since
+ *  the recording started, along with the boundaries of each call to @ref
+ *  glfwPollEvents or the wait functions, so that @ref glfwStartInputReplay can
+ *  reproduce the exact same event stream frame by frame.
+ *
+ *  Key, character, mouse button, cursor, scroll, multitouch, window size,
+ *  framebuffer size, focus and close events are recorded, as are joystick
+ *  connections and axis, button and hat changes.  Windows are identified by
+ *  the order in which they were created.
+ *
+ *  The log is stored as little-endian fixed-width fields, so a log recorded on
+ *  one machine can be replayed on another with a different architecture.
+ *
+ *  The recording ends when @ref glfwStopInputLog is called or the library is
+ *  terminated.
+ *
+ *  @param[in] path The UTF-8 encoded path of the log file to create.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref glfwStartInputReplay
+ *  @sa @ref glfwStopInputLog
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwStartInputRecording(const char* path);
+
+/*! @brief Starts replaying input events from a file.
+ *
+ *  This function loads a log written by @ref glfwStartInputRecording and feeds
+ *  its events back through the same paths as live input, starting with the
+ *  next call to @ref glfwPollEvents or one of the wait functions.  Each such
+ *  call dispatches the events recorded during the corresponding call of the
+ *  recording session, regardless of how much time has passed, which makes the
+ *  replay deterministic.  The recorded timestamps are not waited for, so the
+ *  replay runs as fast as the application polls for events.  The wait
+ *  functions do not block while replaying.
+ *
+ *  Live input is ignored for the duration of the replay.  Events for windows
+ *  that do not exist are skipped, so the application should create its windows
+ *  in the same order as when recording.
+ *
+ *  @remark Recorded joysticks are only recreated on the null platform.  On the
+ *  other platforms joystick objects are owned by the platform code, so
+ *  recorded joystick connections are ignored and recorded axis, button and hat
+ *  changes are only replayed for joysticks that are connected to the same slot
+ *  with enough axes, buttons and hats.
+ *
+ *  The replay ends when the log has been exhausted, @ref glfwStopInputLog is
+ *  called or the library is terminated.
+ *
+ *  @param[in] path The UTF-8 encoded path of the log file to replay.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref glfwStartInputRecording
+ *  @sa @ref glfwInputReplayActive
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwStartInputReplay(const char* path);
+
+/*! @brief Stops recording or replaying input events.
+ *
+ *  This function finishes the current input recording, or ends the current
+ *  replay and resumes processing of live input.  If neither is active, this
+ *  function does nothing.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref glfwStartInputRecording
+ *  @sa @ref glfwStartInputReplay
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwStopInputLog(void);
+
+/*! @brief Returns whether an input log is being replayed.
+ *
+ *  This function returns whether a replay started with @ref
+ *  glfwStartInputReplay still has events left to dispatch.
+ *
+ *  @return `GLFW_TRUE` if a replay is in progress, or `GLFW_FALSE` otherwise.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref glfwStartInputReplay
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwInputReplayActive(void);
+
 /*! @brief Sets the clipboard to the specified string.
  *
  *  This function sets the system clipboard to the specified, UTF-8 encoded
@@ -6023,10 +7087,11 @@ GLFWAPI void glfwSwapInterval(int interval);
  *  A context must be current on the calling thread.  Calling this function
  *  without a current context will cause a @ref GLFW_NO_CURRENT_CONTEXT error.
  *
- *  As this functions retrieves and searches one or more extension strings each
- *  call, it is recommended that you cache its results if it is going to be used
- *  frequently.  The extension strings will not change during the lifetime of
- *  a context, so there is no danger in doing this.
+ *  The extension strings are retrieved once when the context is created and
+ *  kept in a hash set, so this function does not call the driver and is cheap
+ *  enough to be called frequently.  If the set could not be built, because the
+ *  driver returned no extension string or there was not enough memory, the
+ *  extension strings are searched on each call instead.
  *
  *  This function does not apply to Vulkan.  If you are using Vulkan, see @ref
  *  glfwGetRequiredInstanceExtensions, `vkEnumerateInstanceExtensionProperties`
@@ -6086,6 +7151,7 @@ GLFWAPI int glfwExtensionSupported(const char* extension);
  *
  *  @sa @ref context_glext
  *  @sa @ref glfwExtensionSupported
+ *  @sa @ref glfwGetProcAddresses
  *
  *  @since Added in version 1.0.
  *
@@ -6093,6 +7159,51 @@ GLFWAPI int glfwExtensionSupported(const char* extension);
  */
 GLFWAPI GLFWglproc glfwGetProcAddress(const char* procname);
 
+/*! @brief Retrieves the addresses of the specified functions for the current
+ *  context.
+ *
+ *  This function retrieves the addresses of a table of OpenGL or OpenGL ES
+ *  [core or extension functions](@ref context_glext) in one call, as if @ref
+ *  glfwGetProcAddress was called for each of them.  This is intended for
+ *  loaders that resolve every function they know of when a context is created.
+ *
+ *  Entry points are cached per client API library, so resolving the same
+ *  functions for further contexts and windows does not have to look them up
+ *  again.  On WGL, where addresses may differ between contexts, every function
+ *  is looked up each time.
+ *
+ *  A context must be current on the calling thread.  Calling this function
+ *  without a current context will cause a @ref GLFW_NO_CURRENT_CONTEXT error.
+ *
+ *  @param[in] names The ASCII encoded names of the functions.
+ *  @param[out] procs Where to store the addresses of the functions.  Functions
+ *  that were not found and all functions when an [error](@ref error_handling)
+ *  occurred are set to `NULL`.
+ *  @param[in] count The number of elements in the `names` and `procs` arrays.
+ *  @return The number of functions that were found, or zero if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_CURRENT_CONTEXT, @ref GLFW_INVALID_VALUE and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @remark As with @ref glfwGetProcAddress, a non-`NULL` address does not mean
+ *  that the associated version or extension is available.
+ *
+ *  @pointer_lifetime The retrieved function pointers are valid until the
+ *  context is destroyed or the library is terminated.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref context_glext
+ *  @sa @ref glfwGetProcAddress
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup context
+ */
+GLFWAPI int glfwGetProcAddresses(const char** names, GLFWglproc* procs, int count);
+
 /*! @brief Returns whether the Vulkan loader and an ICD have been found.
  *
  *  This function returns whether the Vulkan loader and any minimally functional
@@ -62,6 +62,7 @@ extern "C" {
  *  * `GLFW_EXPOSE_NATIVE_COCOA`
  *  * `GLFW_EXPOSE_NATIVE_X11`
  *  * `GLFW_EXPOSE_NATIVE_WAYLAND`
+ *  * `GLFW_EXPOSE_NATIVE_NULL`
  *
  *  The available context API macros are:
  *  * `GLFW_EXPOSE_NATIVE_WGL`
@@ -74,6 +75,10 @@ extern "C" {
  *  and which platform-specific headers to include.  It is then up your (by
  *  definition platform-specific) code to handle which of these should be
  *  defined.
+ *
+ *  If you do not want the platform-specific headers to be included, define
+ *  `GLFW_NATIVE_INCLUDE_NONE` before including the @ref glfw3native.h header.
+ *  The types they would have declared must then be declared by your code.
  */
 
 
@@ -81,6 +86,8 @@ extern "C" {
  * System headers and types
  *************************************************************************/
 
+#if !defined(GLFW_NATIVE_INCLUDE_NONE)
+
 #if defined(GLFW_EXPOSE_NATIVE_WIN32) || defined(GLFW_EXPOSE_NATIVE_WGL)
  // This is a workaround for the fact that glfw3.h needs to export APIENTRY (for
  // example to allow applications to correctly declare a GL_ARB_debug_output
@@ -120,6 +127,8 @@ extern "C" {
  #include <GL/osmesa.h>
 #endif
 
+#endif /*GLFW_NATIVE_INCLUDE_NONE*/
+
 
 /*************************************************************************
  * Functions
@@ -457,9 +466,163 @@ GLFWAPI EGLContext glfwGetEGLContext(GLFWwindow* window);
  *  @ingroup native
  */
 GLFWAPI EGLSurface glfwGetEGLSurface(GLFWwindow* window);
+
+/*! @brief Returns the framebuffer objects of the specified headless window.
+ *
+ *  This function returns the names of the framebuffer objects that stand in
+ *  for the default framebuffer of an EGL context on the null platform.  These
+ *  contexts have no window surface, so rendering goes to the back framebuffer
+ *  object, which is bound when the context is first made current.  Binding
+ *  framebuffer zero does not redirect to it.
+ *
+ *  The names are exchanged by @ref glfwSwapBuffers, so they should be queried
+ *  again after each swap.  A single buffered context has no front buffer.
+ *
+ *  @param[in] window The window whose framebuffer objects to query.
+ *  @param[out] back Where to store the name of the back framebuffer object, or
+ *  `NULL`.
+ *  @param[out] front Where to store the name of the front framebuffer object,
+ *  or `NULL`.
+ *
+ *  @remark If the context has no framebuffer objects, zero is returned for
+ *  both names.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_NO_WINDOW_CONTEXT.
+ *
+ *  @thread_safety This function may be called from any thread.  Access is not
+ *  synchronized.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwGetEGLFramebuffers(GLFWwindow* window, unsigned int* back, unsigned int* front);
+#endif
+
+#if defined(GLFW_EXPOSE_NATIVE_NULL)
+/*! @brief Injects a key event into the specified window.
+ *
+ *  This function queues a physical key event for the specified window.  The
+ *  event is delivered as if it came from a keyboard by the next call to @ref
+ *  glfwPollEvents or one of the wait functions, in the order it was injected.
+ *  A character is not generated, see @ref glfwNullInjectChar.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] key The [keyboard key](@ref keys) or `GLFW_KEY_UNKNOWN`.
+ *  @param[in] scancode The platform-specific scancode to report.
+ *  @param[in] action `GLFW_PRESS`, `GLFW_RELEASE` or `GLFW_REPEAT`.
+ *  @param[in] mods Bit field describing which [modifier keys](@ref mods) are
+ *  held down.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM and @ref GLFW_OUT_OF_MEMORY.
+ *
+ *  @thread_safety This function may be called from any thread, but the window
+ *  must not be destroyed concurrently.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectKey(GLFWwindow* window, int key, int scancode, int action, int mods);
+
+/*! @brief Injects a Unicode character into the specified window.
+ *
+ *  This function queues a character input event for the specified window,
+ *  which is delivered to the character callbacks by the next call to @ref
+ *  glfwPollEvents or one of the wait functions.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] codepoint The Unicode code point of the character.
+ *  @param[in] mods Bit field describing which [modifier keys](@ref mods) are
+ *  held down.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_OUT_OF_MEMORY.
+ *
+ *  @thread_safety This function may be called from any thread, but the window
+ *  must not be destroyed concurrently.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectChar(GLFWwindow* window, unsigned int codepoint, int mods);
+
+/*! @brief Injects multitouch events into the specified window.
+ *
+ *  This function queues a batch of multitouch events for the specified window,
+ *  which is delivered to the multitouch event callback by the next call to
+ *  @ref glfwPollEvents or one of the wait functions.
+ *
+ *  @param[in] window The window to receive the events.
+ *  @param[in] events The events to deliver.  They are copied before this
+ *  function returns.
+ *  @param[in] count The number of elements in the events array.
+ *  @param[in] mods Bit field describing which [modifier keys](@ref mods) are
+ *  held down.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_OUT_OF_MEMORY.
+ *
+ *  @thread_safety This function may be called from any thread, but the window
+ *  must not be destroyed concurrently.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectMultitouch(GLFWwindow* window, const GLFWinputEvent* events, int count, int mods);
+
+/*! @brief Injects a resize of the specified window.
+ *
+ *  This function queues a resize of the specified window.  When it is
+ *  dispatched by the next call to @ref glfwPollEvents or one of the wait
+ *  functions, the size of the window and its framebuffer is updated and the
+ *  framebuffer size and window size callbacks are called.
+ *
+ *  @param[in] window The window to resize.
+ *  @param[in] width The new width, in screen coordinates, of the window.
+ *  @param[in] height The new height, in screen coordinates, of the window.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_OUT_OF_MEMORY.
+ *
+ *  @thread_safety This function may be called from any thread, but the window
+ *  must not be destroyed concurrently.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectWindowSize(GLFWwindow* window, int width, int height);
 #endif
 
 #if defined(GLFW_EXPOSE_NATIVE_OSMESA)
+/*! @brief The function pointer type for OSMesa frame callbacks.
+ *
+ *  This is the function pointer type for OSMesa frame callbacks.  An OSMesa
+ *  frame callback function has the following signature:
+ *  @code
+ *  void function_name(GLFWwindow* window, const void* buffer, int width, int height, int pitch)
+ *  @endcode
+ *
+ *  @param[in] window The window whose buffers were swapped.
+ *  @param[in] buffer The color buffer holding the completed frame, in the
+ *  `OSMESA_RGBA` format.
+ *  @param[in] width The width, in pixels, of the color buffer.
+ *  @param[in] height The height, in pixels, of the color buffer.
+ *  @param[in] pitch The number of bytes between the starts of adjacent rows.
+ *
+ *  @sa @ref glfwSetOSMesaFrameCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+typedef void (* GLFWosmesaframefun)(GLFWwindow*,const void*,int,int,int);
+
 /*! @brief Retrieves the color buffer associated with the specified window.
  *
  *  @param[in] window The window whose color buffer to retrieve.
@@ -481,6 +644,117 @@ GLFWAPI EGLSurface glfwGetEGLSurface(GLFWwindow* window);
  */
 GLFWAPI int glfwGetOSMesaColorBuffer(GLFWwindow* window, int* width, int* height, int* format, void** buffer);
 
+/*! @brief Sets the color buffer the specified window renders into.
+ *
+ *  This function makes the OSMesa context of the specified window render
+ *  directly into a buffer owned by the application, for example shared memory
+ *  read by another process, instead of a buffer allocated by GLFW.  The buffer
+ *  keeps its size when the window is resized.
+ *
+ *  If the context is current on the calling thread, it is rebound immediately.
+ *  Otherwise the buffer is used the next time the context is made current.
+ *
+ *  @param[in] window The window whose color buffer to set.
+ *  @param[in] buffer The color buffer, or `NULL` to return to the buffer
+ *  allocated by GLFW.
+ *  @param[in] width The width, in pixels, of the color buffer.
+ *  @param[in] height The height, in pixels, of the color buffer.
+ *  @param[in] pitch The number of bytes between the starts of adjacent rows,
+ *  which must be a multiple of four, or zero if the rows are tightly packed.
+ *  @param[in] format The OSMesa pixel format of the color buffer.  This must
+ *  currently be `OSMESA_RGBA`, the format of contexts created by GLFW.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT, @ref GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE and
+ *  @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @pointer_lifetime The buffer must remain valid until it is replaced or the
+ *  window is destroyed.
+ *
+ *  @thread_safety This function may be called from any thread, as long as the
+ *  context of the window is not current on another thread.
+ *
+ *  @sa @ref glfwGetOSMesaColorBuffer
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwSetOSMesaColorBuffer(GLFWwindow* window, void* buffer, int width, int height, int pitch, int format);
+
+/*! @brief Sets the number of color buffers of the specified window.
+ *
+ *  This function sets the number of color buffers GLFW allocates for the
+ *  OSMesa context of the specified window.  With more than one buffer, @ref
+ *  glfwSwapBuffers finishes rendering and moves rendering to the next buffer
+ *  in the ring.  The completed buffer is passed to the
+ *  [frame callback](@ref glfwSetOSMesaFrameCallback), which may hand it to
+ *  another thread.
+ *
+ *  A completed buffer is left untouched until `count - 1` further swaps have
+ *  been made, after which it is rendered into again.  If the framebuffer has
+ *  grown, a buffer is reallocated only when the ring comes back to it, so
+ *  completed buffers stay valid for the same number of swaps.  Buffers left
+ *  outside the ring by lowering the count are kept until the window is
+ *  destroyed.  The default is a single buffer, which is rendered into by every
+ *  frame.
+ *
+ *  This has no effect while an [application buffer](@ref
+ *  glfwSetOSMesaColorBuffer) is set.
+ *
+ *  @param[in] window The window whose buffer count to set.
+ *  @param[in] count The number of buffers, from one to four.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT and @ref GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function may be called from any thread, as long as the
+ *  context of the window is not current on another thread.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwSetOSMesaBufferCount(GLFWwindow* window, int count);
+
+/*! @brief Sets the frame callback for the specified window.
+ *
+ *  This function sets the frame callback of the specified window, which is
+ *  called by @ref glfwSwapBuffers with the color buffer holding the completed
+ *  frame.  The frame is finished before the callback is called if the context
+ *  is current on the calling thread.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(GLFWwindow* window, const void* buffer, int width, int height, int pitch)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWosmesaframefun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_NO_WINDOW_CONTEXT.
+ *
+ *  @thread_safety This function may be called from any thread, as long as the
+ *  context of the window is not current on another thread.
+ *
+ *  @sa @ref glfwSetOSMesaBufferCount
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI GLFWosmesaframefun glfwSetOSMesaFrameCallback(GLFWwindow* window, GLFWosmesaframefun callback);
+
 /*! @brief Retrieves the depth buffer associated with the specified window.
  *
  *  @param[in] window The window whose depth buffer to retrieve.
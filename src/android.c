@@ -94,6 +94,18 @@ int _glfwPlatformCreateWindow(_GLFWwindow* w, const _GLFWwndconfig* g,
     return GLFW_FALSE;
 }
 
+int _glfwPlatformCreateContext(_GLFWwindow* w, const _GLFWctxconfig* c,
+                               const _GLFWfbconfig* f)
+{
+    _glfwInputError(GLFW_API_UNAVAILABLE,
+                    "Android: windowless contexts are not supported");
+    return GLFW_FALSE;
+}
+
+void _glfwPlatformDestroyContext(_GLFWwindow* w)
+{
+}
+
 void _glfwPlatformDestroyWindow(_GLFWwindow* w)
 {
     if (_glfw.android.oneAndOnlyWindow == w) {
@@ -111,6 +111,10 @@ static void handleJoystickButton(struct android_app* app, AInputEvent* aevent,
   int key = AKeyEvent_getKeyCode(aevent);
   int reps = AKeyEvent_getRepeatCount(aevent);  // Has two meanings.
   int32_t action = AKeyEvent_getAction(aevent);
+  // Event times are CLOCK_MONOTONIC nanoseconds, the same as the GLFW timer.
+  if (_glfw.timer.posix.monotonic) {
+    js->eventTime = AKeyEvent_getEventTime(aevent);
+  }
   switch (action) {
   case AKEY_EVENT_ACTION_DOWN:
     // reps > 0 for DOWN means this is a key repeat event.
@@ -128,6 +132,7 @@ static void handleJoystickButton(struct android_app* app, AInputEvent* aevent,
     }
     break;
   }
+  js->eventTime = 0;
 }
 
 static int32_t handleJoystick(struct android_app* app, AInputEvent* aevent,
@@ -201,23 +206,36 @@ static int32_t handleJoystick(struct android_app* app, AInputEvent* aevent,
     return 1;  // event was handled
   }
 
+  // Android batches motion samples, so walk the history before the current
+  // sample to report every intermediate position with its own time.
+  size_t historySize = AMotionEvent_getHistorySize(aevent);
   for (unsigned i = 0; i < eventCount; i++) {
-    for (unsigned ai = 0; ai < js->axisCount; ai++) {
-      _GLFWjoystickAndroidRange* range = &js->android.axis[ai];
-      // range->id is output of MotionRange.getAxis(), e.g. AXIS_X or AXIS_Y.
-      float raw = AMotionEvent_getAxisValue(aevent, range->id, i);
-      if (raw > -range->flat && raw < range->flat) {
-        // FIXME: only force 0.f after a small delay of continuously "flat."
-        raw = 0.f;  // No other way to tell app "raw value is centered."
-      } else {
-        raw -= range->base;  // From (base, base+range) to (0, range)
-        raw /= range->range; // From (0, range) to (0, 1)
-        raw *= 2.f;          // From (0, 1)     to (0, 2)
-        raw -= 1.f;          // From (0, 2)     to (-1, 1) required by GLFW
+    for (size_t h = 0; h <= historySize; h++) {
+      if (_glfw.timer.posix.monotonic) {
+        js->eventTime = h < historySize ?
+            AMotionEvent_getHistoricalEventTime(aevent, h) :
+            AMotionEvent_getEventTime(aevent);
+      }
+      for (unsigned ai = 0; ai < js->axisCount; ai++) {
+        _GLFWjoystickAndroidRange* range = &js->android.axis[ai];
+        // range->id is output of MotionRange.getAxis(), e.g. AXIS_X or AXIS_Y.
+        float raw = h < historySize ?
+            AMotionEvent_getHistoricalAxisValue(aevent, range->id, i, h) :
+            AMotionEvent_getAxisValue(aevent, range->id, i);
+        if (raw > -range->flat && raw < range->flat) {
+          // FIXME: only force 0.f after a small delay of continuously "flat."
+          raw = 0.f;  // No other way to tell app "raw value is centered."
+        } else {
+          raw -= range->base;  // From (base, base+range) to (0, range)
+          raw /= range->range; // From (0, range) to (0, 1)
+          raw *= 2.f;          // From (0, 1)     to (0, 2)
+          raw -= 1.f;          // From (0, 2)     to (-1, 1) required by GLFW
+        }
+        _glfwInputJoystickAxis(js, ai, raw);
       }
-      _glfwInputJoystickAxis(js, ai, raw);
     }
   }
+  js->eventTime = 0;
 
   if (_glfw.android.oneAndOnlyWindow) {
     GLFWinputEvent ie;
@@ -326,6 +326,7 @@ static void androidKeyToUtf32(struct android_app* app, AInputEvent* event,
 #undef COMBINING_ACCENT
   }
 
+  // Each repeat reports its key event before its text, as on other platforms.
   for (int i = 0; i < repCount; i++) {
     _glfwInputKey(_glfw.android.oneAndOnlyWindow, key, scancode, action, mods);
     if (utf32) {
@@ -508,11 +508,7 @@ static void _glfwPlatformIOevent(CFFileDescriptorRef kqref, CFOptionFlags callBa
 
 - (NSApplicationTerminateReply)applicationShouldTerminate:(NSApplication *)sender
 {
-    _GLFWwindow* window;
-
-    for (window = _glfw.windowListHead;  window;  window = window->next)
-        _glfwInputWindowCloseRequest(window);
-
+    _glfwInputWindowCloseRequestAll();
     return NSTerminateCancel;
 }
 
@@ -520,11 +516,13 @@ static void _glfwPlatformIOevent(CFFileDescriptorRef kqref, CFOptionFlags callBa
 {
     _GLFWwindow* window;
 
+    _glfwPlatformLockMutex(&_glfw.windowLock);
     for (window = _glfw.windowListHead;  window;  window = window->next)
     {
         if (window->context.client != GLFW_NO_API)
             [window->context.nsgl.object update];
     }
+    _glfwPlatformUnlockMutex(&_glfw.windowLock);
 
     _glfwPollMonitorsNS();
 }
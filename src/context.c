@@ -31,11 +31,229 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <limits.h>
 #include <stdio.h>
 
 
+// Returns the cache entry for the specified entry point name, which has no name
+// if the entry point has not been resolved yet, growing the table as needed
+// Returns NULL if the table needed to grow and could not be
+//
+static _GLFWprocentry* findProcEntry(_GLFWproccache* cache, const char* name)
+{
+    uint32_t mask, slot;
+
+    if (_GLFW_HASH_TABLE_FULL(cache->count + 1, cache->size))
+    {
+        int i;
+        // A loader typically resolves well over a thousand entry points
+        const int size = cache->size ? cache->size * 2 : 4096;
+        _GLFWprocentry* entries = calloc(size, sizeof(_GLFWprocentry));
+        if (!entries)
+            return NULL;
+
+        mask = (uint32_t) size - 1;
+
+        for (i = 0;  i < cache->size;  i++)
+        {
+            if (!cache->entries[i].name)
+                continue;
+
+            slot = _glfwHashString(cache->entries[i].name) & mask;
+            while (entries[slot].name)
+                slot = (slot + 1) & mask;
+
+            entries[slot] = cache->entries[i];
+        }
+
+        free(cache->entries);
+        cache->entries = entries;
+        cache->size = size;
+    }
+
+    mask = (uint32_t) cache->size - 1;
+
+    for (slot = _glfwHashString(name) & mask;
+         cache->entries[slot].name;
+         slot = (slot + 1) & mask)
+    {
+        if (strcmp(cache->entries[slot].name, name) == 0)
+            break;
+    }
+
+    return cache->entries + slot;
+}
+
+// Resolves an entry point of the specified context, going through the cache of
+// its library if it has one
+//
+// The caller must hold the entry point cache lock
+//
+static GLFWglproc getProcAddress(_GLFWwindow* window, const char* procname)
+{
+    _GLFWproccache* cache = window->context.procCache;
+    _GLFWprocentry* entry;
+
+    if (!cache)
+        return window->context.getProcAddress(procname);
+
+    // Entry points that were not found are cached as well, as loaders ask for
+    // every extension function they know of
+    entry = findProcEntry(cache, procname);
+    if (!entry)
+        return window->context.getProcAddress(procname);
+
+    if (!entry->name)
+    {
+        entry->name = _glfw_strdup(procname);
+        entry->proc = window->context.getProcAddress(procname);
+        cache->count++;
+    }
+
+    return entry->proc;
+}
+
+// Appends an extension name to a buffer of NUL-separated names
+// Returns GLFW_FALSE, leaving the buffer as it was, if it could not be grown
+//
+static GLFWbool appendExtension(char** names, size_t* size, size_t* capacity,
+                                const char* name, size_t length)
+{
+    if (*size + length + 1 > *capacity)
+    {
+        char* grown;
+        size_t required = *capacity;
+
+        while (*size + length + 1 > required)
+            required = required ? required * 2 : 4096;
+
+        grown = realloc(*names, required);
+        if (!grown)
+            return GLFW_FALSE;
+
+        *names = grown;
+        *capacity = required;
+    }
+
+    memcpy(*names + *size, name, length);
+    (*names)[*size + length] = '\0';
+    *size += length + 1;
+    return GLFW_TRUE;
+}
+
+// Appends every name in a space-separated extension string to a buffer of
+// NUL-separated names
+//
+static GLFWbool appendExtensionString(char** names, size_t* size,
+                                      size_t* capacity, const char* extensions)
+{
+    while (*extensions)
+    {
+        const size_t length = strcspn(extensions, " ");
+        if (length && !appendExtension(names, size, capacity, extensions, length))
+            return GLFW_FALSE;
+
+        extensions += length;
+        while (*extensions == ' ')
+            extensions++;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Builds the hash set of client API and platform extensions of the current
+// context, so that glfwExtensionSupported does not have to query the driver
+// Returns GLFW_FALSE if the extension strings are broken or there was not
+// enough memory, in which case glfwExtensionSupported searches the strings
+//
+static GLFWbool buildExtensionSet(_GLFWwindow* window)
+{
+    _GLFWcontext* context = &window->context;
+    char* names = NULL;
+    size_t size = 0, capacity = 0;
+    const char* name;
+    const char* extensions;
+    int count = 0, slots;
+    uint32_t mask;
+
+    if (context->major >= 3)
+    {
+        int i;
+        GLint extensionCount;
+
+        // Retrieve the modern OpenGL extensions string list
+
+        context->GetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+        for (i = 0;  i < extensionCount;  i++)
+        {
+            const char* en = (const char*) context->GetStringi(GL_EXTENSIONS, i);
+            if (!en || !appendExtension(&names, &size, &capacity, en, strlen(en)))
+            {
+                free(names);
+                return GLFW_FALSE;
+            }
+        }
+    }
+    else
+    {
+        // Retrieve the old style OpenGL extensions string
+
+        extensions = (const char*) context->GetString(GL_EXTENSIONS);
+        if (!extensions ||
+            !appendExtensionString(&names, &size, &capacity, extensions))
+        {
+            free(names);
+            return GLFW_FALSE;
+        }
+    }
+
+    // Retrieve the platform-specific extensions string, if any
+    extensions = context->getExtensions();
+    if (extensions &&
+        !appendExtensionString(&names, &size, &capacity, extensions))
+    {
+        free(names);
+        return GLFW_FALSE;
+    }
+
+    for (name = names;  name < names + size;  name += strlen(name) + 1)
+        count++;
+
+    slots = 16;
+    while (_GLFW_HASH_TABLE_FULL(count, slots))
+        slots *= 2;
+
+    context->extensions = calloc(slots, sizeof(const char*));
+    if (!context->extensions)
+    {
+        free(names);
+        return GLFW_FALSE;
+    }
+
+    context->extensionSlots = slots;
+    context->extensionNames = names;
+    mask = (uint32_t) slots - 1;
+
+    for (name = names;  name < names + size;  name += strlen(name) + 1)
+    {
+        uint32_t slot = _glfwHashString(name) & mask;
+
+        while (context->extensions[slot] &&
+               strcmp(context->extensions[slot], name) != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        context->extensions[slot] = name;
+    }
+
+    return GLFW_TRUE;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
@@ -341,6 +559,71 @@ const _GLFWfbconfig* _glfwChooseFBConfig(const _GLFWfbconfig* desired,
     return closest;
 }
 
+// Creates a framebuffer config cache, taking ownership of the specified array
+// The array is freed if the cache could not be created
+//
+_GLFWfbconfigcache* _glfwCreateFBConfigCache(_GLFWfbconfig* configs, int count)
+{
+    _GLFWfbconfigcache* cache = calloc(1, sizeof(_GLFWfbconfigcache));
+    if (!cache)
+    {
+        free(configs);
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return NULL;
+    }
+
+    cache->configs = configs;
+    cache->count = count;
+    return cache;
+}
+
+// Frees a framebuffer config cache and its configs
+//
+void _glfwFreeFBConfigCache(_GLFWfbconfigcache* cache)
+{
+    if (!cache)
+        return;
+
+    free(cache->configs);
+    free(cache);
+}
+
+// Chooses the cached framebuffer config that best matches the desired one,
+// reusing the result of an earlier identical request if there was one
+//
+const _GLFWfbconfig* _glfwChooseCachedFBConfig(_GLFWfbconfigcache* cache,
+                                               const _GLFWfbconfig* desired)
+{
+    int i, slot;
+    uint32_t hash;
+    _GLFWfbconfig key;
+    // Every member before the handle is an int, so this covers no padding
+    const size_t size = offsetof(_GLFWfbconfig, handle);
+
+    key = *desired;
+    key.handle = 0;
+    hash = _glfwHashBytes(&key, size);
+
+    for (i = 0;  i < cache->choiceCount && i < _GLFW_FBCONFIG_CHOICES;  i++)
+    {
+        if (cache->choices[i].hash == hash &&
+            memcmp(&cache->choices[i].desired, &key, size) == 0)
+        {
+            return cache->choices[i].closest;
+        }
+    }
+
+    // Replace the oldest remembered choice once they are all in use
+    slot = cache->choiceCount % _GLFW_FBCONFIG_CHOICES;
+    cache->choices[slot].hash = hash;
+    cache->choices[slot].desired = key;
+    cache->choices[slot].closest =
+        _glfwChooseFBConfig(desired, cache->configs, cache->count);
+    cache->choiceCount++;
+
+    return cache->choices[slot].closest;
+}
+
 // Retrieves the attributes of the current context
 //
 GLFWbool _glfwRefreshContextAttribs(_GLFWwindow* window,
@@ -471,6 +754,8 @@ GLFWbool _glfwRefreshContextAttribs(_GLFWwindow* window,
         }
     }
 
+    buildExtensionSet(window);
+
     if (window->context.client == GLFW_OPENGL_API)
     {
         // Read back context flags (OpenGL 3.0 and above)
@@ -566,17 +851,32 @@ GLFWbool _glfwRefreshContextAttribs(_GLFWwindow* window,
 
     // Clearing the front buffer to black to avoid garbage pixels left over from
     // previous uses of our bit of VRAM
+    if (!window->windowless)
     {
         PFNGLCLEARPROC glClear = (PFNGLCLEARPROC)
             window->context.getProcAddress("glClear");
         glClear(GL_COLOR_BUFFER_BIT);
         window->context.swapBuffers(window);
+        window->context.swaps++;
     }
 
     glfwMakeContextCurrent((GLFWwindow*) previous);
     return GLFW_TRUE;
 }
 
+// Frees the entry points in the specified cache
+//
+void _glfwFreeProcCache(_GLFWproccache* cache)
+{
+    int i;
+
+    for (i = 0;  i < cache->size;  i++)
+        free(cache->entries[i].name);
+
+    free(cache->entries);
+    memset(cache, 0, sizeof(_GLFWproccache));
+}
+
 // Searches an extension string for the specified extension
 //
 GLFWbool _glfwStringInExtensionString(const char* string, const char* extensions)
@@ -642,6 +942,7 @@ GLFWAPI GLFWwindow* glfwGetCurrentContext(void)
 
 GLFWAPI void glfwSwapBuffers(GLFWwindow* handle)
 {
+    uint64_t start;
     _GLFWwindow* window = (_GLFWwindow*) handle;
     assert(window != NULL);
 
@@ -654,7 +955,15 @@ GLFWAPI void glfwSwapBuffers(GLFWwindow* handle)
         return;
     }
 
+    // A windowless context has no buffers to present
+    if (window->windowless)
+        return;
+
+    start = _glfwPlatformGetTimerValue();
     window->context.swapBuffers(window);
+    window->context.swaps++;
+    _glfwRecordSwap(window, start);
+    _glfwProbeFrameSubmitted(window);
 }
 
 GLFWAPI void glfwSwapInterval(int interval)
@@ -671,12 +980,17 @@ GLFWAPI void glfwSwapInterval(int interval)
         return;
     }
 
+    // A windowless context has no buffers to present
+    if (window->windowless)
+        return;
+
     window->context.swapInterval(interval);
 }
 
 GLFWAPI int glfwExtensionSupported(const char* extension)
 {
     _GLFWwindow* window;
+    const char* extensions;
     assert(extension != NULL);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
@@ -695,6 +1009,26 @@ GLFWAPI int glfwExtensionSupported(const char* extension)
         return GLFW_FALSE;
     }
 
+    if (window->context.extensionSlots)
+    {
+        // Check if extension is in the client API or platform-specific set
+
+        const uint32_t mask = (uint32_t) window->context.extensionSlots - 1;
+        uint32_t slot;
+
+        for (slot = _glfwHashString(extension) & mask;
+             window->context.extensions[slot];
+             slot = (slot + 1) & mask)
+        {
+            if (strcmp(window->context.extensions[slot], extension) == 0)
+                return GLFW_TRUE;
+        }
+
+        return GLFW_FALSE;
+    }
+
+    // The set could not be built, so the extension strings are searched
+
     if (window->context.major >= 3)
     {
         int i;
@@ -723,8 +1057,7 @@ GLFWAPI int glfwExtensionSupported(const char* extension)
     {
         // Check if extension is in the old style OpenGL extensions string
 
-        const char* extensions = (const char*)
-            window->context.GetString(GL_EXTENSIONS);
+        extensions = (const char*) window->context.GetString(GL_EXTENSIONS);
         if (!extensions)
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -737,12 +1070,17 @@ GLFWAPI int glfwExtensionSupported(const char* extension)
     }
 
     // Check if extension is in the platform-specific string
-    return window->context.extensionSupported(extension);
+    extensions = window->context.getExtensions();
+    if (extensions && _glfwStringInExtensionString(extension, extensions))
+        return GLFW_TRUE;
+
+    return GLFW_FALSE;
 }
 
 GLFWAPI GLFWglproc glfwGetProcAddress(const char* procname)
 {
     _GLFWwindow* window;
+    GLFWglproc proc;
     assert(procname != NULL);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
@@ -755,6 +1093,54 @@ GLFWAPI GLFWglproc glfwGetProcAddress(const char* procname)
         return NULL;
     }
 
-    return window->context.getProcAddress(procname);
+    _glfwPlatformLockMutex(&_glfw.procCacheLock);
+    proc = getProcAddress(window, procname);
+    _glfwPlatformUnlockMutex(&_glfw.procCacheLock);
+
+    return proc;
+}
+
+GLFWAPI int glfwGetProcAddresses(const char** names, GLFWglproc* procs, int count)
+{
+    _GLFWwindow* window;
+    int i, found = 0;
+
+    assert(count >= 0);
+    assert(names != NULL || count == 0);
+    assert(procs != NULL || count == 0);
+
+    if (count > 0)
+        memset(procs, 0, count * sizeof(GLFWglproc));
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (count < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid entry point count %i", count);
+        return 0;
+    }
+
+    window = _glfwPlatformGetTls(&_glfw.contextSlot);
+    if (!window)
+    {
+        _glfwInputError(GLFW_NO_CURRENT_CONTEXT,
+                        "Cannot query entry points without a current OpenGL or OpenGL ES context");
+        return 0;
+    }
+
+    _glfwPlatformLockMutex(&_glfw.procCacheLock);
+
+    for (i = 0;  i < count;  i++)
+    {
+        assert(names[i] != NULL);
+
+        procs[i] = getProcAddress(window, names[i]);
+        if (procs[i])
+            found++;
+    }
+
+    _glfwPlatformUnlockMutex(&_glfw.procCacheLock);
+
+    return found;
 }
 
@@ -85,22 +85,32 @@ static int getEGLConfigAttrib(EGLConfig config, int attrib)
     return value;
 }
 
-// Return the EGLConfig most closely matching the specified hints
+// Returns the usable EGLConfigs for the specified client API translated to GLFW
+// form, enumerating them the first time
 //
-static GLFWbool chooseEGLConfig(const _GLFWctxconfig* ctxconfig,
-                                const _GLFWfbconfig* desired,
-                                EGLConfig* result)
+static _GLFWfbconfigcache* getEGLConfigs(const _GLFWctxconfig* ctxconfig,
+                                         GLFWbool transparent,
+                                         GLFWbool windowless)
 {
     EGLConfig* nativeConfigs;
     _GLFWfbconfig* usableConfigs;
-    const _GLFWfbconfig* closest;
-    int i, nativeCount, usableCount;
+    int i, nativeCount, usableCount, client;
+    // A windowless context has no framebuffer to be transparent
+    const int index = windowless ? 2 : transparent;
+
+    if (ctxconfig->client == GLFW_OPENGL_ES_API)
+        client = (ctxconfig->major == 1) ? 1 : 2;
+    else
+        client = 0;
+
+    if (_glfw.egl.fbconfigs[client][index])
+        return _glfw.egl.fbconfigs[client][index];
 
     eglGetConfigs(_glfw.egl.display, NULL, 0, &nativeCount);
     if (!nativeCount)
     {
         _glfwInputError(GLFW_API_UNAVAILABLE, "EGL: No EGLConfigs returned");
-        return GLFW_FALSE;
+        return NULL;
     }
 
     nativeConfigs = calloc(nativeCount, sizeof(EGLConfig));
@@ -118,11 +128,27 @@ static GLFWbool chooseEGLConfig(const _GLFWctxconfig* ctxconfig,
         if (getEGLConfigAttrib(n, EGL_COLOR_BUFFER_TYPE) != EGL_RGB_BUFFER)
             continue;
 
-        // Only consider window EGLConfigs
-        if (!(getEGLConfigAttrib(n, EGL_SURFACE_TYPE) & EGL_WINDOW_BIT))
+#if defined(_GLFW_EGL_HEADLESS)
+        // Only consider pbuffer EGLConfigs, as there are no windows
+        if (!(getEGLConfigAttrib(n, EGL_SURFACE_TYPE) & EGL_PBUFFER_BIT))
             continue;
+#else
+        if (windowless)
+        {
+            // Only consider EGLConfigs the pbuffer can be created with
+            if (!(getEGLConfigAttrib(n, EGL_SURFACE_TYPE) & EGL_PBUFFER_BIT))
+                continue;
+        }
+        else
+        {
+            // Only consider window EGLConfigs
+            if (!(getEGLConfigAttrib(n, EGL_SURFACE_TYPE) & EGL_WINDOW_BIT))
+                continue;
+        }
+#endif
 
 #if defined(_GLFW_X11)
+        if (!windowless)
         {
             XVisualInfo vi = {0};
 
@@ -131,7 +157,7 @@ static GLFWbool chooseEGLConfig(const _GLFWctxconfig* ctxconfig,
             if (!vi.visualid)
                 continue;
 
-            if (desired->transparent)
+            if (transparent)
             {
                 int count;
                 XVisualInfo* vis =
@@ -179,16 +205,364 @@ static GLFWbool chooseEGLConfig(const _GLFWctxconfig* ctxconfig,
         usableCount++;
     }
 
-    closest = _glfwChooseFBConfig(desired, usableConfigs, usableCount);
+    free(nativeConfigs);
+
+    _glfw.egl.fbconfigs[client][index] =
+        _glfwCreateFBConfigCache(usableConfigs, usableCount);
+    return _glfw.egl.fbconfigs[client][index];
+}
+
+// Return the EGLConfig most closely matching the specified hints
+//
+static GLFWbool chooseEGLConfig(const _GLFWctxconfig* ctxconfig,
+                                const _GLFWfbconfig* desired,
+                                GLFWbool windowless,
+                                EGLConfig* result)
+{
+    const _GLFWfbconfig* closest;
+    _GLFWfbconfigcache* cache =
+        getEGLConfigs(ctxconfig, desired->transparent, windowless);
+    if (!cache)
+        return GLFW_FALSE;
+
+#if defined(_GLFW_EGL_HEADLESS)
+    {
+        // Buffering and multisampling are provided by the framebuffer objects
+        _GLFWfbconfig headless = *desired;
+        headless.doublebuffer = GLFW_TRUE;
+        headless.samples = 0;
+        closest = _glfwChooseCachedFBConfig(cache, &headless);
+    }
+#else
+    closest = _glfwChooseCachedFBConfig(cache, desired);
+#endif
+
     if (closest)
         *result = (EGLConfig) closest->handle;
 
-    free(nativeConfigs);
-    free(usableConfigs);
-
     return closest != NULL;
 }
 
+#if defined(_GLFW_EGL_HEADLESS)
+
+// Loads the functions needed for the framebuffer objects of a headless context
+//
+static GLFWbool loadFramebufferFunctions(_GLFWwindow* window)
+{
+    window->context.egl.fbo.GenFramebuffers = (PFN_glGenFramebuffers)
+        window->context.getProcAddress("glGenFramebuffers");
+    window->context.egl.fbo.DeleteFramebuffers = (PFN_glDeleteFramebuffers)
+        window->context.getProcAddress("glDeleteFramebuffers");
+    window->context.egl.fbo.BindFramebuffer = (PFN_glBindFramebuffer)
+        window->context.getProcAddress("glBindFramebuffer");
+    window->context.egl.fbo.FramebufferRenderbuffer = (PFN_glFramebufferRenderbuffer)
+        window->context.getProcAddress("glFramebufferRenderbuffer");
+    window->context.egl.fbo.CheckFramebufferStatus = (PFN_glCheckFramebufferStatus)
+        window->context.getProcAddress("glCheckFramebufferStatus");
+    window->context.egl.fbo.GenRenderbuffers = (PFN_glGenRenderbuffers)
+        window->context.getProcAddress("glGenRenderbuffers");
+    window->context.egl.fbo.DeleteRenderbuffers = (PFN_glDeleteRenderbuffers)
+        window->context.getProcAddress("glDeleteRenderbuffers");
+    window->context.egl.fbo.BindRenderbuffer = (PFN_glBindRenderbuffer)
+        window->context.getProcAddress("glBindRenderbuffer");
+    window->context.egl.fbo.RenderbufferStorageMultisample = (PFN_glRenderbufferStorageMultisample)
+        window->context.getProcAddress("glRenderbufferStorageMultisample");
+    window->context.egl.fbo.BlitFramebuffer = (PFN_glBlitFramebuffer)
+        window->context.getProcAddress("glBlitFramebuffer");
+    window->context.egl.fbo.GetIntegerv = (PFNGLGETINTEGERVPROC)
+        window->context.getProcAddress("glGetIntegerv");
+    window->context.egl.fbo.Viewport = (PFN_glViewport)
+        window->context.getProcAddress("glViewport");
+    window->context.egl.fbo.Flush = (PFN_glFlush)
+        window->context.getProcAddress("glFlush");
+
+    if (!window->context.egl.fbo.GenFramebuffers ||
+        !window->context.egl.fbo.DeleteFramebuffers ||
+        !window->context.egl.fbo.BindFramebuffer ||
+        !window->context.egl.fbo.FramebufferRenderbuffer ||
+        !window->context.egl.fbo.CheckFramebufferStatus ||
+        !window->context.egl.fbo.GenRenderbuffers ||
+        !window->context.egl.fbo.DeleteRenderbuffers ||
+        !window->context.egl.fbo.BindRenderbuffer ||
+        !window->context.egl.fbo.RenderbufferStorageMultisample ||
+        !window->context.egl.fbo.BlitFramebuffer ||
+        !window->context.egl.fbo.GetIntegerv ||
+        !window->context.egl.fbo.Viewport ||
+        !window->context.egl.fbo.Flush)
+    {
+        _glfwInputError(GLFW_VERSION_UNAVAILABLE,
+                        "EGL: Headless contexts require framebuffer object support");
+        return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Allocates storage for the framebuffer objects of a headless context at the
+// current size of its window
+//
+// The context must be current on the calling thread
+//
+static void resizeFramebuffers(_GLFWwindow* window)
+{
+    int i, width, height;
+    GLint previous;
+
+    _glfwPlatformGetFramebufferSize(window, &width, &height);
+    if (width < 1)
+        width = 1;
+    if (height < 1)
+        height = 1;
+
+    if (width == window->context.egl.fbo.width &&
+        height == window->context.egl.fbo.height)
+    {
+        return;
+    }
+
+    window->context.egl.fbo.GetIntegerv(GL_RENDERBUFFER_BINDING, &previous);
+
+    for (i = 0;  i < window->context.egl.fbo.count;  i++)
+    {
+        // Only the back buffer is multisampled, as the front buffer receives
+        // the resolved image
+        const int samples = i == 0 ? window->context.egl.fbo.samples : 0;
+
+        window->context.egl.fbo.BindRenderbuffer(GL_RENDERBUFFER,
+                                                 window->context.egl.fbo.colorbuffers[i]);
+        window->context.egl.fbo.RenderbufferStorageMultisample(GL_RENDERBUFFER,
+                                                               samples,
+                                                               window->context.egl.fbo.colorFormat,
+                                                               width, height);
+    }
+
+    if (window->context.egl.fbo.depthStencil)
+    {
+        window->context.egl.fbo.BindRenderbuffer(GL_RENDERBUFFER,
+                                                 window->context.egl.fbo.depthStencil);
+        window->context.egl.fbo.RenderbufferStorageMultisample(GL_RENDERBUFFER,
+                                                               window->context.egl.fbo.samples,
+                                                               window->context.egl.fbo.depthStencilFormat,
+                                                               width, height);
+    }
+
+    window->context.egl.fbo.BindRenderbuffer(GL_RENDERBUFFER, (GLuint) previous);
+
+    window->context.egl.fbo.width = width;
+    window->context.egl.fbo.height = height;
+}
+
+// Makes the specified context current again after temporarily making
+// a headless context current, or clears the current context
+//
+static void restoreContext(_GLFWwindow* previous)
+{
+    if (previous)
+        previous->context.makeCurrent(previous);
+    else
+    {
+        eglMakeCurrent(_glfw.egl.display,
+                       EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        _glfwPlatformSetTls(&_glfw.contextSlot, NULL);
+    }
+}
+
+// Creates the framebuffer objects standing in for the default framebuffer of a
+// headless context and binds the back buffer
+//
+// The context must be current on the calling thread
+//
+static GLFWbool createFramebuffers(_GLFWwindow* window)
+{
+    int i;
+    GLint maxSamples = 0;
+
+    if (!loadFramebufferFunctions(window))
+        return GLFW_FALSE;
+
+    // Like with EGLConfigs, the closest available sample count is used
+    window->context.egl.fbo.GetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+    if (window->context.egl.fbo.samples > maxSamples)
+        window->context.egl.fbo.samples = maxSamples;
+
+    window->context.egl.fbo.GenFramebuffers(window->context.egl.fbo.count,
+                                            window->context.egl.fbo.framebuffers);
+    window->context.egl.fbo.GenRenderbuffers(window->context.egl.fbo.count,
+                                             window->context.egl.fbo.colorbuffers);
+    if (window->context.egl.fbo.depthStencilFormat)
+    {
+        window->context.egl.fbo.GenRenderbuffers(1,
+                                                 &window->context.egl.fbo.depthStencil);
+    }
+
+    resizeFramebuffers(window);
+
+    for (i = window->context.egl.fbo.count - 1;  i >= 0;  i--)
+    {
+        const GLuint depthStencil = window->context.egl.fbo.depthStencil;
+        const GLenum format = window->context.egl.fbo.depthStencilFormat;
+
+        window->context.egl.fbo.BindFramebuffer(GL_FRAMEBUFFER,
+                                                window->context.egl.fbo.framebuffers[i]);
+        window->context.egl.fbo.FramebufferRenderbuffer(GL_FRAMEBUFFER,
+                                                        GL_COLOR_ATTACHMENT0,
+                                                        GL_RENDERBUFFER,
+                                                        window->context.egl.fbo.colorbuffers[i]);
+
+        // The front buffer only receives color, unless the buffers are
+        // exchanged on swap, in which case both need depth and stencil
+        if (depthStencil && (i == 0 || !window->context.egl.fbo.samples))
+        {
+            if (format != GL_STENCIL_INDEX8)
+            {
+                window->context.egl.fbo.FramebufferRenderbuffer(GL_FRAMEBUFFER,
+                                                                GL_DEPTH_ATTACHMENT,
+                                                                GL_RENDERBUFFER,
+                                                                depthStencil);
+            }
+
+            if (format != GL_DEPTH_COMPONENT24)
+            {
+                window->context.egl.fbo.FramebufferRenderbuffer(GL_FRAMEBUFFER,
+                                                                GL_STENCIL_ATTACHMENT,
+                                                                GL_RENDERBUFFER,
+                                                                depthStencil);
+            }
+        }
+
+        if (window->context.egl.fbo.CheckFramebufferStatus(GL_FRAMEBUFFER) !=
+            GL_FRAMEBUFFER_COMPLETE)
+        {
+            _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                            "EGL: Failed to create a complete framebuffer object");
+            return GLFW_FALSE;
+        }
+    }
+
+    // The loop above ends with the back buffer bound, and like with a window
+    // surface the initial viewport covers all of it
+    window->context.egl.fbo.Viewport(0, 0,
+                                     window->context.egl.fbo.width,
+                                     window->context.egl.fbo.height);
+    return GLFW_TRUE;
+}
+
+// Destroys the framebuffer objects of a headless context
+//
+static void destroyFramebuffers(_GLFWwindow* window)
+{
+    _GLFWwindow* previous;
+
+    if (!window->context.egl.fbo.framebuffers[0])
+        return;
+
+    // Framebuffer objects are not shared, but renderbuffers are, so they need
+    // to be deleted explicitly in case another context shares this one
+    previous = _glfwPlatformGetTls(&_glfw.contextSlot);
+    if (!eglMakeCurrent(_glfw.egl.display,
+                        window->context.egl.surface,
+                        window->context.egl.surface,
+                        window->context.egl.handle))
+    {
+        return;
+    }
+
+    window->context.egl.fbo.DeleteFramebuffers(window->context.egl.fbo.count,
+                                               window->context.egl.fbo.framebuffers);
+    window->context.egl.fbo.DeleteRenderbuffers(window->context.egl.fbo.count,
+                                                window->context.egl.fbo.colorbuffers);
+    if (window->context.egl.fbo.depthStencil)
+    {
+        window->context.egl.fbo.DeleteRenderbuffers(1,
+                                                    &window->context.egl.fbo.depthStencil);
+    }
+
+    memset(window->context.egl.fbo.framebuffers, 0,
+           sizeof(window->context.egl.fbo.framebuffers));
+
+    // The window being destroyed is never current at this point
+    restoreContext(previous);
+}
+
+// Presents the back buffer of a headless context
+//
+static void swapFramebuffers(_GLFWwindow* window)
+{
+    GLint draw, read;
+    GLuint back, front;
+
+    if (window->context.egl.fbo.count == 1)
+    {
+        window->context.egl.fbo.Flush();
+        resizeFramebuffers(window);
+        return;
+    }
+
+    back = window->context.egl.fbo.framebuffers[0];
+    front = window->context.egl.fbo.framebuffers[1];
+
+    window->context.egl.fbo.GetIntegerv(GL_FRAMEBUFFER_BINDING, &draw);
+    window->context.egl.fbo.GetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read);
+
+    if (window->context.egl.fbo.samples)
+    {
+        // Resolve the multisampled back buffer into the front buffer
+        window->context.egl.fbo.BindFramebuffer(GL_READ_FRAMEBUFFER, back);
+        window->context.egl.fbo.BindFramebuffer(GL_DRAW_FRAMEBUFFER, front);
+        window->context.egl.fbo.BlitFramebuffer(0, 0,
+                                                window->context.egl.fbo.width,
+                                                window->context.egl.fbo.height,
+                                                0, 0,
+                                                window->context.egl.fbo.width,
+                                                window->context.egl.fbo.height,
+                                                GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        window->context.egl.fbo.BindFramebuffer(GL_DRAW_FRAMEBUFFER, (GLuint) draw);
+        window->context.egl.fbo.BindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint) read);
+    }
+    else
+    {
+        GLuint colorbuffer;
+
+        // Exchange the buffers and move any default framebuffer bindings to
+        // the new back buffer, leaving bindings of other framebuffers alone
+        window->context.egl.fbo.framebuffers[0] = front;
+        window->context.egl.fbo.framebuffers[1] = back;
+        colorbuffer = window->context.egl.fbo.colorbuffers[0];
+        window->context.egl.fbo.colorbuffers[0] = window->context.egl.fbo.colorbuffers[1];
+        window->context.egl.fbo.colorbuffers[1] = colorbuffer;
+
+        if ((GLuint) draw == back)
+            window->context.egl.fbo.BindFramebuffer(GL_DRAW_FRAMEBUFFER, front);
+        if ((GLuint) read == back)
+            window->context.egl.fbo.BindFramebuffer(GL_READ_FRAMEBUFFER, front);
+    }
+
+    window->context.egl.fbo.Flush();
+    resizeFramebuffers(window);
+}
+
+#endif // _GLFW_EGL_HEADLESS
+
+// Creates the single pixel pbuffer surface used by contexts that have no
+// window surface on implementations without EGL_KHR_surfaceless_context
+//
+static GLFWbool createPbufferSurface(_GLFWwindow* window, EGLConfig config)
+{
+    const EGLint attribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+
+    window->context.egl.surface =
+        eglCreatePbufferSurface(_glfw.egl.display, config, attribs);
+    if (window->context.egl.surface == EGL_NO_SURFACE)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "EGL: Failed to create pbuffer surface: %s",
+                        getEGLErrorString(eglGetError()));
+        return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
 static void makeContextCurrentEGL(_GLFWwindow* window)
 {
     if (window)
@@ -203,6 +577,17 @@ static void makeContextCurrentEGL(_GLFWwindow* window)
                             getEGLErrorString(eglGetError()));
             return;
         }
+
+#if defined(_GLFW_EGL_HEADLESS)
+        _glfwPlatformSetTls(&_glfw.contextSlot, window);
+
+        // The framebuffer objects follow the size of the window, which may
+        // have changed while the context was not current
+        if (window->context.egl.fbo.framebuffers[0])
+            resizeFramebuffers(window);
+
+        return;
+#endif // _GLFW_EGL_HEADLESS
     }
     else
     {
@@ -230,7 +615,11 @@ static void swapBuffersEGL(_GLFWwindow* window)
         return;
     }
 
+#if defined(_GLFW_EGL_HEADLESS)
+    swapFramebuffers(window);
+#else
     eglSwapBuffers(_glfw.egl.display, window->context.egl.surface);
+#endif
 }
 
 static void swapIntervalEGL(int interval)
@@ -238,6 +627,11 @@ static void swapIntervalEGL(int interval)
     eglSwapInterval(_glfw.egl.display, interval);
 }
 
+static const char* getExtensionsEGL(void)
+{
+    return eglQueryString(_glfw.egl.display, EGL_EXTENSIONS);
+}
+
 static int extensionSupportedEGL(const char* extension)
 {
     const char* extensions = eglQueryString(_glfw.egl.display, EGL_EXTENSIONS);
@@ -267,6 +661,10 @@ static GLFWglproc getProcAddressEGL(const char* procname)
 
 static void destroyContextEGL(_GLFWwindow* window)
 {
+#if defined(_GLFW_EGL_HEADLESS)
+    destroyFramebuffers(window);
+#endif
+
 #if defined(_GLFW_X11)
     // NOTE: Do not unload libGL.so.1 while the X11 display is still open,
     //       as it will make XCloseDisplay segfault
@@ -370,6 +768,8 @@ GLFWbool _glfwInitEGL(void)
         _glfw_dlsym(_glfw.egl.handle, "eglQueryString");
     _glfw.egl.GetProcAddress = (PFN_eglGetProcAddress)
         _glfw_dlsym(_glfw.egl.handle, "eglGetProcAddress");
+    _glfw.egl.CreatePbufferSurface = (PFN_eglCreatePbufferSurface)
+        _glfw_dlsym(_glfw.egl.handle, "eglCreatePbufferSurface");
 
     if (!_glfw.egl.GetConfigAttrib ||
         !_glfw.egl.GetConfigs ||
@@ -386,7 +786,8 @@ GLFWbool _glfwInitEGL(void)
         !_glfw.egl.SwapBuffers ||
         !_glfw.egl.SwapInterval ||
         !_glfw.egl.QueryString ||
-        !_glfw.egl.GetProcAddress)
+        !_glfw.egl.GetProcAddress ||
+        !_glfw.egl.CreatePbufferSurface)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "EGL: Failed to load required entry points");
@@ -395,7 +796,27 @@ GLFWbool _glfwInitEGL(void)
         return GLFW_FALSE;
     }
 
+#if defined(_GLFW_EGL_HEADLESS)
+    {
+        // Prefer the Mesa surfaceless platform, which needs no window system
+        const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        PFNEGLGETPLATFORMDISPLAYEXTPROC GetPlatformDisplayEXT =
+            (PFNEGLGETPLATFORMDISPLAYEXTPROC)
+            eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+        if (extensions && GetPlatformDisplayEXT &&
+            _glfwStringInExtensionString("EGL_MESA_platform_surfaceless", extensions))
+        {
+            _glfw.egl.display =
+                GetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA,
+                                      EGL_DEFAULT_DISPLAY, NULL);
+        }
+        else
+            _glfw.egl.display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+#else
     _glfw.egl.display = eglGetDisplay(_GLFW_EGL_NATIVE_DISPLAY);
+#endif
     if (_glfw.egl.display == EGL_NO_DISPLAY)
     {
         _glfwInputError(GLFW_API_UNAVAILABLE,
@@ -426,6 +847,8 @@ GLFWbool _glfwInitEGL(void)
         extensionSupportedEGL("EGL_KHR_get_all_proc_addresses");
     _glfw.egl.KHR_context_flush_control =
         extensionSupportedEGL("EGL_KHR_context_flush_control");
+    _glfw.egl.KHR_surfaceless_context =
+        extensionSupportedEGL("EGL_KHR_surfaceless_context");
 
     return GLFW_TRUE;
 }
@@ -434,6 +857,25 @@ GLFWbool _glfwInitEGL(void)
 //
 void _glfwTerminateEGL(void)
 {
+    int i, j;
+
+    for (i = 0;  i < 3;  i++)
+    {
+        _glfwFreeProcCache(&_glfw.egl.procs[i]);
+
+        for (j = 0;  j < 3;  j++)
+        {
+            _glfwFreeFBConfigCache(_glfw.egl.fbconfigs[i][j]);
+            _glfw.egl.fbconfigs[i][j] = NULL;
+        }
+
+        if (_glfw.egl.clients[i])
+        {
+            _glfw_dlclose(_glfw.egl.clients[i]);
+            _glfw.egl.clients[i] = NULL;
+        }
+    }
+
     if (_glfw.egl.display)
     {
         eglTerminate(_glfw.egl.display);
@@ -463,7 +905,7 @@ GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
     EGLint attribs[40];
     EGLConfig config;
     EGLContext share = NULL;
-    int index = 0;
+    int index = 0, cache;
 
     if (!_glfw.egl.display)
     {
@@ -474,7 +916,7 @@ GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
     if (ctxconfig->share)
         share = ctxconfig->share->context.egl.handle;
 
-    if (!chooseEGLConfig(ctxconfig, fbconfig, &config))
+    if (!chooseEGLConfig(ctxconfig, fbconfig, window->windowless, &config))
     {
         _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
                         "EGL: Failed to find a suitable EGLConfig");
@@ -598,21 +1040,60 @@ GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
 
     setAttrib(EGL_NONE, EGL_NONE);
 
-    window->context.egl.surface =
-        eglCreateWindowSurface(_glfw.egl.display,
-                               config,
-                               _GLFW_EGL_NATIVE_WINDOW,
-                               attribs);
-    if (window->context.egl.surface == EGL_NO_SURFACE)
+    if (window->windowless)
     {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "EGL: Failed to create window surface: %s",
-                        getEGLErrorString(eglGetError()));
-        return GLFW_FALSE;
+        // A windowless context has nothing to present, so a surface is only
+        // created if the context cannot be made current without one
+        if (!_glfw.egl.KHR_surfaceless_context)
+        {
+            if (!createPbufferSurface(window, config))
+                return GLFW_FALSE;
+        }
+    }
+    else
+    {
+#if defined(_GLFW_EGL_HEADLESS)
+        // Rendering goes to framebuffer objects, so a surface is only created
+        // if the context cannot be made current without one
+        if (!_glfw.egl.KHR_surfaceless_context)
+        {
+            if (!createPbufferSurface(window, config))
+                return GLFW_FALSE;
+        }
+
+        window->context.egl.fbo.count = fbconfig->doublebuffer ? 2 : 1;
+        window->context.egl.fbo.samples = fbconfig->samples > 0 ? fbconfig->samples : 0;
+        window->context.egl.fbo.colorFormat = fbconfig->sRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+
+        if (fbconfig->depthBits != 0 && fbconfig->stencilBits != 0)
+            window->context.egl.fbo.depthStencilFormat = GL_DEPTH24_STENCIL8;
+        else if (fbconfig->depthBits != 0)
+            window->context.egl.fbo.depthStencilFormat = GL_DEPTH_COMPONENT24;
+        else if (fbconfig->stencilBits != 0)
+            window->context.egl.fbo.depthStencilFormat = GL_STENCIL_INDEX8;
+#else
+        window->context.egl.surface =
+            eglCreateWindowSurface(_glfw.egl.display,
+                                   config,
+                                   _GLFW_EGL_NATIVE_WINDOW,
+                                   attribs);
+        if (window->context.egl.surface == EGL_NO_SURFACE)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "EGL: Failed to create window surface: %s",
+                            getEGLErrorString(eglGetError()));
+            return GLFW_FALSE;
+        }
+#endif // _GLFW_EGL_HEADLESS
     }
 
     window->context.egl.config = config;
 
+    if (ctxconfig->client == GLFW_OPENGL_ES_API)
+        cache = (ctxconfig->major == 1) ? 1 : 2;
+    else
+        cache = 0;
+
     // Load the appropriate client library
     if (!_glfw.egl.KHR_get_all_proc_addresses)
     {
@@ -683,6 +1164,11 @@ GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
                 break;
         }
 
+        // Keep the client library loaded after this context is destroyed, as
+        // its entry points are cached for later contexts
+        if (window->context.egl.client && !_glfw.egl.clients[cache])
+            _glfw.egl.clients[cache] = _glfw_dlopen(sonames[i]);
+
         if (!window->context.egl.client)
         {
             _glfwInputError(GLFW_API_UNAVAILABLE,
@@ -694,10 +1180,26 @@ GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
     window->context.makeCurrent = makeContextCurrentEGL;
     window->context.swapBuffers = swapBuffersEGL;
     window->context.swapInterval = swapIntervalEGL;
-    window->context.extensionSupported = extensionSupportedEGL;
+    window->context.getExtensions = getExtensionsEGL;
     window->context.getProcAddress = getProcAddressEGL;
+    window->context.procCache = &_glfw.egl.procs[cache];
     window->context.destroy = destroyContextEGL;
 
+#if defined(_GLFW_EGL_HEADLESS)
+    if (!window->windowless)
+    {
+        GLFWbool result = GLFW_FALSE;
+        _GLFWwindow* previous = _glfwPlatformGetTls(&_glfw.contextSlot);
+
+        makeContextCurrentEGL(window);
+        if (_glfwPlatformGetTls(&_glfw.contextSlot) == window)
+            result = createFramebuffers(window);
+
+        restoreContext(previous);
+        return result;
+    }
+#endif // _GLFW_EGL_HEADLESS
+
     return GLFW_TRUE;
 }
 
@@ -717,7 +1219,7 @@ GLFWbool _glfwChooseVisualEGL(const _GLFWwndconfig* wndconfig,
     EGLint visualID = 0, count = 0;
     const long vimask = VisualScreenMask | VisualIDMask;
 
-    if (!chooseEGLConfig(ctxconfig, fbconfig, &native))
+    if (!chooseEGLConfig(ctxconfig, fbconfig, GLFW_FALSE, &native))
     {
         _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
                         "EGL: Failed to find a suitable EGLConfig");
@@ -785,3 +1287,29 @@ GLFWAPI EGLSurface glfwGetEGLSurface(GLFWwindow* handle)
     return window->context.egl.surface;
 }
 
+GLFWAPI void glfwGetEGLFramebuffers(GLFWwindow* handle,
+                                    unsigned int* back, unsigned int* front)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+
+    if (back)
+        *back = 0;
+    if (front)
+        *front = 0;
+
+    _GLFW_REQUIRE_INIT();
+
+    if (window->context.client == GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT, NULL);
+        return;
+    }
+
+#if defined(_GLFW_EGL_HEADLESS)
+    if (back)
+        *back = window->context.egl.fbo.framebuffers[0];
+    if (front && window->context.egl.fbo.count > 1)
+        *front = window->context.egl.fbo.framebuffers[1];
+#endif
+}
+
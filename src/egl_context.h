@@ -43,6 +43,10 @@ typedef Window EGLNativeWindowType;
  #define EGLAPIENTRY
 typedef struct wl_display* EGLNativeDisplayType;
 typedef struct wl_egl_window* EGLNativeWindowType;
+#elif defined(_GLFW_EGL_HEADLESS)
+ #define EGLAPIENTRY
+typedef void* EGLNativeDisplayType;
+typedef void* EGLNativeWindowType;
 #else
  #error "No supported EGL platform selected"
 #endif
@@ -66,6 +70,9 @@ typedef struct wl_egl_window* EGLNativeWindowType;
 #define EGL_RGB_BUFFER 0x308e
 #define EGL_SURFACE_TYPE 0x3033
 #define EGL_WINDOW_BIT 0x0004
+#define EGL_PBUFFER_BIT 0x0001
+#define EGL_WIDTH 0x3057
+#define EGL_HEIGHT 0x3056
 #define EGL_RENDERABLE_TYPE 0x3040
 #define EGL_OPENGL_ES_BIT 0x0001
 #define EGL_OPENGL_ES2_BIT 0x0004
@@ -106,6 +113,7 @@ typedef struct wl_egl_window* EGLNativeWindowType;
 #define EGL_CONTEXT_RELEASE_BEHAVIOR_KHR 0x2097
 #define EGL_CONTEXT_RELEASE_BEHAVIOR_NONE_KHR 0
 #define EGL_CONTEXT_RELEASE_BEHAVIOR_FLUSH_KHR 0x2098
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31dd
 
 typedef int EGLint;
 typedef unsigned int EGLBoolean;
@@ -132,6 +140,8 @@ typedef EGLBoolean (EGLAPIENTRY * PFN_eglSwapBuffers)(EGLDisplay,EGLSurface);
 typedef EGLBoolean (EGLAPIENTRY * PFN_eglSwapInterval)(EGLDisplay,EGLint);
 typedef const char* (EGLAPIENTRY * PFN_eglQueryString)(EGLDisplay,EGLint);
 typedef GLFWglproc (EGLAPIENTRY * PFN_eglGetProcAddress)(const char*);
+typedef EGLSurface (EGLAPIENTRY * PFN_eglCreatePbufferSurface)(EGLDisplay,EGLConfig,const EGLint*);
+typedef EGLDisplay (EGLAPIENTRY * PFNEGLGETPLATFORMDISPLAYEXTPROC)(EGLenum,void*,const EGLint*);
 #define eglGetConfigAttrib _glfw.egl.GetConfigAttrib
 #define eglGetConfigs _glfw.egl.GetConfigs
 #define eglGetDisplay _glfw.egl.GetDisplay
@@ -148,6 +158,45 @@ typedef GLFWglproc (EGLAPIENTRY * PFN_eglGetProcAddress)(const char*);
 #define eglSwapInterval _glfw.egl.SwapInterval
 #define eglQueryString _glfw.egl.QueryString
 #define eglGetProcAddress _glfw.egl.GetProcAddress
+#define eglCreatePbufferSurface _glfw.egl.CreatePbufferSurface
+
+#if defined(_GLFW_EGL_HEADLESS)
+#define GL_FRAMEBUFFER 0x8d40
+#define GL_RENDERBUFFER 0x8d41
+#define GL_READ_FRAMEBUFFER 0x8ca8
+#define GL_DRAW_FRAMEBUFFER 0x8ca9
+#define GL_FRAMEBUFFER_BINDING 0x8ca6
+#define GL_READ_FRAMEBUFFER_BINDING 0x8caa
+#define GL_RENDERBUFFER_BINDING 0x8ca7
+#define GL_FRAMEBUFFER_COMPLETE 0x8cd5
+#define GL_COLOR_ATTACHMENT0 0x8ce0
+#define GL_DEPTH_ATTACHMENT 0x8d00
+#define GL_STENCIL_ATTACHMENT 0x8d20
+#define GL_RGBA8 0x8058
+#define GL_SRGB8_ALPHA8 0x8c43
+#define GL_DEPTH24_STENCIL8 0x88f0
+#define GL_DEPTH_COMPONENT24 0x81a6
+#define GL_STENCIL_INDEX8 0x8d48
+#define GL_NEAREST 0x2600
+#define GL_MAX_SAMPLES 0x8d57
+
+typedef int GLsizei;
+
+// OpenGL function pointer typedefs for the framebuffer objects of headless
+// contexts
+typedef void (APIENTRY * PFN_glGenFramebuffers)(GLsizei,GLuint*);
+typedef void (APIENTRY * PFN_glDeleteFramebuffers)(GLsizei,const GLuint*);
+typedef void (APIENTRY * PFN_glBindFramebuffer)(GLenum,GLuint);
+typedef void (APIENTRY * PFN_glFramebufferRenderbuffer)(GLenum,GLenum,GLenum,GLuint);
+typedef GLenum (APIENTRY * PFN_glCheckFramebufferStatus)(GLenum);
+typedef void (APIENTRY * PFN_glGenRenderbuffers)(GLsizei,GLuint*);
+typedef void (APIENTRY * PFN_glDeleteRenderbuffers)(GLsizei,const GLuint*);
+typedef void (APIENTRY * PFN_glBindRenderbuffer)(GLenum,GLuint);
+typedef void (APIENTRY * PFN_glRenderbufferStorageMultisample)(GLenum,GLsizei,GLenum,GLsizei,GLsizei);
+typedef void (APIENTRY * PFN_glBlitFramebuffer)(GLint,GLint,GLint,GLint,GLint,GLint,GLint,GLint,GLbitfield,GLenum);
+typedef void (APIENTRY * PFN_glViewport)(GLint,GLint,GLsizei,GLsizei);
+typedef void (APIENTRY * PFN_glFlush)(void);
+#endif // _GLFW_EGL_HEADLESS
 
 #define _GLFW_EGL_CONTEXT_STATE            _GLFWcontextEGL egl
 #define _GLFW_EGL_LIBRARY_CONTEXT_STATE    _GLFWlibraryEGL egl
@@ -163,6 +212,34 @@ typedef struct _GLFWcontextEGL
 
    void*            client;
 
+#if defined(_GLFW_EGL_HEADLESS)
+   // Framebuffer objects standing in for the default framebuffer, with the
+   // back buffer first and the front buffer, if any, second
+   struct {
+       GLuint       framebuffers[2];
+       GLuint       colorbuffers[2];
+       GLuint       depthStencil;
+       int          count;
+       int          width, height;
+       GLenum       colorFormat;
+       GLenum       depthStencilFormat;
+       int          samples;
+       PFN_glGenFramebuffers                 GenFramebuffers;
+       PFN_glDeleteFramebuffers              DeleteFramebuffers;
+       PFN_glBindFramebuffer                 BindFramebuffer;
+       PFN_glFramebufferRenderbuffer         FramebufferRenderbuffer;
+       PFN_glCheckFramebufferStatus          CheckFramebufferStatus;
+       PFN_glGenRenderbuffers                GenRenderbuffers;
+       PFN_glDeleteRenderbuffers             DeleteRenderbuffers;
+       PFN_glBindRenderbuffer                BindRenderbuffer;
+       PFN_glRenderbufferStorageMultisample  RenderbufferStorageMultisample;
+       PFN_glBlitFramebuffer                 BlitFramebuffer;
+       PFNGLGETINTEGERVPROC                  GetIntegerv;
+       PFN_glViewport                        Viewport;
+       PFN_glFlush                           Flush;
+   } fbo;
+#endif // _GLFW_EGL_HEADLESS
+
 } _GLFWcontextEGL;
 
 // EGL-specific global data
@@ -178,6 +255,7 @@ typedef struct _GLFWlibraryEGL
     GLFWbool        KHR_gl_colorspace;
     GLFWbool        KHR_get_all_proc_addresses;
     GLFWbool        KHR_context_flush_control;
+    GLFWbool        KHR_surfaceless_context;
 
     void*           handle;
 
@@ -197,6 +275,17 @@ typedef struct _GLFWlibraryEGL
     PFN_eglSwapInterval         SwapInterval;
     PFN_eglQueryString          QueryString;
     PFN_eglGetProcAddress       GetProcAddress;
+    PFN_eglCreatePbufferSurface CreatePbufferSurface;
+
+    // Entry point caches for OpenGL, OpenGL ES 1.x and OpenGL ES 2.0+, as
+    // these are resolved from different client libraries, and the references
+    // keeping those libraries loaded while their entry points are cached
+    _GLFWproccache  procs[3];
+    void*           clients[3];
+    // Translated EGLConfigs for the same three client APIs, without and with
+    // transparency information, as that is only looked up when requested,
+    // followed by the pbuffer EGLConfigs for windowless contexts
+    _GLFWfbconfigcache* fbconfigs[3][3];
 
 } _GLFWlibraryEGL;
 
@@ -47,17 +47,22 @@ static int getGLXFBConfigAttrib(GLXFBConfig fbconfig, int attrib)
     return value;
 }
 
-// Return the GLXFBConfig most closely matching the specified hints
+// Returns the usable GLXFBConfigs translated to GLFW form, enumerating them the
+// first time
 //
-static GLFWbool chooseGLXFBConfig(const _GLFWfbconfig* desired,
-                                  GLXFBConfig* result)
+static _GLFWfbconfigcache* getGLXFBConfigs(GLFWbool transparent,
+                                           GLFWbool windowless)
 {
     GLXFBConfig* nativeConfigs;
     _GLFWfbconfig* usableConfigs;
-    const _GLFWfbconfig* closest;
     int i, nativeCount, usableCount;
     const char* vendor;
     GLFWbool trustWindowBit = GLFW_TRUE;
+    // A windowless context has no framebuffer to be transparent
+    const int index = windowless ? 2 : transparent;
+
+    if (_glfw.glx.fbconfigs[index])
+        return _glfw.glx.fbconfigs[index];
 
     // HACK: This is a (hopefully temporary) workaround for Chromium
     //       (VirtualBox GL) not setting the window bit on any GLXFBConfigs
@@ -70,7 +75,7 @@ static GLFWbool chooseGLXFBConfig(const _GLFWfbconfig* desired,
     if (!nativeConfigs || !nativeCount)
     {
         _glfwInputError(GLFW_API_UNAVAILABLE, "GLX: No GLXFBConfigs returned");
-        return GLFW_FALSE;
+        return NULL;
     }
 
     usableConfigs = calloc(nativeCount, sizeof(_GLFWfbconfig));
@@ -85,14 +90,23 @@ static GLFWbool chooseGLXFBConfig(const _GLFWfbconfig* desired,
         if (!(getGLXFBConfigAttrib(n, GLX_RENDER_TYPE) & GLX_RGBA_BIT))
             continue;
 
-        // Only consider window GLXFBConfigs
-        if (!(getGLXFBConfigAttrib(n, GLX_DRAWABLE_TYPE) & GLX_WINDOW_BIT))
+        if (windowless)
         {
-            if (trustWindowBit)
+            // Only consider GLXFBConfigs the pbuffer can be created with
+            if (!(getGLXFBConfigAttrib(n, GLX_DRAWABLE_TYPE) & GLX_PBUFFER_BIT))
                 continue;
         }
+        else
+        {
+            // Only consider window GLXFBConfigs
+            if (!(getGLXFBConfigAttrib(n, GLX_DRAWABLE_TYPE) & GLX_WINDOW_BIT))
+            {
+                if (trustWindowBit)
+                    continue;
+            }
+        }
 
-        if (desired->transparent)
+        if (transparent && !windowless)
         {
             XVisualInfo* vi = glXGetVisualFromFBConfig(_glfw.x11.display, n);
             if (vi)
@@ -132,13 +146,29 @@ static GLFWbool chooseGLXFBConfig(const _GLFWfbconfig* desired,
         usableCount++;
     }
 
-    closest = _glfwChooseFBConfig(desired, usableConfigs, usableCount);
+    XFree(nativeConfigs);
+
+    _glfw.glx.fbconfigs[index] =
+        _glfwCreateFBConfigCache(usableConfigs, usableCount);
+    return _glfw.glx.fbconfigs[index];
+}
+
+// Return the GLXFBConfig most closely matching the specified hints
+//
+static GLFWbool chooseGLXFBConfig(const _GLFWfbconfig* desired,
+                                  GLFWbool windowless,
+                                  GLXFBConfig* result)
+{
+    const _GLFWfbconfig* closest;
+    _GLFWfbconfigcache* cache =
+        getGLXFBConfigs(desired->transparent, windowless);
+    if (!cache)
+        return GLFW_FALSE;
+
+    closest = _glfwChooseCachedFBConfig(cache, desired);
     if (closest)
         *result = (GLXFBConfig) closest->handle;
 
-    XFree(nativeConfigs);
-    free(usableConfigs);
-
     return closest != NULL;
 }
 
@@ -159,8 +189,12 @@ static void makeContextCurrentGLX(_GLFWwindow* window)
 {
     if (window)
     {
+        GLXDrawable drawable = window->context.glx.window;
+        if (window->windowless)
+            drawable = window->context.glx.pbuffer;
+
         if (!glXMakeCurrent(_glfw.x11.display,
-                            window->context.glx.window,
+                            drawable,
                             window->context.glx.handle))
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -205,6 +239,11 @@ static void swapIntervalGLX(int interval)
     }
 }
 
+static const char* getExtensionsGLX(void)
+{
+    return glXQueryExtensionsString(_glfw.x11.display, _glfw.x11.screen);
+}
+
 static int extensionSupportedGLX(const char* extension)
 {
     const char* extensions =
@@ -228,6 +267,41 @@ static GLFWglproc getProcAddressGLX(const char* procname)
         return _glfw_dlsym(_glfw.glx.handle, procname);
 }
 
+static GLFWbool getPresentationGLX(_GLFWwindow* window,
+                                   uint64_t* swap, uint64_t* time,
+                                   int64_t* ust, int64_t* msc)
+{
+    int64_t sbc;
+
+    if (!_glfw.glx.GetSyncValuesOML(_glfw.x11.display,
+                                    window->context.glx.window,
+                                    ust, msc, &sbc) || sbc <= 0)
+    {
+        return GLFW_FALSE;
+    }
+
+    // The values above are those of the latest vertical retrace, but waiting
+    // for a swap that has already completed returns those of its completion
+    // without blocking
+    if (!_glfw.glx.WaitForSbcOML(_glfw.x11.display,
+                                 window->context.glx.window,
+                                 sbc, ust, msc, &sbc))
+    {
+        return GLFW_FALSE;
+    }
+
+    *swap = (uint64_t) sbc;
+
+    // UST is in microseconds of CLOCK_MONOTONIC on the implementations that
+    // document it, which is also the clock of the GLFW timer when available
+    if (_glfw.timer.posix.monotonic && *ust > 0)
+        *time = (uint64_t) *ust * 1000;
+    else
+        *time = 0;
+
+    return GLFW_TRUE;
+}
+
 static void destroyContextGLX(_GLFWwindow* window)
 {
     if (window->context.glx.window)
@@ -236,6 +310,12 @@ static void destroyContextGLX(_GLFWwindow* window)
         window->context.glx.window = None;
     }
 
+    if (window->context.glx.pbuffer)
+    {
+        glXDestroyPbuffer(_glfw.x11.display, window->context.glx.pbuffer);
+        window->context.glx.pbuffer = None;
+    }
+
     if (window->context.glx.handle)
     {
         glXDestroyContext(_glfw.x11.display, window->context.glx.handle);
@@ -306,6 +386,10 @@ GLFWbool _glfwInitGLX(void)
         _glfw_dlsym(_glfw.glx.handle, "glXCreateWindow");
     _glfw.glx.DestroyWindow =
         _glfw_dlsym(_glfw.glx.handle, "glXDestroyWindow");
+    _glfw.glx.CreatePbuffer =
+        _glfw_dlsym(_glfw.glx.handle, "glXCreatePbuffer");
+    _glfw.glx.DestroyPbuffer =
+        _glfw_dlsym(_glfw.glx.handle, "glXDestroyPbuffer");
     _glfw.glx.GetProcAddress =
         _glfw_dlsym(_glfw.glx.handle, "glXGetProcAddress");
     _glfw.glx.GetProcAddressARB =
@@ -325,6 +409,8 @@ GLFWbool _glfwInitGLX(void)
         !_glfw.glx.CreateNewContext ||
         !_glfw.glx.CreateWindow ||
         !_glfw.glx.DestroyWindow ||
+        !_glfw.glx.CreatePbuffer ||
+        !_glfw.glx.DestroyPbuffer ||
         !_glfw.glx.GetProcAddress ||
         !_glfw.glx.GetProcAddressARB ||
         !_glfw.glx.GetVisualFromFBConfig)
@@ -383,6 +469,17 @@ GLFWbool _glfwInitGLX(void)
             _glfw.glx.MESA_swap_control = GLFW_TRUE;
     }
 
+    if (extensionSupportedGLX("GLX_OML_sync_control"))
+    {
+        _glfw.glx.GetSyncValuesOML = (PFNGLXGETSYNCVALUESOMLPROC)
+            getProcAddressGLX("glXGetSyncValuesOML");
+        _glfw.glx.WaitForSbcOML = (PFNGLXWAITFORSBCOMLPROC)
+            getProcAddressGLX("glXWaitForSbcOML");
+
+        if (_glfw.glx.GetSyncValuesOML && _glfw.glx.WaitForSbcOML)
+            _glfw.glx.OML_sync_control = GLFW_TRUE;
+    }
+
     if (extensionSupportedGLX("GLX_ARB_multisample"))
         _glfw.glx.ARB_multisample = GLFW_TRUE;
 
@@ -423,9 +520,19 @@ GLFWbool _glfwInitGLX(void)
 //
 void _glfwTerminateGLX(void)
 {
+    int i;
+
     // NOTE: This function must not call any X11 functions, as it is called
     //       after XCloseDisplay (see _glfwPlatformTerminate for details)
 
+    _glfwFreeProcCache(&_glfw.glx.procs);
+
+    for (i = 0;  i < 3;  i++)
+    {
+        _glfwFreeFBConfigCache(_glfw.glx.fbconfigs[i]);
+        _glfw.glx.fbconfigs[i] = NULL;
+    }
+
     if (_glfw.glx.handle)
     {
         _glfw_dlclose(_glfw.glx.handle);
@@ -453,7 +560,7 @@ GLFWbool _glfwCreateContextGLX(_GLFWwindow* window,
     if (ctxconfig->share)
         share = ctxconfig->share->context.glx.handle;
 
-    if (!chooseGLXFBConfig(fbconfig, &native))
+    if (!chooseGLXFBConfig(fbconfig, window->windowless, &native))
     {
         _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
                         "GLX: Failed to find a suitable GLXFBConfig");
@@ -611,21 +718,42 @@ GLFWbool _glfwCreateContextGLX(_GLFWwindow* window,
         return GLFW_FALSE;
     }
 
-    window->context.glx.window =
-        glXCreateWindow(_glfw.x11.display, native, window->x11.handle, NULL);
-    if (!window->context.glx.window)
+    if (window->windowless)
     {
-        _glfwInputError(GLFW_PLATFORM_ERROR, "GLX: Failed to create window");
-        return GLFW_FALSE;
+        // GLX has no surfaceless contexts, so a windowless context is made
+        // current with the smallest pbuffer its GLXFBConfig allows
+        const int attribs[] = { GLX_PBUFFER_WIDTH, 1, GLX_PBUFFER_HEIGHT, 1, None };
+
+        window->context.glx.pbuffer =
+            glXCreatePbuffer(_glfw.x11.display, native, attribs);
+        if (!window->context.glx.pbuffer)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR, "GLX: Failed to create pbuffer");
+            return GLFW_FALSE;
+        }
+    }
+    else
+    {
+        window->context.glx.window =
+            glXCreateWindow(_glfw.x11.display, native, window->x11.handle, NULL);
+        if (!window->context.glx.window)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR, "GLX: Failed to create window");
+            return GLFW_FALSE;
+        }
     }
 
     window->context.makeCurrent = makeContextCurrentGLX;
     window->context.swapBuffers = swapBuffersGLX;
     window->context.swapInterval = swapIntervalGLX;
-    window->context.extensionSupported = extensionSupportedGLX;
+    window->context.getExtensions = getExtensionsGLX;
     window->context.getProcAddress = getProcAddressGLX;
+    window->context.procCache = &_glfw.glx.procs;
     window->context.destroy = destroyContextGLX;
 
+    if (_glfw.glx.OML_sync_control && !window->windowless)
+        window->context.getPresentation = getPresentationGLX;
+
     return GLFW_TRUE;
 }
 
@@ -641,7 +769,7 @@ GLFWbool _glfwChooseVisualGLX(const _GLFWwndconfig* wndconfig,
     GLXFBConfig native;
     XVisualInfo* result;
 
-    if (!chooseGLXFBConfig(fbconfig, &native))
+    if (!chooseGLXFBConfig(fbconfig, GLFW_FALSE, &native))
     {
         _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
                         "GLX: Failed to find a suitable GLXFBConfig");
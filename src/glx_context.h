@@ -28,6 +28,7 @@
 #define GLX_VENDOR 1
 #define GLX_RGBA_BIT 0x00000001
 #define GLX_WINDOW_BIT 0x00000001
+#define GLX_PBUFFER_BIT 0x00000004
 #define GLX_DRAWABLE_TYPE 0x8010
 #define GLX_RENDER_TYPE 0x8011
 #define GLX_RGBA_TYPE 0x8014
@@ -65,9 +66,12 @@
 #define GLX_CONTEXT_RELEASE_BEHAVIOR_NONE_ARB 0
 #define GLX_CONTEXT_RELEASE_BEHAVIOR_FLUSH_ARB 0x2098
 #define GLX_CONTEXT_OPENGL_NO_ERROR_ARB 0x31b3
+#define GLX_PBUFFER_HEIGHT 0x8040
+#define GLX_PBUFFER_WIDTH 0x8041
 
 typedef XID GLXWindow;
 typedef XID GLXDrawable;
+typedef XID GLXPbuffer;
 typedef struct __GLXFBConfig* GLXFBConfig;
 typedef struct __GLXcontext* GLXContext;
 typedef void (*__GLXextproc)(void);
@@ -87,9 +91,13 @@ typedef void (*PFNGLXSWAPINTERVALEXTPROC)(Display*,GLXDrawable,int);
 typedef XVisualInfo* (*PFNGLXGETVISUALFROMFBCONFIGPROC)(Display*,GLXFBConfig);
 typedef GLXWindow (*PFNGLXCREATEWINDOWPROC)(Display*,GLXFBConfig,Window,const int*);
 typedef void (*PFNGLXDESTROYWINDOWPROC)(Display*,GLXWindow);
+typedef GLXPbuffer (*PFNGLXCREATEPBUFFERPROC)(Display*,GLXFBConfig,const int*);
+typedef void (*PFNGLXDESTROYPBUFFERPROC)(Display*,GLXPbuffer);
 
 typedef int (*PFNGLXSWAPINTERVALMESAPROC)(int);
 typedef int (*PFNGLXSWAPINTERVALSGIPROC)(int);
+typedef Bool (*PFNGLXGETSYNCVALUESOMLPROC)(Display*,GLXDrawable,int64_t*,int64_t*,int64_t*);
+typedef Bool (*PFNGLXWAITFORSBCOMLPROC)(Display*,GLXDrawable,int64_t,int64_t*,int64_t*,int64_t*);
 typedef GLXContext (*PFNGLXCREATECONTEXTATTRIBSARBPROC)(Display*,GLXFBConfig,GLXContext,Bool,const int*);
 
 // libGL.so function pointer typedefs
@@ -106,6 +114,8 @@ typedef GLXContext (*PFNGLXCREATECONTEXTATTRIBSARBPROC)(Display*,GLXFBConfig,GLX
 #define glXGetVisualFromFBConfig _glfw.glx.GetVisualFromFBConfig
 #define glXCreateWindow _glfw.glx.CreateWindow
 #define glXDestroyWindow _glfw.glx.DestroyWindow
+#define glXCreatePbuffer _glfw.glx.CreatePbuffer
+#define glXDestroyPbuffer _glfw.glx.DestroyPbuffer
 
 #define _GLFW_PLATFORM_CONTEXT_STATE            _GLFWcontextGLX glx
 #define _GLFW_PLATFORM_LIBRARY_CONTEXT_STATE    _GLFWlibraryGLX glx
@@ -117,6 +127,7 @@ typedef struct _GLFWcontextGLX
 {
     GLXContext      handle;
     GLXWindow       window;
+    GLXPbuffer      pbuffer;
 
 } _GLFWcontextGLX;
 
@@ -145,6 +156,8 @@ typedef struct _GLFWlibraryGLX
     PFNGLXGETVISUALFROMFBCONFIGPROC     GetVisualFromFBConfig;
     PFNGLXCREATEWINDOWPROC              CreateWindow;
     PFNGLXDESTROYWINDOWPROC             DestroyWindow;
+    PFNGLXCREATEPBUFFERPROC             CreatePbuffer;
+    PFNGLXDESTROYPBUFFERPROC            DestroyPbuffer;
 
     // GLX 1.4 and extension functions
     PFNGLXGETPROCADDRESSPROC            GetProcAddress;
@@ -152,10 +165,13 @@ typedef struct _GLFWlibraryGLX
     PFNGLXSWAPINTERVALSGIPROC           SwapIntervalSGI;
     PFNGLXSWAPINTERVALEXTPROC           SwapIntervalEXT;
     PFNGLXSWAPINTERVALMESAPROC          SwapIntervalMESA;
+    PFNGLXGETSYNCVALUESOMLPROC          GetSyncValuesOML;
+    PFNGLXWAITFORSBCOMLPROC             WaitForSbcOML;
     PFNGLXCREATECONTEXTATTRIBSARBPROC   CreateContextAttribsARB;
     GLFWbool        SGI_swap_control;
     GLFWbool        EXT_swap_control;
     GLFWbool        MESA_swap_control;
+    GLFWbool        OML_sync_control;
     GLFWbool        ARB_multisample;
     GLFWbool        ARB_framebuffer_sRGB;
     GLFWbool        EXT_framebuffer_sRGB;
@@ -166,6 +182,12 @@ typedef struct _GLFWlibraryGLX
     GLFWbool        ARB_create_context_no_error;
     GLFWbool        ARB_context_flush_control;
 
+    _GLFWproccache  procs;
+    // Translated window GLXFBConfigs without and with transparency
+    // information, as that is only looked up when a transparent framebuffer is
+    // requested, followed by the pbuffer GLXFBConfigs for windowless contexts
+    _GLFWfbconfigcache* fbconfigs[3];
+
 } _GLFWlibraryGLX;
 
 GLFWbool _glfwInitGLX(void);
@@ -28,7 +28,6 @@
 //========================================================================
 
 #include "internal.h"
-#include "mappings.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -67,6 +66,8 @@ static void terminate(void)
 
     memset(&_glfw.callbacks, 0, sizeof(_glfw.callbacks));
 
+    _glfwCloseInputLog();
+
     while (_glfw.windowListHead)
         glfwDestroyWindow((GLFWwindow*) _glfw.windowListHead);
 
@@ -88,6 +89,11 @@ static void terminate(void)
     free(_glfw.mappings);
     _glfw.mappings = NULL;
     _glfw.mappingCount = 0;
+    free(_glfw.mappingIndex);
+    _glfw.mappingIndex = NULL;
+
+    for (i = 0;  i <= GLFW_JOYSTICK_LAST;  i++)
+        free(_glfw.joystickEvents[i].events);
 
     _glfwTerminateVulkan();
     _glfwPlatformTerminate();
@@ -104,6 +110,8 @@ static void terminate(void)
     _glfwPlatformDestroyTls(&_glfw.contextSlot);
     _glfwPlatformDestroyTls(&_glfw.errorSlot);
     _glfwPlatformDestroyMutex(&_glfw.errorLock);
+    _glfwPlatformDestroyMutex(&_glfw.procCacheLock);
+    _glfwPlatformDestroyMutex(&_glfw.windowLock);
 
     memset(&_glfw, 0, sizeof(_glfw));
 }
@@ -113,6 +121,187 @@ static void terminate(void)
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
 
+// Encode a Unicode code point to a UTF-8 stream
+// Based on cutef8 by Jeff Bezanson (Public Domain)
+//
+size_t _glfwEncodeUTF8(char* s, unsigned int codepoint)
+{
+    size_t count = 0;
+
+    if (codepoint < 0x80)
+        s[count++] = (char) codepoint;
+    else if (codepoint < 0x800)
+    {
+        s[count++] = (codepoint >> 6) | 0xc0;
+        s[count++] = (codepoint & 0x3f) | 0x80;
+    }
+    else if (codepoint < 0x10000)
+    {
+        s[count++] = (codepoint >> 12) | 0xe0;
+        s[count++] = ((codepoint >> 6) & 0x3f) | 0x80;
+        s[count++] = (codepoint & 0x3f) | 0x80;
+    }
+    else if (codepoint < 0x110000)
+    {
+        s[count++] = (codepoint >> 18) | 0xf0;
+        s[count++] = ((codepoint >> 12) & 0x3f) | 0x80;
+        s[count++] = ((codepoint >> 6) & 0x3f) | 0x80;
+        s[count++] = (codepoint & 0x3f) | 0x80;
+    }
+
+    return count;
+}
+
+// Decode a Unicode code point from a UTF-8 stream
+// Based on cutef8 by Jeff Bezanson (Public Domain)
+// Sequences longer than six bytes are skipped and decoded as U+FFFD, as the
+// text may come from an untrusted source such as a replayed input log
+//
+unsigned int _glfwDecodeUTF8(const char** s)
+{
+    unsigned int codepoint = 0, count = 0;
+    static const unsigned int offsets[] =
+    {
+        0x00000000u, 0x00003080u, 0x000e2080u,
+        0x03c82080u, 0xfa082080u, 0x82082080u
+    };
+
+    do
+    {
+        if (count == 6)
+        {
+            while ((**s & 0xc0) == 0x80)
+                (*s)++;
+
+            return 0xfffd;
+        }
+
+        codepoint = (codepoint << 6) + (unsigned char) **s;
+        (*s)++;
+        count++;
+    } while ((**s & 0xc0) == 0x80);
+
+    return codepoint - offsets[count - 1];
+}
+
+// Returns the histogram bucket of the specified value
+//
+static int histogramBucket(uint32_t value)
+{
+    int exponent = _GLFW_HISTOGRAM_SUB_BITS;
+
+    if (value < (1u << _GLFW_HISTOGRAM_SUB_BITS))
+        return (int) value;
+
+    while (exponent < 31 && (value >> (exponent + 1)))
+        exponent++;
+
+    return ((exponent - _GLFW_HISTOGRAM_SUB_BITS + 1) << _GLFW_HISTOGRAM_SUB_BITS) +
+           (int) ((value >> (exponent - _GLFW_HISTOGRAM_SUB_BITS)) &
+                  ((1u << _GLFW_HISTOGRAM_SUB_BITS) - 1));
+}
+
+// Returns the midpoint of the values covered by the specified bucket
+//
+static uint32_t histogramMidpoint(int bucket)
+{
+    int shift;
+    uint32_t lower;
+
+    if (bucket < (1 << _GLFW_HISTOGRAM_SUB_BITS))
+        return (uint32_t) bucket;
+
+    shift = (bucket >> _GLFW_HISTOGRAM_SUB_BITS) - 1;
+    lower = ((1u << _GLFW_HISTOGRAM_SUB_BITS) +
+             (bucket & ((1 << _GLFW_HISTOGRAM_SUB_BITS) - 1))) << shift;
+    return lower + ((1u << shift) >> 1);
+}
+
+// Returns the FNV-1a hash of the specified bytes
+//
+uint32_t _glfwHashBytes(const void* data, size_t size)
+{
+    size_t i;
+    const unsigned char* bytes = data;
+    uint32_t hash = 2166136261u;
+
+    for (i = 0;  i < size;  i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+// Returns the FNV-1a hash of the specified string, without its terminator
+//
+uint32_t _glfwHashString(const char* string)
+{
+    return _glfwHashBytes(string, strlen(string));
+}
+
+// Adds a sample to the histogram, clamping it to 32 bits
+//
+void _glfwHistogramAdd(_GLFWhistogram* histogram, uint64_t value)
+{
+    const uint32_t sample = value > 0xffffffffu ? 0xffffffffu : (uint32_t) value;
+
+    if (histogram->count == 0xffffffffu)
+        return;
+
+    histogram->buckets[histogramBucket(sample)]++;
+    histogram->count++;
+    histogram->sum += sample;
+    if (sample > histogram->max)
+        histogram->max = sample;
+}
+
+// Returns the approximate value below which the specified fraction of the
+// samples fall
+//
+uint32_t _glfwHistogramPercentile(const _GLFWhistogram* histogram,
+                                  double fraction)
+{
+    int i;
+    uint64_t seen = 0, target;
+
+    if (!histogram->count)
+        return 0;
+
+    target = (uint64_t) (fraction * histogram->count + 0.5);
+    if (target < 1)
+        target = 1;
+
+    for (i = 0;  i < _GLFW_HISTOGRAM_BUCKETS;  i++)
+    {
+        seen += histogram->buckets[i];
+        if (seen >= target)
+        {
+            const uint32_t value = histogramMidpoint(i);
+            return value < histogram->max ? value : histogram->max;
+        }
+    }
+
+    return histogram->max;
+}
+
+// Retrieves the sample count, mean, median, 95th and 99th percentiles and
+// maximum of a histogram with samples in microseconds, converted to seconds
+//
+void _glfwHistogramSummary(const _GLFWhistogram* histogram,
+                           unsigned int* count, double* mean,
+                           double* p50, double* p95, double* p99, double* max)
+{
+    *count = histogram->count;
+    *mean = histogram->count ?
+        (double) histogram->sum / histogram->count / 1e6 : 0.0;
+    *p50 = _glfwHistogramPercentile(histogram, 0.50) / 1e6;
+    *p95 = _glfwHistogramPercentile(histogram, 0.95) / 1e6;
+    *p99 = _glfwHistogramPercentile(histogram, 0.99) / 1e6;
+    *max = histogram->max / 1e6;
+}
+
 char* _glfw_strdup(const char* source)
 {
     const size_t length = strlen(source);
@@ -238,6 +427,8 @@ GLFWAPI int glfwInit(void)
     }
 
     if (!_glfwPlatformCreateMutex(&_glfw.errorLock) ||
+        !_glfwPlatformCreateMutex(&_glfw.procCacheLock) ||
+        !_glfwPlatformCreateMutex(&_glfw.windowLock) ||
         !_glfwPlatformCreateTls(&_glfw.errorSlot) ||
         !_glfwPlatformCreateTls(&_glfw.contextSlot))
     {
@@ -251,20 +442,6 @@ GLFWAPI int glfwInit(void)
     _glfw.timer.offset = _glfwPlatformGetTimerValue();
 
     glfwDefaultWindowHints();
-
-    {
-        int i;
-
-        for (i = 0;  _glfwDefaultMappings[i];  i++)
-        {
-            if (!glfwUpdateGamepadMappings(_glfwDefaultMappings[i]))
-            {
-                terminate();
-                return GLFW_FALSE;
-            }
-        }
-    }
-
     return GLFW_TRUE;
 }
 
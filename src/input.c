@@ -28,6 +28,7 @@
 //========================================================================
 
 #include "internal.h"
+#include "mappings.h"
 
 #include <assert.h>
 #include <float.h>
@@ -43,21 +44,86 @@
 #define _GLFW_JOYSTICK_BUTTON   2
 #define _GLFW_JOYSTICK_HATBIT   3
 
-// Finds a mapping based on joystick GUID
+// Inserts the specified mapping into the GUID index, which must have room
+//
+static void indexMapping(int index)
+{
+    const uint32_t mask = (uint32_t) _glfw.mappingIndexSize - 1;
+    uint32_t slot = _glfwHashString(_glfw.mappings[index].guid) & mask;
+
+    while (_glfw.mappingIndex[slot])
+        slot = (slot + 1) & mask;
+
+    _glfw.mappingIndex[slot] = index + 1;
+}
+
+// Finds a mapping added at run-time based on joystick GUID
 //
 static _GLFWmapping* findMapping(const char* guid)
 {
-    int i;
+    uint32_t mask, slot;
+
+    if (!_glfw.mappingIndexSize)
+        return NULL;
+
+    mask = (uint32_t) _glfw.mappingIndexSize - 1;
 
-    for (i = 0;  i < _glfw.mappingCount;  i++)
+    for (slot = _glfwHashString(guid) & mask;
+         _glfw.mappingIndex[slot];
+         slot = (slot + 1) & mask)
     {
-        if (strcmp(_glfw.mappings[i].guid, guid) == 0)
-            return _glfw.mappings + i;
+        _GLFWmapping* mapping = _glfw.mappings + _glfw.mappingIndex[slot] - 1;
+        if (strcmp(mapping->guid, guid) == 0)
+            return mapping;
     }
 
     return NULL;
 }
 
+// Appends a mapping to the list and the GUID index, growing both as needed
+//
+static GLFWbool addMapping(const _GLFWmapping* mapping)
+{
+    if (_glfw.mappingCount == _glfw.mappingCapacity)
+    {
+        const int capacity = _glfw.mappingCapacity ? _glfw.mappingCapacity * 2 : 256;
+        _GLFWmapping* mappings =
+            realloc(_glfw.mappings, sizeof(_GLFWmapping) * capacity);
+        if (!mappings)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return GLFW_FALSE;
+        }
+
+        _glfw.mappings = mappings;
+        _glfw.mappingCapacity = capacity;
+    }
+
+    if (_GLFW_HASH_TABLE_FULL(_glfw.mappingCount + 1, _glfw.mappingIndexSize))
+    {
+        int i;
+        const int size = _glfw.mappingIndexSize ? _glfw.mappingIndexSize * 2 : 512;
+        int* index = calloc(size, sizeof(int));
+        if (!index)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return GLFW_FALSE;
+        }
+
+        free(_glfw.mappingIndex);
+        _glfw.mappingIndex = index;
+        _glfw.mappingIndexSize = size;
+
+        for (i = 0;  i < _glfw.mappingCount;  i++)
+            indexMapping(i);
+    }
+
+    _glfw.mappings[_glfw.mappingCount] = *mapping;
+    indexMapping(_glfw.mappingCount);
+    _glfw.mappingCount++;
+    return GLFW_TRUE;
+}
+
 // Checks whether a gamepad mapping element is present in the hardware
 //
 static GLFWbool isValidElementForJoystick(const _GLFWmapelement* e,
@@ -73,11 +139,128 @@ static GLFWbool isValidElementForJoystick(const _GLFWmapelement* e,
     return GLFW_TRUE;
 }
 
-// Finds a mapping based on joystick GUID and verifies element indices
+// Finds a pre-parsed default mapping based on joystick GUID
+//
+static const _GLFWmapping* findDefaultMapping(const char* guid)
+{
+    size_t first = 0;
+    size_t last = sizeof(_glfwDefaultMappings) / sizeof(_glfwDefaultMappings[0]);
+
+    // The generated table is sorted by GUID
+    while (first < last)
+    {
+        const size_t middle = first + (last - first) / 2;
+        const int order = strcmp(_glfwDefaultMappings[middle].guid, guid);
+        if (order == 0)
+            return _glfwDefaultMappings + middle;
+        else if (order < 0)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    return NULL;
+}
+
+// Returns the specified element of a gamepad mapping, in transform order
+//
+static const _GLFWmapelement* getMappingElement(const _GLFWmapping* mapping,
+                                                int index)
+{
+    if (index <= GLFW_GAMEPAD_BUTTON_LAST)
+        return mapping->buttons + index;
+
+    index -= GLFW_GAMEPAD_BUTTON_LAST + 1;
+    return &mapping->axes[index / 2][index % 2];
+}
+
+// Compiles a gamepad mapping into a transform for the specified joystick
+//
+static void compileMapping(_GLFWmaptransform* t, const _GLFWmapping* mapping)
+{
+    int i;
+
+    memset(t, 0, sizeof(_GLFWmaptransform));
+
+    for (i = 0;  i < _GLFW_MAPPING_ELEMENTS;  i++)
+    {
+        const _GLFWmapelement* e = getMappingElement(mapping, i);
+
+        if (e->type == _GLFW_JOYSTICK_AXIS)
+        {
+            t->axisIndices[t->axisCount] = e->index;
+            t->axisElements[t->axisCount] = (uint8_t) i;
+            t->axisCount++;
+        }
+        else if (e->type == _GLFW_JOYSTICK_BUTTON)
+        {
+            t->buttonIndices[t->buttonCount] = e->index;
+            t->buttonElements[t->buttonCount] = (uint8_t) i;
+            t->buttonCount++;
+        }
+        else if (e->type == _GLFW_JOYSTICK_HATBIT)
+        {
+            t->hatIndices[t->hatCount] = e->index >> 4;
+            t->hatBits[t->hatCount] = e->index & 0xf;
+            t->hatElements[t->hatCount] = (uint8_t) i;
+            t->hatCount++;
+        }
+
+        // Unmapped elements have an empty output range and are always zero
+        t->scale[i] = e->scale;
+        t->offset[i] = e->offset;
+        t->minimum[i] = e->minimum;
+        t->maximum[i] = e->maximum;
+    }
+}
+
+// Evaluates the compiled gamepad mapping of the specified joystick
+//
+static void evaluateMapping(const _GLFWjoystick* js, GLFWgamepadstate* state)
+{
+    const _GLFWmaptransform* t = &js->transform;
+    float values[_GLFW_MAPPING_ELEMENTS] = { 0.f };
+    int i;
+
+    for (i = 0;  i < t->axisCount;  i++)
+        values[t->axisElements[i]] = js->axes[t->axisIndices[i]];
+
+    // Buttons and hat bits are gathered as zero or one
+    for (i = 0;  i < t->buttonCount;  i++)
+        values[t->buttonElements[i]] = js->buttons[t->buttonIndices[i]];
+
+    for (i = 0;  i < t->hatCount;  i++)
+        values[t->hatElements[i]] = (js->hats[t->hatIndices[i]] & t->hatBits[i]) != 0;
+
+    for (i = 0;  i < _GLFW_MAPPING_ELEMENTS;  i++)
+    {
+        const float value = values[i] * t->scale[i] + t->offset[i];
+        values[i] = value < t->minimum[i] ? t->minimum[i] :
+                    (value > t->maximum[i] ? t->maximum[i] : value);
+    }
+
+    // Gamepad buttons have an output range of zero to one
+    for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
+        state->buttons[i] = values[i] >= 0.5f;
+
+    for (i = 0;  i <= GLFW_GAMEPAD_AXIS_LAST;  i++)
+    {
+        const float* halves = values + GLFW_GAMEPAD_BUTTON_LAST + 1 + i * 2;
+        const float value = halves[0] + halves[1];
+        state->axes[i] = value < -1.f ? -1.f : (value > 1.f ? 1.f : value);
+    }
+}
+
+// Finds a mapping based on joystick GUID, verifies element indices and
+// compiles it for the joystick
+// Mappings added at run-time take precedence over the default ones
 //
-static _GLFWmapping* findValidMapping(const _GLFWjoystick* js)
+static const _GLFWmapping* findValidMapping(_GLFWjoystick* js)
 {
-    _GLFWmapping* mapping = findMapping(js->guid);
+    const _GLFWmapping* mapping = findMapping(js->guid);
+    if (!mapping)
+        mapping = findDefaultMapping(js->guid);
+
     if (mapping)
     {
         int i;
@@ -94,9 +277,9 @@ static _GLFWmapping* findValidMapping(const _GLFWjoystick* js)
             }
         }
 
-        for (i = 0;  i <= GLFW_GAMEPAD_AXIS_LAST;  i++)
+        for (i = 0;  i < (GLFW_GAMEPAD_AXIS_LAST + 1) * 2;  i++)
         {
-            if (!isValidElementForJoystick(mapping->axes + i, js))
+            if (!isValidElementForJoystick(&mapping->axes[i / 2][i % 2], js))
             {
                 _glfwInputError(GLFW_INVALID_VALUE,
                                 "Invalid axis in gamepad mapping %s (%s)",
@@ -105,6 +288,8 @@ static _GLFWmapping* findValidMapping(const _GLFWjoystick* js)
                 return NULL;
             }
         }
+
+        compileMapping(&js->transform, mapping);
     }
 
     return mapping;
@@ -120,30 +305,31 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
     {
         const char* name;
         _GLFWmapelement* element;
+        GLFWbool axis;
     } fields[] =
     {
-        { "platform",      NULL },
-        { "a",             mapping->buttons + GLFW_GAMEPAD_BUTTON_A },
-        { "b",             mapping->buttons + GLFW_GAMEPAD_BUTTON_B },
-        { "x",             mapping->buttons + GLFW_GAMEPAD_BUTTON_X },
-        { "y",             mapping->buttons + GLFW_GAMEPAD_BUTTON_Y },
-        { "back",          mapping->buttons + GLFW_GAMEPAD_BUTTON_BACK },
-        { "start",         mapping->buttons + GLFW_GAMEPAD_BUTTON_START },
-        { "guide",         mapping->buttons + GLFW_GAMEPAD_BUTTON_GUIDE },
-        { "leftshoulder",  mapping->buttons + GLFW_GAMEPAD_BUTTON_LEFT_BUMPER },
-        { "rightshoulder", mapping->buttons + GLFW_GAMEPAD_BUTTON_RIGHT_BUMPER },
-        { "leftstick",     mapping->buttons + GLFW_GAMEPAD_BUTTON_LEFT_THUMB },
-        { "rightstick",    mapping->buttons + GLFW_GAMEPAD_BUTTON_RIGHT_THUMB },
-        { "dpup",          mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_UP },
-        { "dpright",       mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_RIGHT },
-        { "dpdown",        mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_DOWN },
-        { "dpleft",        mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_LEFT },
-        { "lefttrigger",   mapping->axes + GLFW_GAMEPAD_AXIS_LEFT_TRIGGER },
-        { "righttrigger",  mapping->axes + GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER },
-        { "leftx",         mapping->axes + GLFW_GAMEPAD_AXIS_LEFT_X },
-        { "lefty",         mapping->axes + GLFW_GAMEPAD_AXIS_LEFT_Y },
-        { "rightx",        mapping->axes + GLFW_GAMEPAD_AXIS_RIGHT_X },
-        { "righty",        mapping->axes + GLFW_GAMEPAD_AXIS_RIGHT_Y }
+        { "platform",      NULL, GLFW_FALSE },
+        { "a",             mapping->buttons + GLFW_GAMEPAD_BUTTON_A, GLFW_FALSE },
+        { "b",             mapping->buttons + GLFW_GAMEPAD_BUTTON_B, GLFW_FALSE },
+        { "x",             mapping->buttons + GLFW_GAMEPAD_BUTTON_X, GLFW_FALSE },
+        { "y",             mapping->buttons + GLFW_GAMEPAD_BUTTON_Y, GLFW_FALSE },
+        { "back",          mapping->buttons + GLFW_GAMEPAD_BUTTON_BACK, GLFW_FALSE },
+        { "start",         mapping->buttons + GLFW_GAMEPAD_BUTTON_START, GLFW_FALSE },
+        { "guide",         mapping->buttons + GLFW_GAMEPAD_BUTTON_GUIDE, GLFW_FALSE },
+        { "leftshoulder",  mapping->buttons + GLFW_GAMEPAD_BUTTON_LEFT_BUMPER, GLFW_FALSE },
+        { "rightshoulder", mapping->buttons + GLFW_GAMEPAD_BUTTON_RIGHT_BUMPER, GLFW_FALSE },
+        { "leftstick",     mapping->buttons + GLFW_GAMEPAD_BUTTON_LEFT_THUMB, GLFW_FALSE },
+        { "rightstick",    mapping->buttons + GLFW_GAMEPAD_BUTTON_RIGHT_THUMB, GLFW_FALSE },
+        { "dpup",          mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_UP, GLFW_FALSE },
+        { "dpright",       mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_RIGHT, GLFW_FALSE },
+        { "dpdown",        mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_DOWN, GLFW_FALSE },
+        { "dpleft",        mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_LEFT, GLFW_FALSE },
+        { "lefttrigger",   mapping->axes[GLFW_GAMEPAD_AXIS_LEFT_TRIGGER], GLFW_TRUE },
+        { "righttrigger",  mapping->axes[GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER], GLFW_TRUE },
+        { "leftx",         mapping->axes[GLFW_GAMEPAD_AXIS_LEFT_X], GLFW_TRUE },
+        { "lefty",         mapping->axes[GLFW_GAMEPAD_AXIS_LEFT_Y], GLFW_TRUE },
+        { "rightx",        mapping->axes[GLFW_GAMEPAD_AXIS_RIGHT_X], GLFW_TRUE },
+        { "righty",        mapping->axes[GLFW_GAMEPAD_AXIS_RIGHT_Y], GLFW_TRUE }
     };
 
     length = strcspn(c, ",");
@@ -168,64 +354,114 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
 
     while (*c)
     {
-        // TODO: Implement output modifiers
-        if (*c == '+' || *c == '-')
-            return GLFW_FALSE;
+        // Output ranges go from the value for the start of the input range to
+        // the value for its end and may be limited to either half of the axis
+        int outputFrom = -1, outputTo = 1;
+
+        if (*c == '+')
+        {
+            outputFrom = 0;
+            c += 1;
+        }
+        else if (*c == '-')
+        {
+            outputFrom = 0;
+            outputTo = -1;
+            c += 1;
+        }
+
+        // Measure the key once instead of matching it against every field
+        length = strcspn(c, ":");
 
         for (i = 0;  i < sizeof(fields) / sizeof(fields[0]);  i++)
         {
-            length = strlen(fields[i].name);
-            if (strncmp(c, fields[i].name, length) != 0 || c[length] != ':')
+            if (c[length] != ':' ||
+                strncmp(c, fields[i].name, length) != 0 ||
+                fields[i].name[length] != '\0')
+            {
                 continue;
+            }
 
             c += length + 1;
 
             if (fields[i].element)
             {
-                _GLFWmapelement* e = fields[i].element;
-                int8_t minimum = -1;
-                int8_t maximum = 1;
+                _GLFWmapelement e = {0};
+                int inputFrom = -1, inputTo = 1;
 
                 if (*c == '+')
                 {
-                    minimum = 0;
+                    inputFrom = 0;
                     c += 1;
                 }
                 else if (*c == '-')
                 {
-                    maximum = 0;
+                    inputFrom = 0;
+                    inputTo = -1;
                     c += 1;
                 }
 
                 if (*c == 'a')
-                    e->type = _GLFW_JOYSTICK_AXIS;
+                    e.type = _GLFW_JOYSTICK_AXIS;
                 else if (*c == 'b')
-                    e->type = _GLFW_JOYSTICK_BUTTON;
+                    e.type = _GLFW_JOYSTICK_BUTTON;
                 else if (*c == 'h')
-                    e->type = _GLFW_JOYSTICK_HATBIT;
+                    e.type = _GLFW_JOYSTICK_HATBIT;
                 else
                     break;
 
-                if (e->type == _GLFW_JOYSTICK_HATBIT)
+                if (e.type == _GLFW_JOYSTICK_HATBIT)
                 {
                     const unsigned long hat = strtoul(c + 1, (char**) &c, 10);
                     const unsigned long bit = strtoul(c + 1, (char**) &c, 10);
-                    e->index = (uint8_t) ((hat << 4) | bit);
+                    e.index = (uint8_t) ((hat << 4) | bit);
                 }
                 else
-                    e->index = (uint8_t) strtoul(c + 1, (char**) &c, 10);
+                    e.index = (uint8_t) strtoul(c + 1, (char**) &c, 10);
 
-                if (e->type == _GLFW_JOYSTICK_AXIS)
+                if (e.type == _GLFW_JOYSTICK_AXIS)
                 {
-                    e->axisScale = 2 / (maximum - minimum);
-                    e->axisOffset = -(maximum + minimum);
-
                     if (*c == '~')
                     {
-                        e->axisScale = -e->axisScale;
-                        e->axisOffset = -e->axisOffset;
+                        const int from = inputFrom;
+                        inputFrom = inputTo;
+                        inputTo = from;
                     }
                 }
+                else
+                {
+                    // Buttons and hat bits go from zero to one
+                    inputFrom = 0;
+                    inputTo = 1;
+                }
+
+                // Gamepad buttons go from zero to one and are pressed when
+                // past the middle of the input range
+                if (!fields[i].axis)
+                {
+                    outputFrom = 0;
+                    outputTo = 1;
+                }
+
+                e.scale = (float) (outputTo - outputFrom) / (inputTo - inputFrom);
+                e.offset = outputFrom - inputFrom * e.scale;
+                e.minimum = (int8_t) (outputFrom < outputTo ? outputFrom : outputTo);
+                e.maximum = (int8_t) (outputFrom < outputTo ? outputTo : outputFrom);
+
+                if (fields[i].axis)
+                {
+                    // A full range replaces both halves of the gamepad axis
+                    if (outputTo == -1)
+                        fields[i].element[1] = e;
+                    else
+                    {
+                        fields[i].element[0] = e;
+                        if (outputFrom == -1)
+                            memset(fields[i].element + 1, 0, sizeof(e));
+                    }
+                }
+                else
+                    *fields[i].element = e;
             }
             else
             {
@@ -235,20 +471,518 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
             }
 
             break;
-        }
+        }
+
+        c += strcspn(c, ",");
+        c += strspn(c, ",");
+    }
+
+    for (i = 0;  i < 32;  i++)
+    {
+        if (mapping->guid[i] >= 'A' && mapping->guid[i] <= 'F')
+            mapping->guid[i] += 'a' - 'A';
+    }
+
+    _glfwPlatformUpdateGamepadGUID(mapping->guid);
+    return GLFW_TRUE;
+}
+
+
+// Input log record header, followed by size bytes of payload
+// The time is in timer ticks since the recording was started
+//
+typedef struct _GLFWlogrecord
+{
+    uint64_t        time;
+    int32_t         target;
+    uint16_t        type;
+    uint16_t        size;
+} _GLFWlogrecord;
+
+// Payload layout of an input log record
+// The head is an array of native int ('i') or double ('d') values and the
+// optional tail is raw bytes ('b'), a float ('f') or multitouch events ('e')
+//
+typedef struct _GLFWlogformat
+{
+    const char*     head;
+    char            tail;
+} _GLFWlogformat;
+
+// The log is written as little-endian fixed-width fields without padding, so
+// that it can be replayed on a machine with a different ABI than the one that
+// recorded it, with int as int32 and float and double as IEEE 754 binary32 and
+// binary64
+// The header is the magic, a uint32 version, a reserved uint32 and the uint64
+// timer frequency, each record header is the fields above in order and each
+// multitouch event is its fields in declaration order
+//
+#define _GLFW_LOG_MAGIC         "GLFWILOG"
+#define _GLFW_LOG_VERSION       2
+#define _GLFW_LOG_HEADER_SIZE   24
+#define _GLFW_LOG_RECORD_SIZE   16
+#define _GLFW_LOG_EVENT_SIZE    72
+
+// Payload layouts indexed by record type
+//
+static const _GLFWlogformat logFormats[] =
+{
+    { "i",    0   },
+    { "iiii", 0   },
+    { "ii",   'b' },
+    { "dd",   0   },
+    { "iii",  0   },
+    { "dd",   0   },
+    { "i",    0   },
+    { "ii",   'e' },
+    { "i",    0   },
+    { "ii",   0   },
+    { "ii",   0   },
+    { "",     0   },
+    { "iiii", 'b' },
+    { "i",    'f' },
+    { "ii",   0   },
+    { "ii",   0   }
+};
+
+static void putUint16(unsigned char* p, uint16_t value)
+{
+    p[0] = (unsigned char) value;
+    p[1] = (unsigned char) (value >> 8);
+}
+
+static void putUint32(unsigned char* p, uint32_t value)
+{
+    putUint16(p, (uint16_t) value);
+    putUint16(p + 2, (uint16_t) (value >> 16));
+}
+
+static void putUint64(unsigned char* p, uint64_t value)
+{
+    putUint32(p, (uint32_t) value);
+    putUint32(p + 4, (uint32_t) (value >> 32));
+}
+
+static void putFloat(unsigned char* p, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    putUint32(p, bits);
+}
+
+static void putDouble(unsigned char* p, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    putUint64(p, bits);
+}
+
+static uint16_t getUint16(const unsigned char* p)
+{
+    return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+static uint32_t getUint32(const unsigned char* p)
+{
+    return getUint16(p) | ((uint32_t) getUint16(p + 2) << 16);
+}
+
+static uint64_t getUint64(const unsigned char* p)
+{
+    return getUint32(p) | ((uint64_t) getUint32(p + 4) << 32);
+}
+
+static float getFloat(const unsigned char* p)
+{
+    const uint32_t bits = getUint32(p);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static double getDouble(const unsigned char* p)
+{
+    const uint64_t bits = getUint64(p);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Returns the encoded size of a record head with the specified layout
+//
+static size_t getHeadSize(const char* format)
+{
+    size_t size = 0;
+
+    for (;  *format;  format++)
+        size += (*format == 'd') ? 8 : 4;
+
+    return size;
+}
+
+// Encodes the native values of a record head
+//
+static void encodeHead(unsigned char* p, const char* format, const void* head)
+{
+    const int* i = head;
+    const double* d = head;
+
+    for (;  *format;  format++)
+    {
+        if (*format == 'd')
+        {
+            putDouble(p, *d++);
+            p += 8;
+        }
+        else
+        {
+            putUint32(p, (uint32_t) *i++);
+            p += 4;
+        }
+    }
+}
+
+// Decodes a record head into native int and double values
+//
+static void decodeHead(const unsigned char* p, const char* format,
+                       int* i, double* d)
+{
+    for (;  *format;  format++)
+    {
+        if (*format == 'd')
+        {
+            *d++ = getDouble(p);
+            p += 8;
+        }
+        else
+        {
+            *i++ = (int32_t) getUint32(p);
+            p += 4;
+        }
+    }
+}
+
+static void encodeEvent(unsigned char* p, const GLFWinputEvent* event)
+{
+    putUint32(p +  0, (uint32_t) event->inputDevice);
+    putUint32(p +  4, event->num);
+    putUint32(p +  8, event->buttons);
+    putUint32(p + 12, event->hover);
+    putDouble(p + 16, event->x);
+    putDouble(p + 24, event->y);
+    putDouble(p + 32, event->xoffset);
+    putDouble(p + 40, event->yoffset);
+    putDouble(p + 48, event->dx);
+    putDouble(p + 56, event->dy);
+    putUint32(p + 64, (uint32_t) event->action);
+    putUint32(p + 68, event->actionButton);
+}
+
+static void decodeEvent(GLFWinputEvent* event, const unsigned char* p)
+{
+    event->inputDevice  = (int32_t) getUint32(p + 0);
+    event->num          = getUint32(p + 4);
+    event->buttons      = getUint32(p + 8);
+    event->hover        = getUint32(p + 12);
+    event->x            = getDouble(p + 16);
+    event->y            = getDouble(p + 24);
+    event->xoffset      = getDouble(p + 32);
+    event->yoffset      = getDouble(p + 40);
+    event->dx           = getDouble(p + 48);
+    event->dy           = getDouble(p + 56);
+    event->action       = (int32_t) getUint32(p + 64);
+    event->actionButton = getUint32(p + 68);
+}
+
+// Decodes a record header read from the input log
+//
+static void decodeRecord(_GLFWlogrecord* record, const unsigned char* p)
+{
+    record->time   = getUint64(p);
+    record->target = (int32_t) getUint32(p + 8);
+    record->type   = getUint16(p + 12);
+    record->size   = getUint16(p + 14);
+}
+
+// Writes a record with a payload split in two parts to the input log
+// The head and tail are native values laid out as described by the format of
+// the record type and are encoded as they are written
+//
+static void writeRecord(int type, int target,
+                        const void* head, const void* tail, size_t tailSize)
+{
+    const _GLFWlogformat* format = logFormats + type;
+    const size_t headSize = getHeadSize(format->head);
+    unsigned char buffer[_GLFW_LOG_EVENT_SIZE];
+    size_t size = tailSize;
+
+    if (format->tail == 'f')
+        size = 4;
+    else if (format->tail == 'e')
+        size = tailSize / sizeof(GLFWinputEvent) * _GLFW_LOG_EVENT_SIZE;
+
+    if (headSize + size > 0xffff)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Input event too large to be recorded");
+        return;
+    }
+
+    putUint64(buffer, _glfwPlatformGetTimerValue() - _glfw.inputLog.start);
+    putUint32(buffer + 8, (uint32_t) target);
+    putUint16(buffer + 12, (uint16_t) type);
+    putUint16(buffer + 14, (uint16_t) (headSize + size));
+    fwrite(buffer, _GLFW_LOG_RECORD_SIZE, 1, _glfw.inputLog.file);
+
+    if (headSize)
+    {
+        encodeHead(buffer, format->head, head);
+        fwrite(buffer, headSize, 1, _glfw.inputLog.file);
+    }
+
+    if (format->tail == 'f')
+    {
+        putFloat(buffer, *(const float*) tail);
+        fwrite(buffer, 4, 1, _glfw.inputLog.file);
+    }
+    else if (format->tail == 'e')
+    {
+        const GLFWinputEvent* events = tail;
+        size_t i;
+
+        for (i = 0;  i < tailSize / sizeof(GLFWinputEvent);  i++)
+        {
+            encodeEvent(buffer, events + i);
+            fwrite(buffer, _GLFW_LOG_EVENT_SIZE, 1, _glfw.inputLog.file);
+        }
+    }
+    else if (tailSize)
+        fwrite(tail, tailSize, 1, _glfw.inputLog.file);
+}
+
+// Writes the number of frames that passed since the previous record, if any
+//
+static void flushFrames(void)
+{
+    if (_glfw.inputLog.frames)
+    {
+        const int frames = (int) _glfw.inputLog.frames;
+        _glfw.inputLog.frames = 0;
+        writeRecord(_GLFW_RECORD_FRAME, -1, &frames, NULL, 0);
+    }
+}
+
+// Records an input event and reports whether it should be processed
+// Live events are discarded while a log is being replayed
+//
+static GLFWbool recordInput(int type, int target, const void* head,
+                            const void* tail, size_t tailSize)
+{
+    if (_glfw.inputLog.data)
+        return _glfw.inputLog.dispatching;
+
+    if (_glfw.inputLog.file && !_glfw.inputLog.suspended)
+    {
+        flushFrames();
+        writeRecord(type, target, head, tail, tailSize);
+    }
+
+    return GLFW_TRUE;
+}
+
+// Returns the window with the specified creation serial, if it still exists
+//
+static _GLFWwindow* findWindowBySerial(int serial)
+{
+    _GLFWwindow* window;
+
+    _glfwPlatformLockMutex(&_glfw.windowLock);
+
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        if (window->serial == serial)
+            break;
+    }
+
+    _glfwPlatformUnlockMutex(&_glfw.windowLock);
+    return window;
+}
+
+// Feeds a recorded event back through the event API
+//
+static void dispatchRecord(const _GLFWlogrecord* record,
+                           const unsigned char* payload)
+{
+    int i[4];
+    double d[2];
+    size_t headSize, tailSize;
+    const unsigned char* tail;
+    const _GLFWlogformat* format;
+    _GLFWwindow* window = NULL;
+    _GLFWjoystick* js = NULL;
+
+    if (record->type > _GLFW_RECORD_JOYSTICK_HAT)
+        return;
+
+    format = logFormats + record->type;
+    headSize = getHeadSize(format->head);
+    if (record->size < headSize)
+        return;
+
+    decodeHead(payload, format->head, i, d);
+    tail = payload + headSize;
+    tailSize = record->size - headSize;
+
+    if ((format->tail == 'b' && (!tailSize || tail[tailSize - 1] != '\0')) ||
+        (format->tail == 'f' && tailSize < 4) ||
+        (format->tail == 'e' && tailSize % _GLFW_LOG_EVENT_SIZE))
+    {
+        return;
+    }
+
+    if (record->type >= _GLFW_RECORD_JOYSTICK)
+    {
+        if (record->target < 0 || record->target > GLFW_JOYSTICK_LAST)
+            return;
+
+        js = _glfw.joysticks + record->target;
+    }
+    else
+    {
+        window = findWindowBySerial(record->target);
+        if (!window)
+            return;
+    }
+
+    switch (record->type)
+    {
+        case _GLFW_RECORD_KEY:
+            _glfwInputKey(window, i[0], i[1], i[2], i[3]);
+            break;
+
+        case _GLFW_RECORD_TEXT:
+            _glfwInputText(window, (const char*) tail, i[0], i[1]);
+            break;
+
+        case _GLFW_RECORD_SCROLL:
+            _glfwInputScroll(window, d[0], d[1]);
+            break;
+
+        case _GLFW_RECORD_MOUSE_BUTTON:
+            _glfwInputMouseClick(window, i[0], i[1], i[2]);
+            break;
+
+        case _GLFW_RECORD_CURSOR_POS:
+            _glfwInputCursorPos(window, d[0], d[1]);
+            break;
+
+        case _GLFW_RECORD_CURSOR_ENTER:
+            _glfwInputCursorEnter(window, i[0]);
+            break;
+
+        case _GLFW_RECORD_MULTITOUCH:
+        {
+            int n;
+            GLFWinputEvent* events;
+
+            if (i[1] < 0 || tailSize != (size_t) i[1] * _GLFW_LOG_EVENT_SIZE)
+                break;
+
+            events = calloc(i[1] ? i[1] : 1, sizeof(GLFWinputEvent));
+            if (!events)
+                break;
+
+            for (n = 0;  n < i[1];  n++)
+                decodeEvent(events + n, tail + n * _GLFW_LOG_EVENT_SIZE);
+
+            _glfwInputMulitouchEvents(window, events, i[1], i[0]);
+            free(events);
+            break;
+        }
+
+        case _GLFW_RECORD_WINDOW_FOCUS:
+            _glfwInputWindowFocus(window, i[0]);
+            break;
+
+        case _GLFW_RECORD_WINDOW_SIZE:
+            _glfwInputWindowSize(window, i[0], i[1]);
+            break;
+
+        case _GLFW_RECORD_FRAMEBUFFER_SIZE:
+            _glfwInputFramebufferSize(window, i[0], i[1]);
+            break;
+
+        case _GLFW_RECORD_WINDOW_CLOSE:
+            _glfwInputWindowCloseRequest(window);
+            break;
+
+        case _GLFW_RECORD_JOYSTICK:
+#if defined(_GLFW_OSMESA)
+            // The null platform has no joysticks of its own, so recorded ones
+            // are recreated from their description
+            // The other platforms only replay the events of joysticks that are
+            // connected, as their joystick objects belong to the platform code
+            if (i[0] == GLFW_CONNECTED && !js->present &&
+                tailSize > sizeof(js->guid))
+            {
+                const char* guid = (const char*) tail;
+                const char* name = guid + sizeof(js->guid);
+
+                js = _glfwAllocJoystick(name, guid, i[1], i[2], i[3]);
+                if (js)
+                    _glfwInputJoystick(js, GLFW_CONNECTED);
+            }
+            else if (i[0] == GLFW_DISCONNECTED && js->present)
+            {
+                _glfwFreeJoystick(js);
+                _glfwInputJoystick(js, GLFW_DISCONNECTED);
+            }
+#endif
+            break;
+
+        case _GLFW_RECORD_JOYSTICK_AXIS:
+            if (js->present && i[0] >= 0 && i[0] < js->axisCount)
+                _glfwInputJoystickAxis(js, i[0], getFloat(tail));
+            break;
 
-        c += strcspn(c, ",");
-        c += strspn(c, ",");
+        case _GLFW_RECORD_JOYSTICK_BUTTON:
+            if (js->present && i[0] >= 0 && i[0] < js->buttonCount)
+                _glfwInputJoystickButton(js, i[0], (char) i[1]);
+            break;
+
+        case _GLFW_RECORD_JOYSTICK_HAT:
+            if (js->present && i[0] >= 0 && i[0] < js->hatCount)
+                _glfwInputJoystickHat(js, i[0], (char) i[1]);
+            break;
     }
+}
 
-    for (i = 0;  i < 32;  i++)
+// Notes the arrival of input for the latency probe of the window
+//
+static void probeInput(_GLFWwindow* window)
+{
+    // The swap may take the pending value on another thread at any time, so it
+    // is only set if it is still clear
+    if (window->latency.enabled && !window->latency.pending)
     {
-        if (mapping->guid[i] >= 'A' && mapping->guid[i] <= 'F')
-            mapping->guid[i] += 'a' - 'A';
+        _GLFW_ATOMIC_COMPARE_EXCHANGE64(&window->latency.pending,
+                                        0, _glfwPlatformGetTimerValue());
     }
+}
 
-    _glfwPlatformUpdateGamepadGUID(mapping->guid);
-    return GLFW_TRUE;
+// Notifies the multitouch callback without recording the event
+// This is used for the events synthesized from other recorded events
+//
+static void inputMultitouch(_GLFWwindow* window,
+                            GLFWinputEvent* events, int eventCount, int mods)
+{
+    if (!window->lockKeyMods)
+        mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
+
+    window->lastMods = mods;
+
+    if (window->callbacks.multitouchEvent)
+        window->callbacks.multitouchEvent((GLFWwindow*) window, events, eventCount, mods);
 }
 
 
@@ -260,6 +994,18 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
 //
 void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int mods)
 {
+    if (_glfw.inputLog.active)
+    {
+        const int data[] = { key, scancode, action, mods };
+        if (!_glfwRecordInput(_GLFW_RECORD_KEY, window->serial,
+                              data))
+        {
+            return;
+        }
+    }
+
+    probeInput(window);
+
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
@@ -293,28 +1039,110 @@ void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int m
 //
 void _glfwInputChar(_GLFWwindow* window, unsigned int codepoint, int mods, GLFWbool plain)
 {
+    char text[5];
+
+    text[_glfwEncodeUTF8(text, codepoint)] = '\0';
+    _glfwInputText(window, text, mods, plain);
+}
+
+// Notifies shared code of a run of UTF-8 encoded text input
+// The per-codepoint character callbacks are emitted from here for each
+// codepoint, with 'plain' determining whether to emit regular character events
+//
+void _glfwInputText(_GLFWwindow* window, const char* text, int mods, GLFWbool plain)
+{
+    char buffer[256];
+    char* filtered = buffer;
+    const char* c = text;
+    size_t count = 0;
+
+    if (_glfw.inputLog.active)
+    {
+        const int data[] = { mods, plain };
+        if (!recordInput(_GLFW_RECORD_TEXT, window->serial,
+                         data, text, strlen(text) + 1))
+        {
+            return;
+        }
+    }
+
+    probeInput(window);
+
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
     window->lastMods = mods;
 
-    if (codepoint < 32 || (codepoint > 126 && codepoint < 160))
+    if (!window->callbacks.text &&
+        !window->callbacks.charmods &&
+        !(plain && window->callbacks.character))
+    {
         return;
+    }
 
-    if (window->callbacks.charmods)
-        window->callbacks.charmods((GLFWwindow*) window, codepoint, mods);
+    if (strlen(text) >= sizeof(buffer))
+    {
+        filtered = calloc(strlen(text) + 1, 1);
+        if (!filtered)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return;
+        }
+    }
 
-    if (plain)
+    while (*c)
     {
-        if (window->callbacks.character)
-            window->callbacks.character((GLFWwindow*) window, codepoint);
+        const char* start = c;
+        const unsigned int codepoint = _glfwDecodeUTF8(&c);
+
+        if (codepoint < 32 || (codepoint > 126 && codepoint < 160))
+            continue;
+
+        // A replacement character is at least as short as the invalid
+        // sequence it stands for, so it fits in place of that sequence
+        if (codepoint == 0xfffd)
+            count += _glfwEncodeUTF8(filtered + count, codepoint);
+        else
+        {
+            memcpy(filtered + count, start, c - start);
+            count += c - start;
+        }
+
+        if (window->callbacks.charmods)
+            window->callbacks.charmods((GLFWwindow*) window, codepoint, mods);
+
+        if (plain)
+        {
+            if (window->callbacks.character)
+                window->callbacks.character((GLFWwindow*) window, codepoint);
+        }
     }
+
+    filtered[count] = '\0';
+
+    if (count && window->callbacks.text)
+        window->callbacks.text((GLFWwindow*) window, filtered, mods);
+
+    if (filtered != buffer)
+        free(filtered);
 }
 
 // Notifies shared code of a scroll event
 //
 void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset)
 {
+    if (_glfw.inputLog.active)
+    {
+        const double data[] = { xoffset, yoffset };
+        if (!_glfwRecordInput(_GLFW_RECORD_SCROLL, window->serial,
+                              data))
+        {
+            return;
+        }
+    }
+
+    probeInput(window);
+
     if (window->callbacks.scroll)
         window->callbacks.scroll((GLFWwindow*) window, xoffset, yoffset);
 
@@ -335,26 +1163,44 @@ void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset)
     ie.dy = 0;
     ie.action = GLFW_SCROLL;
     ie.actionButton = 0;
-    _glfwInputMulitouchEvents(window, &ie, 1, window->lastMods);
+    inputMultitouch(window, &ie, 1, window->lastMods);
 }
 
 // Notifies shared code of an input event
 //
 void _glfwInputMulitouchEvents(_GLFWwindow* window, GLFWinputEvent* events, int eventCount, int mods)
 {
-    if (!window->lockKeyMods)
-        mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
+    if (_glfw.inputLog.active)
+    {
+        const int data[] = { mods, eventCount };
+        if (!recordInput(_GLFW_RECORD_MULTITOUCH, window->serial,
+                         data, events, eventCount * sizeof(GLFWinputEvent)))
+        {
+            return;
+        }
+    }
 
-    window->lastMods = mods;
+    probeInput(window);
 
-    if (window->callbacks.multitouchEvent)
-        window->callbacks.multitouchEvent((GLFWwindow*) window, events, eventCount, mods);
+    inputMultitouch(window, events, eventCount, mods);
 }
 
 // Notifies shared code of a mouse button click event
 //
 void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
 {
+    if (_glfw.inputLog.active)
+    {
+        const int data[] = { button, action, mods };
+        if (!_glfwRecordInput(_GLFW_RECORD_MOUSE_BUTTON, window->serial,
+                              data))
+        {
+            return;
+        }
+    }
+
+    probeInput(window);
+
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
@@ -388,7 +1234,7 @@ void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
     ie.dy = 0;
     ie.action = action;
     ie.actionButton = 1 << button;
-    _glfwInputMulitouchEvents(window, &ie, 1, mods);
+    inputMultitouch(window, &ie, 1, mods);
 }
 
 // Notifies shared code of a cursor motion event
@@ -399,6 +1245,18 @@ void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos)
     if (window->virtualCursorPosX == xpos && window->virtualCursorPosY == ypos)
         return;
 
+    if (_glfw.inputLog.active)
+    {
+        const double data[] = { xpos, ypos };
+        if (!_glfwRecordInput(_GLFW_RECORD_CURSOR_POS, window->serial,
+                              data))
+        {
+            return;
+        }
+    }
+
+    probeInput(window);
+
     GLFWinputEvent ie;
     ie.dx = xpos - window->virtualCursorPosX;
     ie.dy = ypos - window->virtualCursorPosY;
@@ -422,13 +1280,23 @@ void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos)
     ie.yoffset = 0;
     ie.action = GLFW_CURSORPOS;
     ie.actionButton = 0;
-    _glfwInputMulitouchEvents(window, &ie, 1, window->lastMods);
+    inputMultitouch(window, &ie, 1, window->lastMods);
 }
 
 // Notifies shared code of a cursor enter/leave event
 //
 void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered)
 {
+    if (_glfw.inputLog.active)
+    {
+        const int data[] = { entered };
+        if (!_glfwRecordInput(_GLFW_RECORD_CURSOR_ENTER, window->serial,
+                              data))
+        {
+            return;
+        }
+    }
+
     if (window->callbacks.cursorEnter)
         window->callbacks.cursorEnter((GLFWwindow*) window, entered);
 }
@@ -441,12 +1309,83 @@ void _glfwInputDrop(_GLFWwindow* window, int count, const char** paths)
         window->callbacks.drop((GLFWwindow*) window, count, paths);
 }
 
+// Appends a change to the event buffer of the joystick, if enabled
+//
+static void bufferJoystickEvent(_GLFWjoystick* js, int type, int index, float value)
+{
+    const int jid = (int) (js - _glfw.joysticks);
+    GLFWjoystickevent* event;
+    uint64_t time;
+
+    if (!_glfw.joystickEvents[jid].size)
+        return;
+
+    if (_glfw.joystickEvents[jid].count == _glfw.joystickEvents[jid].size)
+    {
+        // Discard the oldest change to make room
+        _glfw.joystickEvents[jid].head =
+            (_glfw.joystickEvents[jid].head + 1) % _glfw.joystickEvents[jid].size;
+        _glfw.joystickEvents[jid].count--;
+    }
+
+    event = _glfw.joystickEvents[jid].events +
+        (_glfw.joystickEvents[jid].head + _glfw.joystickEvents[jid].count) %
+        _glfw.joystickEvents[jid].size;
+    _glfw.joystickEvents[jid].count++;
+
+    time = js->eventTime;
+    if (!time || time < _glfw.timer.offset)
+        time = _glfwPlatformGetTimerValue();
+
+    event->time = (double) (time - _glfw.timer.offset) /
+        _glfwPlatformGetTimerFrequency();
+    event->type = type;
+    event->index = index;
+    event->value = value;
+}
+
 // Notifies shared code of a joystick connection or disconnection
 //
 void _glfwInputJoystick(_GLFWjoystick* js, int event)
 {
     const int jid = (int) (js - _glfw.joysticks);
 
+    if (_glfw.inputLog.active)
+    {
+        // The description lets the replay recreate the joystick where needed
+        const int data[] =
+        {
+            event, js->axisCount, js->buttonCount, js->hatCount
+        };
+        const size_t nameSize = js->name ? strlen(js->name) + 1 : 1;
+        char* desc = calloc(sizeof(js->guid) + nameSize, 1);
+        GLFWbool process;
+
+        if (!desc)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return;
+        }
+
+        memcpy(desc, js->guid, sizeof(js->guid));
+        if (js->name)
+            memcpy(desc + sizeof(js->guid), js->name, nameSize);
+
+        process = recordInput(_GLFW_RECORD_JOYSTICK, jid, data,
+                              desc, sizeof(js->guid) + nameSize);
+        free(desc);
+
+        if (!process)
+            return;
+    }
+
+    // Changes from a previous device in this slot are no longer meaningful
+    if (event == GLFW_CONNECTED)
+    {
+        _glfw.joystickEvents[jid].head = 0;
+        _glfw.joystickEvents[jid].count = 0;
+    }
+
     if (_glfw.callbacks.joystick)
         _glfw.callbacks.joystick(jid, event);
 }
@@ -455,80 +1394,292 @@ void _glfwInputJoystick(_GLFWjoystick* js, int event)
 //
 void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value)
 {
+    const int jid = (int) (js - _glfw.joysticks);
+
+    if (js->axes[axis] == value)
+        return;
+
+    if (_glfw.inputLog.active)
+    {
+        if (!recordInput(_GLFW_RECORD_JOYSTICK_AXIS, jid,
+                         &axis, &value, sizeof(value)))
+        {
+            return;
+        }
+    }
+
     js->axes[axis] = value;
+    bufferJoystickEvent(js, GLFW_JOYSTICK_AXIS_EVENT, axis, value);
+
+    if (_glfw.callbacks.joystickAxis)
+        _glfw.callbacks.joystickAxis(jid, axis, value);
 }
 
 // Notifies shared code of the new value of a joystick button
 //
 void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value)
 {
+    const int jid = (int) (js - _glfw.joysticks);
+
+    if (js->buttons[button] == value)
+        return;
+
+    if (_glfw.inputLog.active)
+    {
+        const int data[] = { button, value };
+        if (!_glfwRecordInput(_GLFW_RECORD_JOYSTICK_BUTTON, jid,
+                              data))
+        {
+            return;
+        }
+    }
+
     js->buttons[button] = value;
+    bufferJoystickEvent(js, GLFW_JOYSTICK_BUTTON_EVENT, button, value);
+
+    if (_glfw.callbacks.joystickButton)
+        _glfw.callbacks.joystickButton(jid, button, value);
 }
 
 // Notifies shared code of the new value of a joystick hat
 //
 void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value)
 {
+    const int jid = (int) (js - _glfw.joysticks);
     const int base = js->buttonCount + hat * 4;
 
+    if (js->hats[hat] == value)
+        return;
+
+    if (_glfw.inputLog.active)
+    {
+        const int data[] = { hat, value };
+        if (!_glfwRecordInput(_GLFW_RECORD_JOYSTICK_HAT, jid,
+                              data))
+        {
+            return;
+        }
+    }
+
     js->buttons[base + 0] = (value & 0x01) ? GLFW_PRESS : GLFW_RELEASE;
     js->buttons[base + 1] = (value & 0x02) ? GLFW_PRESS : GLFW_RELEASE;
     js->buttons[base + 2] = (value & 0x04) ? GLFW_PRESS : GLFW_RELEASE;
     js->buttons[base + 3] = (value & 0x08) ? GLFW_PRESS : GLFW_RELEASE;
 
     js->hats[hat] = value;
+    bufferJoystickEvent(js, GLFW_JOYSTICK_HAT_EVENT, hat, value);
+
+    if (_glfw.callbacks.joystickHat)
+        _glfw.callbacks.joystickHat(jid, hat, value);
+}
+
+// Notifies the input log of an event and reports whether to process it
+//
+GLFWbool _glfwRecordInput(int type, int target, const void* data)
+{
+    return recordInput(type, target, data, NULL, 0);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Returns an available joystick object with arrays and name allocated
+//
+_GLFWjoystick* _glfwAllocJoystick(const char* name,
+                                  const char* guid,
+                                  int axisCount,
+                                  int buttonCount,
+                                  int hatCount)
+{
+    int jid;
+    _GLFWjoystick* js;
+
+    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (!_glfw.joysticks[jid].present)
+            break;
+    }
+
+    if (jid > GLFW_JOYSTICK_LAST)
+        return NULL;
+
+    js = _glfw.joysticks + jid;
+    js->present     = GLFW_TRUE;
+    js->name        = _glfw_strdup(name);
+    js->axes        = calloc(axisCount, sizeof(float));
+    js->buttons     = calloc(buttonCount + (size_t) hatCount * 4, 1);
+    js->hats        = calloc(hatCount, 1);
+    js->axisCount   = axisCount;
+    js->buttonCount = buttonCount;
+    js->hatCount    = hatCount;
+
+    strncpy(js->guid, guid, sizeof(js->guid) - 1);
+    js->mapping = findValidMapping(js);
+
+    return js;
+}
+
+// Frees arrays and name and flags the joystick object as unused
+//
+void _glfwFreeJoystick(_GLFWjoystick* js)
+{
+    free(js->name);
+    free(js->axes);
+    free(js->buttons);
+    free(js->hats);
+    memset(js, 0, sizeof(_GLFWjoystick));
+}
+
+// Ends the current frame of the input log
+// When replaying, this dispatches the recorded events of the next frame
+//
+void _glfwUpdateInputLog(void)
+{
+    if (_glfw.inputLog.file)
+        _glfw.inputLog.frames++;
+    else if (_glfw.inputLog.data)
+    {
+        if (_glfw.inputLog.frames)
+        {
+            _glfw.inputLog.frames--;
+            return;
+        }
+
+        _glfw.inputLog.dispatching = GLFW_TRUE;
+
+        while (_glfw.inputLog.data &&
+               _glfw.inputLog.position < _glfw.inputLog.size)
+        {
+            _GLFWlogrecord record;
+            const unsigned char* payload;
+
+            decodeRecord(&record, _glfw.inputLog.data + _glfw.inputLog.position);
+            payload = _glfw.inputLog.data + _glfw.inputLog.position +
+                      _GLFW_LOG_RECORD_SIZE;
+            _glfw.inputLog.position += _GLFW_LOG_RECORD_SIZE + record.size;
+
+            if (record.type == _GLFW_RECORD_FRAME)
+            {
+                uint32_t frames = 1;
+                if (record.size >= 4)
+                    frames = getUint32(payload);
+                _glfw.inputLog.frames = frames ? frames - 1 : 0;
+                break;
+            }
+
+            dispatchRecord(&record, payload);
+        }
+
+        _glfw.inputLog.dispatching = GLFW_FALSE;
+
+        if (_glfw.inputLog.data &&
+            _glfw.inputLog.position >= _glfw.inputLog.size &&
+            !_glfw.inputLog.frames)
+        {
+            _glfwCloseInputLog();
+        }
+    }
+}
+
+// Finishes any recording and ends any replay of the input log
+//
+void _glfwCloseInputLog(void)
+{
+    if (_glfw.inputLog.file)
+    {
+        flushFrames();
+        fclose(_glfw.inputLog.file);
+    }
+
+    free(_glfw.inputLog.data);
+    memset(&_glfw.inputLog, 0, sizeof(_glfw.inputLog));
 }
 
+// Publishes the current input state of all windows and of any joysticks
+// requested by other threads
+//
+void _glfwPublishInputSnapshots(void)
+{
+    int i, jid;
+    _GLFWwindow* window;
+    const double time = (double) (_glfwPlatformGetTimerValue() - _glfw.timer.offset) /
+        _glfwPlatformGetTimerFrequency();
+
+    _glfwPlatformLockMutex(&_glfw.windowLock);
+
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        GLFWinputsnapshot* state = &window->snapshot.state;
+
+        // An odd sequence number tells readers an update is in progress
+        window->snapshot.sequence++;
+        _GLFW_MEMORY_BARRIER();
 
-//////////////////////////////////////////////////////////////////////////
-//////                       GLFW internal API                      //////
-//////////////////////////////////////////////////////////////////////////
+        state->serial = window->snapshot.sequence >> 1;
+        state->time = time;
+        for (i = 0;  i <= GLFW_KEY_LAST;  i++)
+        {
+            state->keys[i] = window->keys[i] == GLFW_PRESS ?
+                             GLFW_PRESS : GLFW_RELEASE;
+        }
+        for (i = 0;  i <= GLFW_MOUSE_BUTTON_LAST;  i++)
+        {
+            state->mouseButtons[i] = window->mouseButtons[i] == GLFW_PRESS ?
+                                     GLFW_PRESS : GLFW_RELEASE;
+        }
+        state->cursorX = window->virtualCursorPosX;
+        state->cursorY = window->virtualCursorPosY;
+        state->mods = window->lastMods;
 
-// Returns an available joystick object with arrays and name allocated
-//
-_GLFWjoystick* _glfwAllocJoystick(const char* name,
-                                  const char* guid,
-                                  int axisCount,
-                                  int buttonCount,
-                                  int hatCount)
-{
-    int jid;
-    _GLFWjoystick* js;
+        _GLFW_MEMORY_BARRIER();
+        window->snapshot.sequence++;
+    }
+
+    _glfwPlatformUnlockMutex(&_glfw.windowLock);
 
     for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
     {
-        if (!_glfw.joysticks[jid].present)
-            break;
-    }
+        _GLFWjoystick* js = _glfw.joysticks + jid;
+        GLFWjoysticksnapshot* state = &_glfw.joystickSnapshots[jid].state;
+        GLFWbool present = GLFW_FALSE;
 
-    if (jid > GLFW_JOYSTICK_LAST)
-        return NULL;
+        if (!_glfw.joystickSnapshots[jid].requested)
+            continue;
 
-    js = _glfw.joysticks + jid;
-    js->present     = GLFW_TRUE;
-    js->name        = _glfw_strdup(name);
-    js->axes        = calloc(axisCount, sizeof(float));
-    js->buttons     = calloc(buttonCount + (size_t) hatCount * 4, 1);
-    js->hats        = calloc(hatCount, 1);
-    js->axisCount   = axisCount;
-    js->buttonCount = buttonCount;
-    js->hatCount    = hatCount;
+        if (js->present)
+            present = _glfwPlatformPollJoystick(js, _GLFW_POLL_ALL);
 
-    strncpy(js->guid, guid, sizeof(js->guid) - 1);
-    js->mapping = findValidMapping(js);
+        _glfw.joystickSnapshots[jid].sequence++;
+        _GLFW_MEMORY_BARRIER();
 
-    return js;
-}
+        _glfw.joystickSnapshots[jid].present = present;
+        state->serial = _glfw.joystickSnapshots[jid].sequence >> 1;
+        state->time = time;
 
-// Frees arrays and name and flags the joystick object as unused
-//
-void _glfwFreeJoystick(_GLFWjoystick* js)
-{
-    free(js->name);
-    free(js->axes);
-    free(js->buttons);
-    free(js->hats);
-    memset(js, 0, sizeof(_GLFWjoystick));
+        if (present)
+        {
+            state->axisCount = js->axisCount < GLFW_SNAPSHOT_AXES ?
+                               js->axisCount : GLFW_SNAPSHOT_AXES;
+            state->buttonCount = js->buttonCount < GLFW_SNAPSHOT_BUTTONS ?
+                                 js->buttonCount : GLFW_SNAPSHOT_BUTTONS;
+            state->hatCount = js->hatCount < GLFW_SNAPSHOT_HATS ?
+                              js->hatCount : GLFW_SNAPSHOT_HATS;
+            memcpy(state->axes, js->axes, state->axisCount * sizeof(float));
+            memcpy(state->buttons, js->buttons, state->buttonCount);
+            memcpy(state->hats, js->hats, state->hatCount);
+        }
+        else
+        {
+            state->axisCount = 0;
+            state->buttonCount = 0;
+            state->hatCount = 0;
+        }
+
+        _GLFW_MEMORY_BARRIER();
+        _glfw.joystickSnapshots[jid].sequence++;
+    }
 }
 
 // Center the cursor in the content area of the specified window
@@ -871,11 +2022,15 @@ GLFWAPI void glfwDestroyCursor(GLFWcursor* handle)
     {
         _GLFWwindow* window;
 
+        _glfwPlatformLockMutex(&_glfw.windowLock);
+
         for (window = _glfw.windowListHead;  window;  window = window->next)
         {
             if (window->cursor == cursor)
                 glfwSetCursor((GLFWwindow*) window, NULL);
         }
+
+        _glfwPlatformUnlockMutex(&_glfw.windowLock);
     }
 
     _glfwPlatformDestroyCursor(cursor);
@@ -936,6 +2091,16 @@ GLFWAPI GLFWcharmodsfun glfwSetCharModsCallback(GLFWwindow* handle, GLFWcharmods
     return cbfun;
 }
 
+GLFWAPI GLFWtextfun glfwSetTextCallback(GLFWwindow* handle, GLFWtextfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(window->callbacks.text, cbfun);
+    return cbfun;
+}
+
 GLFWAPI GLFWmultitoucheventfun glfwSetMultitouchEventCallback(GLFWwindow* handle,
                                                               GLFWmultitoucheventfun cbfun)
 {
@@ -1148,6 +2313,86 @@ GLFWAPI const unsigned char* glfwGetJoystickHats(int jid, int* count)
     return js->hats;
 }
 
+GLFWAPI void glfwSetJoystickEventBufferSize(int jid, int size)
+{
+    GLFWjoystickevent* events = NULL;
+
+    assert(jid >= GLFW_JOYSTICK_1);
+    assert(jid <= GLFW_JOYSTICK_LAST);
+    assert(size >= 0);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
+        return;
+    }
+
+    if (size < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid joystick event buffer size %i", size);
+        return;
+    }
+
+    if (size)
+    {
+        events = calloc(size, sizeof(GLFWjoystickevent));
+        if (!events)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return;
+        }
+    }
+
+    free(_glfw.joystickEvents[jid].events);
+    _glfw.joystickEvents[jid].events = events;
+    _glfw.joystickEvents[jid].size = size;
+    _glfw.joystickEvents[jid].head = 0;
+    _glfw.joystickEvents[jid].count = 0;
+}
+
+GLFWAPI int glfwGetJoystickEvents(int jid, GLFWjoystickevent* events, int max)
+{
+    _GLFWjoystick* js;
+    int i, count;
+
+    assert(jid >= GLFW_JOYSTICK_1);
+    assert(jid <= GLFW_JOYSTICK_LAST);
+    assert(events != NULL || max == 0);
+    assert(max >= 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
+        return 0;
+    }
+
+    js = _glfw.joysticks + jid;
+    if (!js->present)
+        return 0;
+
+    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_ALL))
+        return 0;
+
+    count = _glfw.joystickEvents[jid].count;
+    if (count > max)
+        count = max;
+
+    for (i = 0;  i < count;  i++)
+    {
+        events[i] = _glfw.joystickEvents[jid].events[_glfw.joystickEvents[jid].head];
+        _glfw.joystickEvents[jid].head =
+            (_glfw.joystickEvents[jid].head + 1) % _glfw.joystickEvents[jid].size;
+    }
+
+    _glfw.joystickEvents[jid].count -= count;
+    return count;
+}
+
 GLFWAPI const char* glfwGetJoystickName(int jid)
 {
     _GLFWjoystick* js;
@@ -1237,9 +2482,31 @@ GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun cbfun)
     return cbfun;
 }
 
+GLFWAPI GLFWjoystickaxisfun glfwSetJoystickAxisCallback(GLFWjoystickaxisfun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(_glfw.callbacks.joystickAxis, cbfun);
+    return cbfun;
+}
+
+GLFWAPI GLFWjoystickbuttonfun glfwSetJoystickButtonCallback(GLFWjoystickbuttonfun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(_glfw.callbacks.joystickButton, cbfun);
+    return cbfun;
+}
+
+GLFWAPI GLFWjoystickhatfun glfwSetJoystickHatCallback(GLFWjoystickhatfun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(_glfw.callbacks.joystickHat, cbfun);
+    return cbfun;
+}
+
 GLFWAPI int glfwUpdateGamepadMappings(const char* string)
 {
     int jid;
+    GLFWbool result = GLFW_TRUE;
     const char* c = string;
 
     assert(string != NULL);
@@ -1267,13 +2534,10 @@ GLFWAPI int glfwUpdateGamepadMappings(const char* string)
                     _GLFWmapping* previous = findMapping(mapping.guid);
                     if (previous)
                         *previous = mapping;
-                    else
+                    else if (!addMapping(&mapping))
                     {
-                        _glfw.mappingCount++;
-                        _glfw.mappings =
-                            realloc(_glfw.mappings,
-                                    sizeof(_GLFWmapping) * _glfw.mappingCount);
-                        _glfw.mappings[_glfw.mappingCount - 1] = mapping;
+                        result = GLFW_FALSE;
+                        break;
                     }
                 }
             }
@@ -1294,7 +2558,7 @@ GLFWAPI int glfwUpdateGamepadMappings(const char* string)
             js->mapping = findValidMapping(js);
     }
 
-    return GLFW_TRUE;
+    return result;
 }
 
 GLFWAPI int glfwJoystickIsGamepad(int jid)
@@ -1352,7 +2616,6 @@ GLFWAPI const char* glfwGetGamepadName(int jid)
 
 GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state)
 {
-    int i;
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
@@ -1379,60 +2642,216 @@ GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state)
     if (!js->mapping)
         return GLFW_FALSE;
 
-    for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
+    evaluateMapping(js, state);
+    return GLFW_TRUE;
+}
+
+GLFWAPI int glfwGetAllGamepadStates(GLFWgamepadstate* states, int* count)
+{
+    int jid;
+
+    assert(states != NULL);
+    assert(count != NULL);
+
+    *count = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
     {
-        const _GLFWmapelement* e = js->mapping->buttons + i;
-        if (e->type == _GLFW_JOYSTICK_AXIS)
-        {
-            const float value = js->axes[e->index] * e->axisScale + e->axisOffset;
-            // HACK: This should be baked into the value transform
-            // TODO: Bake into transform when implementing output modifiers
-            if (e->axisOffset < 0 || (e->axisOffset == 0 && e->axisScale > 0))
-            {
-                if (value >= 0.f)
-                    state->buttons[i] = GLFW_PRESS;
-            }
-            else
-            {
-                if (value <= 0.f)
-                    state->buttons[i] = GLFW_PRESS;
-            }
-        }
-        else if (e->type == _GLFW_JOYSTICK_HATBIT)
+        _GLFWjoystick* js = _glfw.joysticks + jid;
+
+        if (js->present &&
+            _glfwPlatformPollJoystick(js, _GLFW_POLL_ALL) && js->mapping)
         {
-            const unsigned int hat = e->index >> 4;
-            const unsigned int bit = e->index & 0xf;
-            if (js->hats[hat] & bit)
-                state->buttons[i] = GLFW_PRESS;
+            evaluateMapping(js, states + jid);
+            *count = jid + 1;
         }
-        else if (e->type == _GLFW_JOYSTICK_BUTTON)
-            state->buttons[i] = js->buttons[e->index];
+        else
+            memset(states + jid, 0, sizeof(GLFWgamepadstate));
     }
 
-    for (i = 0;  i <= GLFW_GAMEPAD_AXIS_LAST;  i++)
+    return *count > 0;
+}
+
+GLFWAPI int glfwGetInputSnapshot(GLFWwindow* handle, GLFWinputsnapshot* snapshot)
+{
+    uint32_t sequence;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(snapshot != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    do
     {
-        const _GLFWmapelement* e = js->mapping->axes + i;
-        if (e->type == _GLFW_JOYSTICK_AXIS)
-        {
-            const float value = js->axes[e->index] * e->axisScale + e->axisOffset;
-            state->axes[i] = _glfw_fminf(_glfw_fmaxf(value, -1.f), 1.f);
-        }
-        else if (e->type == _GLFW_JOYSTICK_HATBIT)
-        {
-            const unsigned int hat = e->index >> 4;
-            const unsigned int bit = e->index & 0xf;
-            if (js->hats[hat] & bit)
-                state->axes[i] = 1.f;
-            else
-                state->axes[i] = -1.f;
-        }
-        else if (e->type == _GLFW_JOYSTICK_BUTTON)
-            state->axes[i] = js->buttons[e->index] * 2.f - 1.f;
+        sequence = window->snapshot.sequence;
+        _GLFW_MEMORY_BARRIER();
+        *snapshot = window->snapshot.state;
+        _GLFW_MEMORY_BARRIER();
+    } while ((sequence & 1) || sequence != window->snapshot.sequence);
+
+    return sequence != 0;
+}
+
+GLFWAPI int glfwGetJoystickSnapshot(int jid, GLFWjoysticksnapshot* snapshot)
+{
+    uint32_t sequence;
+    GLFWbool present;
+
+    assert(jid >= GLFW_JOYSTICK_1);
+    assert(jid <= GLFW_JOYSTICK_LAST);
+    assert(snapshot != NULL);
+
+    memset(snapshot, 0, sizeof(GLFWjoysticksnapshot));
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
+        return GLFW_FALSE;
     }
 
+    _glfw.joystickSnapshots[jid].requested = GLFW_TRUE;
+
+    do
+    {
+        sequence = _glfw.joystickSnapshots[jid].sequence;
+        _GLFW_MEMORY_BARRIER();
+        *snapshot = _glfw.joystickSnapshots[jid].state;
+        present = _glfw.joystickSnapshots[jid].present;
+        _GLFW_MEMORY_BARRIER();
+    } while ((sequence & 1) || sequence != _glfw.joystickSnapshots[jid].sequence);
+
+    return present;
+}
+
+GLFWAPI int glfwStartInputRecording(const char* path)
+{
+    unsigned char header[_GLFW_LOG_HEADER_SIZE];
+
+    assert(path != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (_glfw.inputLog.active)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Input is already being recorded or replayed");
+        return GLFW_FALSE;
+    }
+
+    _glfw.inputLog.file = fopen(path, "wb");
+    if (!_glfw.inputLog.file)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Failed to open input log %s for writing", path);
+        return GLFW_FALSE;
+    }
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, _GLFW_LOG_MAGIC, 8);
+    putUint32(header + 8, _GLFW_LOG_VERSION);
+    putUint64(header + 16, _glfwPlatformGetTimerFrequency());
+    fwrite(header, sizeof(header), 1, _glfw.inputLog.file);
+
+    _glfw.inputLog.start = _glfwPlatformGetTimerValue();
+    _glfw.inputLog.active = GLFW_TRUE;
+    return GLFW_TRUE;
+}
+
+GLFWAPI int glfwStartInputReplay(const char* path)
+{
+    FILE* file;
+    long size;
+    size_t position;
+    unsigned char* data;
+    unsigned char header[_GLFW_LOG_HEADER_SIZE];
+
+    assert(path != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (_glfw.inputLog.active)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Input is already being recorded or replayed");
+        return GLFW_FALSE;
+    }
+
+    file = fopen(path, "rb");
+    if (!file)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Failed to open input log %s", path);
+        return GLFW_FALSE;
+    }
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (size < (long) sizeof(header) ||
+        fread(header, sizeof(header), 1, file) != 1 ||
+        memcmp(header, _GLFW_LOG_MAGIC, 8) != 0 ||
+        getUint32(header + 8) != _GLFW_LOG_VERSION)
+    {
+        fclose(file);
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "File %s is not a valid input log", path);
+        return GLFW_FALSE;
+    }
+
+    size -= sizeof(header);
+    data = calloc(size ? size : 1, 1);
+    if (!data)
+    {
+        fclose(file);
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    if (fread(data, 1, size, file) != (size_t) size)
+    {
+        free(data);
+        fclose(file);
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Failed to read input log %s", path);
+        return GLFW_FALSE;
+    }
+
+    fclose(file);
+
+    // Drop any truncated record at the end
+    for (position = 0;  position + _GLFW_LOG_RECORD_SIZE <= (size_t) size;  )
+    {
+        _GLFWlogrecord record;
+        decodeRecord(&record, data + position);
+        if (position + _GLFW_LOG_RECORD_SIZE + record.size > (size_t) size)
+            break;
+
+        position += _GLFW_LOG_RECORD_SIZE + record.size;
+    }
+
+    _glfw.inputLog.data = data;
+    _glfw.inputLog.size = position;
+    _glfw.inputLog.active = GLFW_TRUE;
     return GLFW_TRUE;
 }
 
+GLFWAPI void glfwStopInputLog(void)
+{
+    _GLFW_REQUIRE_INIT();
+    _glfwCloseInputLog();
+}
+
+GLFWAPI int glfwInputReplayActive(void)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+    return _glfw.inputLog.data != NULL;
+}
+
 GLFWAPI void glfwSetClipboardString(GLFWwindow* handle, const char* string)
 {
     assert(string != NULL);
@@ -48,6 +48,8 @@
 #define GLFW_INCLUDE_NONE
 #include "../include/GLFW/glfw3.h"
 
+#include <stdio.h>
+
 #define _GLFW_INSERT_FIRST      0
 #define _GLFW_INSERT_LAST       1
 
@@ -56,8 +58,42 @@
 #define _GLFW_POLL_BUTTONS      2
 #define _GLFW_POLL_ALL          (_GLFW_POLL_AXES | _GLFW_POLL_BUTTONS)
 
+// Gamepad buttons followed by both halves of every gamepad axis
+#define _GLFW_MAPPING_ELEMENTS  (GLFW_GAMEPAD_BUTTON_LAST + 1 + \
+                                 (GLFW_GAMEPAD_AXIS_LAST + 1) * 2)
+
 #define _GLFW_MESSAGE_SIZE      1024
 
+// Log-linear histogram layout, with 2^SUB_BITS linear buckets per power of two
+#define _GLFW_HISTOGRAM_SUB_BITS 4
+#define _GLFW_HISTOGRAM_BUCKETS ((32 - _GLFW_HISTOGRAM_SUB_BITS + 1) << \
+                                 _GLFW_HISTOGRAM_SUB_BITS)
+
+// The number of most recent buffer swaps whose timings are kept per window
+#define _GLFW_FRAME_TIMINGS     32
+
+// Whether an open addressing hash table with the specified number of slots
+// needs to grow to hold the specified number of entries, as the tables are
+// kept at most half full so that their probe sequences stay short
+#define _GLFW_HASH_TABLE_FULL(count, slots) ((count) * 2 > (slots))
+
+#define _GLFW_RECORD_FRAME              0
+#define _GLFW_RECORD_KEY                1
+#define _GLFW_RECORD_TEXT               2
+#define _GLFW_RECORD_SCROLL             3
+#define _GLFW_RECORD_MOUSE_BUTTON       4
+#define _GLFW_RECORD_CURSOR_POS         5
+#define _GLFW_RECORD_CURSOR_ENTER       6
+#define _GLFW_RECORD_MULTITOUCH         7
+#define _GLFW_RECORD_WINDOW_FOCUS       8
+#define _GLFW_RECORD_WINDOW_SIZE        9
+#define _GLFW_RECORD_FRAMEBUFFER_SIZE   10
+#define _GLFW_RECORD_WINDOW_CLOSE       11
+#define _GLFW_RECORD_JOYSTICK           12
+#define _GLFW_RECORD_JOYSTICK_AXIS      13
+#define _GLFW_RECORD_JOYSTICK_BUTTON    14
+#define _GLFW_RECORD_JOYSTICK_HAT       15
+
 typedef int GLFWbool;
 
 typedef struct _GLFWerror       _GLFWerror;
@@ -65,6 +101,7 @@ typedef struct _GLFWinitconfig  _GLFWinitconfig;
 typedef struct _GLFWwndconfig   _GLFWwndconfig;
 typedef struct _GLFWctxconfig   _GLFWctxconfig;
 typedef struct _GLFWfbconfig    _GLFWfbconfig;
+typedef struct _GLFWfbconfigcache _GLFWfbconfigcache;
 typedef struct _GLFWcontext     _GLFWcontext;
 typedef struct _GLFWwindow      _GLFWwindow;
 typedef struct _GLFWlibrary     _GLFWlibrary;
@@ -72,16 +109,38 @@ typedef struct _GLFWmonitor     _GLFWmonitor;
 typedef struct _GLFWcursor      _GLFWcursor;
 typedef struct _GLFWmapelement  _GLFWmapelement;
 typedef struct _GLFWmapping     _GLFWmapping;
+typedef struct _GLFWmaptransform _GLFWmaptransform;
 typedef struct _GLFWjoystick    _GLFWjoystick;
+typedef struct _GLFWhistogram   _GLFWhistogram;
+typedef struct _GLFWswaptiming  _GLFWswaptiming;
 typedef struct _GLFWtls         _GLFWtls;
 typedef struct _GLFWmutex       _GLFWmutex;
 
 typedef void (* _GLFWmakecontextcurrentfun)(_GLFWwindow*);
 typedef void (* _GLFWswapbuffersfun)(_GLFWwindow*);
 typedef void (* _GLFWswapintervalfun)(int);
-typedef int (* _GLFWextensionsupportedfun)(const char*);
+typedef const char* (* _GLFWgetextensionsfun)(void);
 typedef GLFWglproc (* _GLFWgetprocaddressfun)(const char*);
 typedef void (* _GLFWdestroycontextfun)(_GLFWwindow*);
+typedef GLFWbool (* _GLFWgetpresentationfun)(_GLFWwindow*,uint64_t*,uint64_t*,int64_t*,int64_t*);
+
+// Entry point cache entry
+//
+typedef struct _GLFWprocentry
+{
+    char*               name;
+    GLFWglproc          proc;
+} _GLFWprocentry;
+
+// Open addressing hash table of the entry points resolved from a client API
+// library, shared by every context created with that library
+//
+typedef struct _GLFWproccache
+{
+    _GLFWprocentry*     entries;
+    int                 size;
+    int                 count;
+} _GLFWproccache;
 
 #define GL_VERSION 0x1f02
 #define GL_NONE 0
@@ -230,6 +289,28 @@ typedef void (APIENTRY * PFN_vkVoidFunction)(void);
         y = t;                    \
     }
 
+// Full memory barrier, used to publish state to other threads without locks
+#if defined(_MSC_VER)
+ #define _GLFW_MEMORY_BARRIER() MemoryBarrier()
+#else
+ #define _GLFW_MEMORY_BARRIER() __sync_synchronize()
+#endif
+
+// Atomic operations on 64-bit values shared between threads, both returning
+// the previous value
+#if defined(_MSC_VER)
+ #define _GLFW_ATOMIC_EXCHANGE64(p, v) \
+    ((uint64_t) InterlockedExchange64((volatile LONG64*) (p), (LONG64) (v)))
+ #define _GLFW_ATOMIC_COMPARE_EXCHANGE64(p, c, v) \
+    ((uint64_t) InterlockedCompareExchange64((volatile LONG64*) (p), \
+                                             (LONG64) (v), (LONG64) (c)))
+#else
+ #define _GLFW_ATOMIC_EXCHANGE64(p, v) \
+    __atomic_exchange_n((p), (uint64_t) (v), __ATOMIC_SEQ_CST)
+ #define _GLFW_ATOMIC_COMPARE_EXCHANGE64(p, c, v) \
+    __sync_val_compare_and_swap((p), (uint64_t) (c), (uint64_t) (v))
+#endif
+
 // Per-thread error structure
 //
 struct _GLFWerror
@@ -339,6 +420,24 @@ struct _GLFWfbconfig
     uintptr_t   handle;
 };
 
+// The number of recent framebuffer config choices remembered by each cache
+#define _GLFW_FBCONFIG_CHOICES 8
+
+// Framebuffer configs of a context creation API translated to GLFW form, along
+// with the most recent choices made among them
+//
+struct _GLFWfbconfigcache
+{
+    _GLFWfbconfig*      configs;
+    int                 count;
+    struct {
+        uint32_t        hash;
+        _GLFWfbconfig   desired;
+        const _GLFWfbconfig* closest;
+    } choices[_GLFW_FBCONFIG_CHOICES];
+    int                 choiceCount;
+};
+
 // Context structure
 //
 struct _GLFWcontext
@@ -355,12 +454,30 @@ struct _GLFWcontext
     PFNGLGETINTEGERVPROC GetIntegerv;
     PFNGLGETSTRINGPROC  GetString;
 
+    // Open addressing hash set of the client API and platform extensions,
+    // pointing into a buffer of NUL-separated extension names
+    char*               extensionNames;
+    const char**        extensions;
+    int                 extensionSlots;
+
     _GLFWmakecontextcurrentfun  makeCurrent;
     _GLFWswapbuffersfun         swapBuffers;
     _GLFWswapintervalfun        swapInterval;
-    _GLFWextensionsupportedfun  extensionSupported;
+    _GLFWgetextensionsfun       getExtensions;
     _GLFWgetprocaddressfun      getProcAddress;
     _GLFWdestroycontextfun      destroy;
+    // Reports the number, timer value, UST and MSC of the most recent swap
+    // to be presented, or NULL if the context API has no presentation feedback
+    _GLFWgetpresentationfun     getPresentation;
+    // The cache of the library that getProcAddress resolves entry points from,
+    // or NULL if they may differ between contexts
+    _GLFWproccache*             procCache;
+    // Set when the framebuffer size has or may have changed, by both the size
+    // events and the window functions that may resize the framebuffer, for
+    // context APIs that only query it when they need to reallocate buffers
+    GLFWbool            resized;
+    // The number of buffer swaps issued for the context
+    uint64_t            swaps;
 
     // This is defined in the context API's context.h
     _GLFW_PLATFORM_CONTEXT_STATE;
@@ -370,12 +487,40 @@ struct _GLFWcontext
     _GLFW_OSMESA_CONTEXT_STATE;
 };
 
+// Fixed-size log-linear histogram of 32-bit samples
+//
+struct _GLFWhistogram
+{
+    uint32_t        buckets[_GLFW_HISTOGRAM_BUCKETS];
+    uint32_t        count;
+    uint32_t        max;
+    uint64_t        sum;
+};
+
+// Timing of a single buffer swap, with timer values
+//
+struct _GLFWswaptiming
+{
+    uint64_t        frame;
+    uint64_t        start, end;
+    // The presentation time, or zero if it is not known
+    uint64_t        present;
+    int64_t         ust, msc;
+    GLFWbool        presented;
+    // The context swap count after this swap, for matching presentation
+    // feedback, or zero if no feedback is expected
+    uint64_t        swap;
+};
+
 // Window and context structure
 //
 struct _GLFWwindow
 {
     struct _GLFWwindow* next;
 
+    // Creation order, used to match windows between recording and replay
+    int                 serial;
+
     // Window settings and state
     GLFWbool            resizable;
     GLFWbool            decorated;
@@ -383,6 +528,8 @@ struct _GLFWwindow
     GLFWbool            floating;
     GLFWbool            focusOnShow;
     GLFWbool            shouldClose;
+    // Whether this object is a context without a window
+    GLFWbool            windowless;
     void*               userPointer;
     GLFWvidmode         videoMode;
     _GLFWmonitor*       monitor;
@@ -405,6 +552,48 @@ struct _GLFWwindow
 
     _GLFWcontext        context;
 
+    // Input state published for other threads, guarded by a sequence lock
+    struct {
+        volatile uint32_t   sequence;
+        GLFWinputsnapshot   state;
+    } snapshot;
+
+    // Input-to-swap latency probe, with samples in microseconds
+    struct {
+        GLFWbool        enabled;
+        // Timer value of the oldest input not yet followed by a swap, or zero,
+        // set by event processing and taken by swaps with atomic operations
+        volatile uint64_t pending;
+        // Samples added by swaps on any thread, guarded by a sequence lock
+        volatile uint32_t sequence;
+        _GLFWhistogram  histogram;
+    } latency;
+
+    // Frame-to-frame interval probe, with samples in microseconds
+    struct {
+        GLFWbool        enabled;
+        // Timer value of the previous frame, or zero
+        uint64_t        last;
+        // Moving average of the intervals, for detecting stutters
+        uint32_t        average;
+        uint32_t        stutters;
+        _GLFWhistogram  histogram;
+        // Summary published for the title hook, guarded by a sequence lock
+        volatile uint32_t sequence;
+        uint64_t        published;
+        GLFWframestats  summary;
+        // Title hook state, only accessed from the main thread
+        GLFWbool        titled;
+        uint32_t        shown;
+        char            title[256];
+    } frametime;
+
+    // Ring of the most recent buffer swaps, indexed by frame number
+    struct {
+        uint64_t        frame;
+        _GLFWswaptiming swaps[_GLFW_FRAME_TIMINGS];
+    } timing;
+
     struct {
         GLFWwindowposfun        pos;
         GLFWwindowsizefun       size;
@@ -423,6 +612,7 @@ struct _GLFWwindow
         GLFWkeyfun              key;
         GLFWcharfun             character;
         GLFWcharmodsfun         charmods;
+        GLFWtextfun             text;
         GLFWdropfun             drop;
     } callbacks;
 
@@ -465,23 +655,51 @@ struct _GLFWcursor
 };
 
 // Gamepad mapping element structure
+// The input and output range modifiers are baked into the scale and offset,
+// and the result is clamped to the output range
 //
 struct _GLFWmapelement
 {
     uint8_t         type;
     uint8_t         index;
-    int8_t          axisScale;
-    int8_t          axisOffset;
+    int8_t          minimum;
+    int8_t          maximum;
+    float           scale;
+    float           offset;
 };
 
 // Gamepad mapping structure
+// Each gamepad axis has one element for its full or positive half range and
+// one for its negative half range, which are added together
 //
 struct _GLFWmapping
 {
     char            name[128];
     char            guid[33];
     _GLFWmapelement buttons[15];
-    _GLFWmapelement axes[6];
+    _GLFWmapelement axes[6][2];
+};
+
+// Gamepad mapping compiled for a specific joystick
+// The joystick elements used by the mapping are gathered by source type, then
+// every mapping element is transformed the same way
+//
+struct _GLFWmaptransform
+{
+    int             axisCount;
+    uint8_t         axisIndices[_GLFW_MAPPING_ELEMENTS];
+    uint8_t         axisElements[_GLFW_MAPPING_ELEMENTS];
+    int             buttonCount;
+    uint8_t         buttonIndices[_GLFW_MAPPING_ELEMENTS];
+    uint8_t         buttonElements[_GLFW_MAPPING_ELEMENTS];
+    int             hatCount;
+    uint8_t         hatIndices[_GLFW_MAPPING_ELEMENTS];
+    uint8_t         hatBits[_GLFW_MAPPING_ELEMENTS];
+    uint8_t         hatElements[_GLFW_MAPPING_ELEMENTS];
+    float           scale[_GLFW_MAPPING_ELEMENTS];
+    float           offset[_GLFW_MAPPING_ELEMENTS];
+    float           minimum[_GLFW_MAPPING_ELEMENTS];
+    float           maximum[_GLFW_MAPPING_ELEMENTS];
 };
 
 // Joystick structure
@@ -498,7 +716,10 @@ struct _GLFWjoystick
     char*           name;
     void*           userPointer;
     char            guid[33];
-    _GLFWmapping*   mapping;
+    const _GLFWmapping* mapping;
+    _GLFWmaptransform transform;
+    // Device timestamp of the change being reported, in timer ticks, or zero
+    uint64_t        eventTime;
 
     // This is defined in the joystick API's joystick.h
     _GLFW_PLATFORM_JOYSTICK_STATE;
@@ -537,17 +758,40 @@ struct _GLFWlibrary
     _GLFWerror*         errorListHead;
     _GLFWcursor*        cursorListHead;
     _GLFWwindow*        windowListHead;
+    int                 windowSerial;
 
     _GLFWmonitor**      monitors;
     int                 monitorCount;
 
     _GLFWjoystick       joysticks[GLFW_JOYSTICK_LAST + 1];
+    // Joystick state published for other threads, guarded by sequence locks
+    struct {
+        volatile GLFWbool    requested;
+        volatile uint32_t    sequence;
+        GLFWbool             present;
+        GLFWjoysticksnapshot state;
+    } joystickSnapshots[GLFW_JOYSTICK_LAST + 1];
+    // Optional ring buffers of timestamped joystick changes
+    struct {
+        GLFWjoystickevent*   events;
+        int                  size;
+        int                  head;
+        int                  count;
+    } joystickEvents[GLFW_JOYSTICK_LAST + 1];
     _GLFWmapping*       mappings;
     int                 mappingCount;
+    int                 mappingCapacity;
+    // Open addressing hash table of mapping indices plus one, keyed by GUID
+    int*                mappingIndex;
+    int                 mappingIndexSize;
 
     _GLFWtls            errorSlot;
     _GLFWtls            contextSlot;
     _GLFWmutex          errorLock;
+    _GLFWmutex          procCacheLock;
+    // Guards the window list and serial, as platforms that allow it may
+    // create and destroy windows on any thread
+    _GLFWmutex          windowLock;
 
     struct {
         uint64_t        offset;
@@ -582,9 +826,25 @@ struct _GLFWlibrary
     struct {
         GLFWmonitorfun  monitor;
         GLFWjoystickfun joystick;
+        GLFWjoystickaxisfun joystickAxis;
+        GLFWjoystickbuttonfun joystickButton;
+        GLFWjoystickhatfun joystickHat;
         GLFWioeventfun  io;
     } callbacks;
 
+    struct {
+        // Set while either recording or replaying, checked by the event API
+        GLFWbool        active;
+        FILE*           file;
+        uint64_t        start;
+        unsigned char*  data;
+        size_t          size;
+        size_t          position;
+        uint32_t        frames;
+        GLFWbool        dispatching;
+        int             suspended;
+    } inputLog;
+
     // This is defined in the window API's platform.h
     _GLFW_PLATFORM_LIBRARY_WINDOW_STATE;
     // This is defined in the context API's context.h
@@ -648,6 +908,10 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
                               const _GLFWctxconfig* ctxconfig,
                               const _GLFWfbconfig* fbconfig);
 void _glfwPlatformDestroyWindow(_GLFWwindow* window);
+int _glfwPlatformCreateContext(_GLFWwindow* window,
+                               const _GLFWctxconfig* ctxconfig,
+                               const _GLFWfbconfig* fbconfig);
+void _glfwPlatformDestroyContext(_GLFWwindow* window);
 void _glfwPlatformSetWindowTitle(_GLFWwindow* window, const char* title);
 void _glfwPlatformSetWindowIcon(_GLFWwindow* window,
                                 int count, const GLFWimage* images);
@@ -726,12 +990,15 @@ void _glfwInputWindowIconify(_GLFWwindow* window, GLFWbool iconified);
 void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized);
 void _glfwInputWindowDamage(_GLFWwindow* window);
 void _glfwInputWindowCloseRequest(_GLFWwindow* window);
+void _glfwInputWindowCloseRequestAll(void);
 void _glfwInputWindowMonitor(_GLFWwindow* window, _GLFWmonitor* monitor);
 
 void _glfwInputKey(_GLFWwindow* window,
                    int key, int scancode, int action, int mods);
 void _glfwInputChar(_GLFWwindow* window,
                     unsigned int codepoint, int mods, GLFWbool plain);
+void _glfwInputText(_GLFWwindow* window,
+                    const char* text, int mods, GLFWbool plain);
 void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset);
 void _glfwInputMulitouchEvents(_GLFWwindow* window, GLFWinputEvent* events, int eventCount, int mods);
 void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods);
@@ -743,6 +1010,8 @@ void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value);
 void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value);
 void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value);
 
+GLFWbool _glfwRecordInput(int type, int target, const void* data);
+
 void _glfwInputMonitor(_GLFWmonitor* monitor, int action, int placement);
 void _glfwInputMonitorWindow(_GLFWmonitor* monitor, _GLFWwindow* window);
 
@@ -762,9 +1031,14 @@ GLFWbool _glfwStringInExtensionString(const char* string, const char* extensions
 const _GLFWfbconfig* _glfwChooseFBConfig(const _GLFWfbconfig* desired,
                                          const _GLFWfbconfig* alternatives,
                                          unsigned int count);
+_GLFWfbconfigcache* _glfwCreateFBConfigCache(_GLFWfbconfig* configs, int count);
+void _glfwFreeFBConfigCache(_GLFWfbconfigcache* cache);
+const _GLFWfbconfig* _glfwChooseCachedFBConfig(_GLFWfbconfigcache* cache,
+                                               const _GLFWfbconfig* desired);
 GLFWbool _glfwRefreshContextAttribs(_GLFWwindow* window,
                                     const _GLFWctxconfig* ctxconfig);
 GLFWbool _glfwIsValidContextConfig(const _GLFWctxconfig* ctxconfig);
+void _glfwFreeProcCache(_GLFWproccache* cache);
 
 const GLFWvidmode* _glfwChooseVideoMode(_GLFWmonitor* monitor,
                                         const GLFWvidmode* desired);
@@ -781,12 +1055,31 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
                                   int buttonCount,
                                   int hatCount);
 void _glfwFreeJoystick(_GLFWjoystick* js);
+void _glfwUpdateInputLog(void);
+void _glfwCloseInputLog(void);
+void _glfwPublishInputSnapshots(void);
 void _glfwCenterCursorInContentArea(_GLFWwindow* window);
 
 GLFWbool _glfwInitVulkan(int mode);
 void _glfwTerminateVulkan(void);
 const char* _glfwGetVulkanResultString(VkResult result);
 
+uint32_t _glfwHashBytes(const void* data, size_t size);
+uint32_t _glfwHashString(const char* string);
+
+void _glfwHistogramAdd(_GLFWhistogram* histogram, uint64_t value);
+uint32_t _glfwHistogramPercentile(const _GLFWhistogram* histogram,
+                                  double fraction);
+void _glfwHistogramSummary(const _GLFWhistogram* histogram,
+                           unsigned int* count, double* mean,
+                           double* p50, double* p95, double* p99, double* max);
+void _glfwProbeFrameSubmitted(_GLFWwindow* window);
+void _glfwRecordSwap(_GLFWwindow* window, uint64_t start);
+void _glfwUpdateFrameTimeTitles(void);
+
+size_t _glfwEncodeUTF8(char* s, unsigned int codepoint);
+unsigned int _glfwDecodeUTF8(const char** s);
+
 char* _glfw_strdup(const char* source);
 float _glfw_fminf(float a, float b);
 float _glfw_fmaxf(float a, float b);
@@ -32,26 +32,47 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/inotify.h>
+#include <sys/eventfd.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <errno.h>
+#include <time.h>
 #include <dirent.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
+// Number of input events read from a device per system call
+#define _GLFW_EVDEV_BATCH_SIZE 64
+
+#ifndef input_event_sec // < v4.16 kernel headers
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
+
 #ifndef SYN_DROPPED // < v2.6.39 kernel headers
 // Workaround for CentOS-6, which is supported till 2020-11-30, but still on v2.6.32
 #define SYN_DROPPED 3
 #endif
 
+#define isBitSet(bit, arr) (arr[(bit) / 8] & (1 << ((bit) % 8)))
+
 // Apply an EV_KEY event to the specified joystick
 //
 static void handleKeyEvent(_GLFWjoystick* js, int code, int value)
 {
-    _glfwInputJoystickButton(js,
-                             js->linjs.keyMap[code - BTN_MISC],
-                             value ? GLFW_PRESS : GLFW_RELEASE);
+    int index;
+
+    if (code < BTN_MISC || code >= KEY_CNT)
+        return;
+
+    // Keys that are not mapped to a button have a negative index
+    index = js->linjs.keyMap[code - BTN_MISC];
+    if (index < 0)
+        return;
+
+    _glfwInputJoystickButton(js, index, value ? GLFW_PRESS : GLFW_RELEASE);
 }
 
 // Apply an EV_ABS event to the specified joystick
@@ -120,23 +141,35 @@ static void pollAbsState(_GLFWjoystick* js)
     }
 }
 
-#define isBitSet(bit, arr) (arr[(bit) / 8] & (1 << ((bit) % 8)))
-
-// Attempt to open the specified joystick device
+// Poll state of buttons
 //
-static GLFWbool openJoystickDevice(const char* path)
+static void pollKeyState(_GLFWjoystick* js)
 {
-    for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    char keyBits[(KEY_CNT + 7) / 8] = {0};
+
+    if (ioctl(js->linjs.fd, EVIOCGKEY(sizeof(keyBits)), keyBits) < 0)
+        return;
+
+    for (int code = BTN_MISC;  code < KEY_CNT;  code++)
     {
-        if (!_glfw.joysticks[jid].present)
+        const int index = js->linjs.keyMap[code - BTN_MISC];
+        if (index < 0)
             continue;
-        if (strcmp(_glfw.joysticks[jid].linjs.path, path) == 0)
-            return GLFW_FALSE;
+
+        _glfwInputJoystickButton(js, index,
+                                 isBitSet(code, keyBits) ? GLFW_PRESS : GLFW_RELEASE);
     }
+}
+
+// Queries the device at the path of the specified probe
+// This runs on the probe thread and must not touch any other library state
+//
+static GLFWbool probeJoystickDevice(_GLFWprobeLinux* probe)
+{
+    _GLFWjoystickLinux* linjs = &probe->linjs;
 
-    _GLFWjoystickLinux linjs = {0};
-    linjs.fd = open(path, O_RDONLY | O_NONBLOCK);
-    if (linjs.fd == -1)
+    linjs->fd = open(linjs->path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (linjs->fd == -1)
         return GLFW_FALSE;
 
     char evBits[(EV_CNT + 7) / 8] = {0};
@@ -144,31 +177,34 @@ static GLFWbool openJoystickDevice(const char* path)
     char absBits[(ABS_CNT + 7) / 8] = {0};
     struct input_id id;
 
-    if (ioctl(linjs.fd, EVIOCGBIT(0, sizeof(evBits)), evBits) < 0 ||
-        ioctl(linjs.fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0 ||
-        ioctl(linjs.fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits) < 0 ||
-        ioctl(linjs.fd, EVIOCGID, &id) < 0)
+    if (ioctl(linjs->fd, EVIOCGBIT(0, sizeof(evBits)), evBits) < 0 ||
+        ioctl(linjs->fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0 ||
+        ioctl(linjs->fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits) < 0 ||
+        ioctl(linjs->fd, EVIOCGID, &id) < 0)
     {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Linux: Failed to query input device: %s",
-                        strerror(errno));
-        close(linjs.fd);
+        // The error is reported when the main thread collects the probe
+        probe->error = errno;
+        close(linjs->fd);
         return GLFW_FALSE;
     }
 
     // Ensure this device supports the events expected of a joystick
     if (!isBitSet(EV_KEY, evBits) || !isBitSet(EV_ABS, evBits))
     {
-        close(linjs.fd);
+        close(linjs->fd);
         return GLFW_FALSE;
     }
 
-    char name[256] = "";
+    // Have the kernel timestamp events with the clock used by the GLFW timer
+    const int clock = _glfw.timer.posix.monotonic ? CLOCK_MONOTONIC : CLOCK_REALTIME;
+    linjs->timestamps = ioctl(linjs->fd, EVIOCSCLOCKID, &clock) == 0;
+
+    char* name = probe->name;
 
-    if (ioctl(linjs.fd, EVIOCGNAME(sizeof(name)), name) < 0)
-        strncpy(name, "Unknown", sizeof(name));
+    if (ioctl(linjs->fd, EVIOCGNAME(sizeof(probe->name)), name) < 0)
+        strncpy(name, "Unknown", sizeof(probe->name));
 
-    char guid[33] = "";
+    char* guid = probe->guid;
 
     // Generate a joystick GUID that matches the SDL 2.0.5+ one
     if (id.vendor && id.product && id.version)
@@ -188,55 +224,98 @@ static GLFWbool openJoystickDevice(const char* path)
                 name[8], name[9], name[10]);
     }
 
-    int axisCount = 0, buttonCount = 0, hatCount = 0;
-
     for (int code = BTN_MISC;  code < KEY_CNT;  code++)
     {
+        linjs->keyMap[code - BTN_MISC] = -1;
         if (!isBitSet(code, keyBits))
             continue;
 
-        linjs.keyMap[code - BTN_MISC] = buttonCount;
-        buttonCount++;
+        linjs->keyMap[code - BTN_MISC] = probe->buttonCount;
+        probe->buttonCount++;
     }
 
     for (int code = 0;  code < ABS_CNT;  code++)
     {
-        linjs.absMap[code] = -1;
+        linjs->absMap[code] = -1;
         if (!isBitSet(code, absBits))
             continue;
 
         if (code >= ABS_HAT0X && code <= ABS_HAT3Y)
         {
-            linjs.absMap[code] = hatCount;
-            hatCount++;
+            // Both axes of a hat report to the same hat index
+            linjs->absMap[code] = probe->hatCount;
+            linjs->absMap[code + 1] = probe->hatCount;
+            probe->hatCount++;
             // Skip the Y axis
             code++;
         }
         else
         {
-            if (ioctl(linjs.fd, EVIOCGABS(code), &linjs.absInfo[code]) < 0)
+            if (ioctl(linjs->fd, EVIOCGABS(code), &linjs->absInfo[code]) < 0)
                 continue;
 
-            linjs.absMap[code] = axisCount;
-            axisCount++;
+            linjs->absMap[code] = probe->axisCount;
+            probe->axisCount++;
         }
     }
 
-    _GLFWjoystick* js =
-        _glfwAllocJoystick(name, guid, axisCount, buttonCount, hatCount);
+    return GLFW_TRUE;
+}
+
+// Returns whether a joystick is already open for the specified device
+//
+static GLFWbool isJoystickDeviceOpen(const char* path)
+{
+    for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (!_glfw.joysticks[jid].present)
+            continue;
+        if (strcmp(_glfw.joysticks[jid].linjs.path, path) == 0)
+            return GLFW_TRUE;
+    }
+
+    return GLFW_FALSE;
+}
+
+// Connects a joystick for a successfully probed device and frees the probe
+//
+static void connectJoystickDevice(_GLFWprobeLinux* probe)
+{
+    // The device may have been opened since the probe was queued
+    if (isJoystickDeviceOpen(probe->linjs.path))
+    {
+        close(probe->linjs.fd);
+        free(probe);
+        return;
+    }
+
+    _GLFWjoystick* js = _glfwAllocJoystick(probe->name, probe->guid,
+                                           probe->axisCount,
+                                           probe->buttonCount,
+                                           probe->hatCount);
     if (!js)
     {
-        close(linjs.fd);
-        return GLFW_FALSE;
+        close(probe->linjs.fd);
+        free(probe);
+        return;
+    }
+
+    // Let the event loop wake up and drain the device as soon as it has input
+    if (!glfwEventAddFD(probe->linjs.fd, GLFW_IO_READ))
+    {
+        _glfwFreeJoystick(js);
+        close(probe->linjs.fd);
+        free(probe);
+        return;
     }
 
-    strncpy(linjs.path, path, sizeof(linjs.path) - 1);
-    memcpy(&js->linjs, &linjs, sizeof(linjs));
+    memcpy(&js->linjs, &probe->linjs, sizeof(probe->linjs));
+    free(probe);
 
+    pollKeyState(js);
     pollAbsState(js);
 
     _glfwInputJoystick(js, GLFW_CONNECTED);
-    return GLFW_TRUE;
 }
 
 #undef isBitSet
@@ -245,18 +324,227 @@ static GLFWbool openJoystickDevice(const char* path)
 //
 static void closeJoystick(_GLFWjoystick* js)
 {
+    glfwEventDelFD(js->linjs.fd, GLFW_IO_READ);
     close(js->linjs.fd);
     _glfwFreeJoystick(js);
     _glfwInputJoystick(js, GLFW_DISCONNECTED);
 }
 
-// Lexically compare joysticks by name; used by qsort
+// Probe thread entry point; queries queued devices until told to stop
+//
+static void* probeThreadMain(void* arg)
+{
+    pthread_mutex_lock(&_glfw.linjs.lock);
+
+    for (;;)
+    {
+        while (!_glfw.linjs.requests && !_glfw.linjs.stopping)
+            pthread_cond_wait(&_glfw.linjs.cond, &_glfw.linjs.lock);
+
+        if (_glfw.linjs.stopping)
+            break;
+
+        _GLFWprobeLinux* probe = _glfw.linjs.requests;
+        _glfw.linjs.requests = probe->next;
+        probe->next = NULL;
+
+        // Do the device I/O without holding the lock
+        pthread_mutex_unlock(&_glfw.linjs.lock);
+        const GLFWbool found = probeJoystickDevice(probe);
+        pthread_mutex_lock(&_glfw.linjs.lock);
+
+        if (!found && !probe->error)
+        {
+            free(probe);
+            continue;
+        }
+
+        probe->found = found;
+        *_glfw.linjs.resultTail = probe;
+        _glfw.linjs.resultTail = &probe->next;
+
+        // Wake up the event loop so it can connect the joystick
+        const uint64_t one = 1;
+        ssize_t result;
+        do
+        {
+            result = write(_glfw.linjs.wakeup, &one, sizeof(one));
+        } while (result < 0 && errno == EINTR);
+    }
+
+    pthread_mutex_unlock(&_glfw.linjs.lock);
+    return NULL;
+}
+
+// Queues the specified device for probing
+// Without a probe thread the device is probed and connected immediately
+//
+static void queueJoystickDevice(const char* path)
+{
+    if (isJoystickDeviceOpen(path))
+        return;
+
+    _GLFWprobeLinux* probe = calloc(1, sizeof(_GLFWprobeLinux));
+    if (!probe)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return;
+    }
+
+    strncpy(probe->linjs.path, path, sizeof(probe->linjs.path) - 1);
+
+    if (!_glfw.linjs.threaded)
+    {
+        if (probeJoystickDevice(probe))
+            connectJoystickDevice(probe);
+        else
+        {
+            if (probe->error)
+            {
+                _glfwInputError(GLFW_PLATFORM_ERROR,
+                                "Linux: Failed to query input device: %s",
+                                strerror(probe->error));
+            }
+
+            free(probe);
+        }
+
+        return;
+    }
+
+    pthread_mutex_lock(&_glfw.linjs.lock);
+
+    _GLFWprobeLinux** tail = &_glfw.linjs.requests;
+    while (*tail)
+    {
+        // Coalesce the IN_CREATE and IN_ATTRIB events of the same device
+        if (strcmp((*tail)->linjs.path, probe->linjs.path) == 0)
+        {
+            pthread_mutex_unlock(&_glfw.linjs.lock);
+            free(probe);
+            return;
+        }
+
+        tail = &(*tail)->next;
+    }
+
+    *tail = probe;
+    pthread_cond_signal(&_glfw.linjs.cond);
+    pthread_mutex_unlock(&_glfw.linjs.lock);
+}
+
+// Connects the joysticks for all devices the probe thread has finished with
+//
+static void collectJoystickDevices(void)
+{
+    if (!_glfw.linjs.threaded)
+        return;
+
+    // Reset the wakeup counter; the list is checked even if nothing was posted
+    uint64_t count;
+    ssize_t result;
+    do
+    {
+        result = read(_glfw.linjs.wakeup, &count, sizeof(count));
+    } while (result < 0 && errno == EINTR);
+
+    pthread_mutex_lock(&_glfw.linjs.lock);
+    _GLFWprobeLinux* probe = _glfw.linjs.results;
+    _glfw.linjs.results = NULL;
+    _glfw.linjs.resultTail = &_glfw.linjs.results;
+    pthread_mutex_unlock(&_glfw.linjs.lock);
+
+    while (probe)
+    {
+        _GLFWprobeLinux* next = probe->next;
+
+        if (probe->found)
+            connectJoystickDevice(probe);
+        else
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Linux: Failed to query input device: %s",
+                            strerror(probe->error));
+            free(probe);
+        }
+
+        probe = next;
+    }
+}
+
+// Starts the probe thread, returning false if devices must be probed inline
+//
+static GLFWbool startProbeThread(void)
+{
+    _glfw.linjs.resultTail = &_glfw.linjs.results;
+
+    _glfw.linjs.wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_glfw.linjs.wakeup == -1)
+        return GLFW_FALSE;
+
+    if (!glfwEventAddFD(_glfw.linjs.wakeup, GLFW_IO_READ))
+    {
+        close(_glfw.linjs.wakeup);
+        _glfw.linjs.wakeup = -1;
+        return GLFW_FALSE;
+    }
+
+    pthread_mutex_init(&_glfw.linjs.lock, NULL);
+    pthread_cond_init(&_glfw.linjs.cond, NULL);
+
+    if (pthread_create(&_glfw.linjs.thread, NULL, probeThreadMain, NULL) != 0)
+    {
+        pthread_cond_destroy(&_glfw.linjs.cond);
+        pthread_mutex_destroy(&_glfw.linjs.lock);
+        glfwEventDelFD(_glfw.linjs.wakeup, GLFW_IO_READ);
+        close(_glfw.linjs.wakeup);
+        _glfw.linjs.wakeup = -1;
+        return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Stops the probe thread and discards any unfinished probes
+//
+static void stopProbeThread(void)
+{
+    pthread_mutex_lock(&_glfw.linjs.lock);
+    _glfw.linjs.stopping = GLFW_TRUE;
+    pthread_cond_signal(&_glfw.linjs.cond);
+    pthread_mutex_unlock(&_glfw.linjs.lock);
+
+    pthread_join(_glfw.linjs.thread, NULL);
+
+    while (_glfw.linjs.requests)
+    {
+        _GLFWprobeLinux* probe = _glfw.linjs.requests;
+        _glfw.linjs.requests = probe->next;
+        free(probe);
+    }
+
+    while (_glfw.linjs.results)
+    {
+        _GLFWprobeLinux* probe = _glfw.linjs.results;
+        _glfw.linjs.results = probe->next;
+        if (probe->found)
+            close(probe->linjs.fd);
+        free(probe);
+    }
+
+    pthread_cond_destroy(&_glfw.linjs.cond);
+    pthread_mutex_destroy(&_glfw.linjs.lock);
+
+    glfwEventDelFD(_glfw.linjs.wakeup, GLFW_IO_READ);
+    close(_glfw.linjs.wakeup);
+    _glfw.linjs.wakeup = -1;
+}
+
+// Lexically compare device paths; used by qsort
 //
-static int compareJoysticks(const void* fp, const void* sp)
+static int compareDevicePaths(const void* fp, const void* sp)
 {
-    const _GLFWjoystick* fj = fp;
-    const _GLFWjoystick* sj = sp;
-    return strcmp(fj->linjs.path, sj->linjs.path);
+    return strcmp(*(const char* const*) fp, *(const char* const*) sp);
 }
 
 
@@ -296,7 +584,11 @@ GLFWbool _glfwInitJoysticksLinux(void)
         return GLFW_FALSE;
     }
 
-    int count = 0;
+    // Continue probing devices inline if the probe thread cannot be started
+    _glfw.linjs.threaded = startProbeThread();
+
+    char** paths = NULL;
+    int count = 0, capacity = 0;
 
     DIR* dir = opendir(dirname);
     if (dir)
@@ -310,11 +602,21 @@ GLFWbool _glfwInitJoysticksLinux(void)
             if (regexec(&_glfw.linjs.regex, entry->d_name, 1, &match, 0) != 0)
                 continue;
 
+            if (count == capacity)
+            {
+                capacity = capacity ? capacity * 2 : 32;
+                char** larger = realloc(paths, capacity * sizeof(char*));
+                if (!larger)
+                    break;
+
+                paths = larger;
+            }
+
             char path[PATH_MAX];
 
             snprintf(path, sizeof(path), "%s/%s", dirname, entry->d_name);
-
-            if (openJoystickDevice(path))
+            paths[count] = _glfw_strdup(path);
+            if (paths[count])
                 count++;
         }
 
@@ -323,7 +625,17 @@ GLFWbool _glfwInitJoysticksLinux(void)
 
     // Continue with no joysticks if enumeration fails
 
-    qsort(_glfw.joysticks, count, sizeof(_GLFWjoystick), compareJoysticks);
+    // Queue devices in path order so that joystick IDs follow it
+    if (count)
+        qsort(paths, count, sizeof(char*), compareDevicePaths);
+
+    for (int i = 0;  i < count;  i++)
+    {
+        queueJoystickDevice(paths[i]);
+        free(paths[i]);
+    }
+
+    free(paths);
     return GLFW_TRUE;
 }
 
@@ -333,6 +645,9 @@ void _glfwTerminateJoysticksLinux(void)
 {
     int jid;
 
+    if (_glfw.linjs.threaded)
+        stopProbeThread();
+
     for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
     {
         _GLFWjoystick* js = _glfw.joysticks + jid;
@@ -357,6 +672,8 @@ void _glfwTerminateJoysticksLinux(void)
 
 void _glfwDetectJoystickConnectionLinux(void)
 {
+    collectJoystickDevices();
+
     if (_glfw.linjs.inotify <= 0)
         return;
 
@@ -378,7 +695,7 @@ void _glfwDetectJoystickConnectionLinux(void)
         snprintf(path, sizeof(path), "/dev/input/%s", e->name);
 
         if (e->mask & (IN_CREATE | IN_ATTRIB))
-            openJoystickDevice(path);
+            queueJoystickDevice(path);
         else if (e->mask & IN_DELETE)
         {
             for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
@@ -393,6 +710,29 @@ void _glfwDetectJoystickConnectionLinux(void)
     }
 }
 
+// Drains the joystick device with the specified file descriptor, if any
+//
+GLFWbool _glfwHandleJoystickFDLinux(int fd)
+{
+    if (_glfw.linjs.threaded && fd == _glfw.linjs.wakeup)
+    {
+        collectJoystickDevices();
+        return GLFW_TRUE;
+    }
+
+    for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        _GLFWjoystick* js = _glfw.joysticks + jid;
+        if (!js->present || js->linjs.fd != fd)
+            continue;
+
+        _glfwPlatformPollJoystick(js, _GLFW_POLL_ALL);
+        return GLFW_TRUE;
+    }
+
+    return GLFW_FALSE;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -400,13 +740,14 @@ void _glfwDetectJoystickConnectionLinux(void)
 
 int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode)
 {
-    // Read all queued events (non-blocking)
+    // Read all queued events (non-blocking), as many as fit per system call
     for (;;)
     {
-        struct input_event e;
+        struct input_event events[_GLFW_EVDEV_BATCH_SIZE];
 
         errno = 0;
-        if (read(js->linjs.fd, &e, sizeof(e)) < 0)
+        const ssize_t size = read(js->linjs.fd, events, sizeof(events));
+        if (size < 0)
         {
             // Reset the joystick slot if the device was disconnected
             if (errno == ENODEV)
@@ -415,26 +756,58 @@ int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode)
             break;
         }
 
-        if (e.type == EV_SYN)
+        const int count = (int) (size / sizeof(events[0]));
+
+        for (int i = 0;  i < count;  i++)
         {
-            if (e.code == SYN_DROPPED)
-                _glfw.linjs.dropped = GLFW_TRUE;
-            else if (e.code == SYN_REPORT)
+            const struct input_event* e = events + i;
+
+            if (js->linjs.timestamps)
             {
-                _glfw.linjs.dropped = GLFW_FALSE;
-                pollAbsState(js);
+                js->eventTime =
+                    (uint64_t) e->input_event_sec * _glfw.timer.posix.frequency +
+                    (uint64_t) e->input_event_usec * (_glfw.timer.posix.frequency / 1000000);
             }
-        }
 
-        if (_glfw.linjs.dropped)
-            continue;
+            if (e->type == EV_SYN)
+            {
+                if (e->code == SYN_DROPPED)
+                    js->linjs.dropped = GLFW_TRUE;
+                else if (e->code == SYN_REPORT && js->linjs.dropped)
+                {
+                    // The kernel discarded events for this device, so query
+                    // its current state instead of replaying the stream
+                    js->linjs.dropped = GLFW_FALSE;
+                    pollKeyState(js);
+                    pollAbsState(js);
+
+                    // The rest of this batch is older than the queried state
+                    // and EVIOCGKEY has flushed the key events that followed
+                    // it from the kernel queue, so applying it would leave
+                    // stale buttons behind
+                    break;
+                }
+
+                continue;
+            }
+
+            // Events up to the next report are incomplete after a drop
+            if (js->linjs.dropped)
+                continue;
 
-        if (e.type == EV_KEY)
-            handleKeyEvent(js, e.code, e.value);
-        else if (e.type == EV_ABS)
-            handleAbsEvent(js, e.code, e.value);
+            if (e->type == EV_KEY)
+                handleKeyEvent(js, e->code, e->value);
+            else if (e->type == EV_ABS)
+                handleAbsEvent(js, e->code, e->value);
+        }
+
+        // A short read means the kernel queue is empty, so skip the final
+        // read that would only return EAGAIN
+        if (count < _GLFW_EVDEV_BATCH_SIZE)
+            break;
     }
 
+    js->eventTime = 0;
     return js->present;
 }
 
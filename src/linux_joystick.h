@@ -27,6 +27,7 @@
 #include <linux/input.h>
 #include <linux/limits.h>
 #include <regex.h>
+#include <pthread.h>
 
 #define _GLFW_PLATFORM_JOYSTICK_STATE         _GLFWjoystickLinux linjs
 #define _GLFW_PLATFORM_LIBRARY_JOYSTICK_STATE _GLFWlibraryLinux  linjs
@@ -43,8 +44,25 @@ typedef struct _GLFWjoystickLinux
     int                     absMap[ABS_CNT];
     struct input_absinfo    absInfo[ABS_CNT];
     int                     hats[4][2];
+    GLFWbool                dropped;
+    GLFWbool                timestamps;
 } _GLFWjoystickLinux;
 
+// Device queued for or finished by the joystick probe thread
+//
+typedef struct _GLFWprobeLinux
+{
+    _GLFWjoystickLinux      linjs;
+    char                    name[256];
+    char                    guid[33];
+    int                     axisCount;
+    int                     buttonCount;
+    int                     hatCount;
+    GLFWbool                found;
+    int                     error;
+    struct _GLFWprobeLinux* next;
+} _GLFWprobeLinux;
+
 // Linux-specific joystick API data
 //
 typedef struct _GLFWlibraryLinux
@@ -52,11 +70,21 @@ typedef struct _GLFWlibraryLinux
     int                     inotify;
     int                     watch;
     regex_t                 regex;
-    GLFWbool                dropped;
+    // Device probing is done on a separate thread when available
+    GLFWbool                threaded;
+    pthread_t               thread;
+    pthread_mutex_t         lock;
+    pthread_cond_t          cond;
+    GLFWbool                stopping;
+    int                     wakeup;
+    _GLFWprobeLinux*        requests;
+    _GLFWprobeLinux*        results;
+    _GLFWprobeLinux**       resultTail;
 } _GLFWlibraryLinux;
 
 
 GLFWbool _glfwInitJoysticksLinux(void);
 void _glfwTerminateJoysticksLinux(void);
 void _glfwDetectJoystickConnectionLinux(void);
+GLFWbool _glfwHandleJoystickFDLinux(int fd);
 
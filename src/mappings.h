@@ -25,10 +25,11 @@
 //========================================================================
 // As mappings.h.in, this file is used by CMake to produce the mappings.h
 // header file.  If you are adding a GLFW specific gamepad mapping, this is
-// where to put it.
+// where to put it, in the list of GLFW specific mappings below.
 //========================================================================
 // As mappings.h, this provides all pre-defined gamepad mappings, including
-// all available in SDL_GameControllerDB.  Do not edit this file.  Any gamepad
+// all available in SDL_GameControllerDB, already parsed into tables of
+// _GLFWmapping structs for each platform.  Do not edit this file.  Any gamepad
 // mappings not specific to GLFW should be submitted to SDL_GameControllerDB.
 // This file can be re-generated from mappings.h.in and the upstream
 // gamecontrollerdb.txt with the GenerateMappings.cmake script.
@@ -58,419 +59,1252 @@
 //
 // 3. This notice may not be removed or altered from any source distribution.
 
-const char* _glfwDefaultMappings[] =
-{
-"03000000fa2d00000100000000000000,3DRUDDER,leftx:a0,lefty:a1,rightx:a5,righty:a2,platform:Windows,",
-"03000000022000000090000000000000,8Bitdo NES30 Pro,a:b1,b:b0,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b13,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:b9,rightx:a3,righty:a4,start:b11,x:b4,y:b3,platform:Windows,",
-"03000000203800000900000000000000,8Bitdo NES30 Pro,a:b1,b:b0,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b13,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:b9,rightx:a3,righty:a4,start:b11,x:b4,y:b3,platform:Windows,",
-"03000000102800000900000000000000,8Bitdo SFC30 GamePad,a:b1,b:b0,back:b10,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b11,x:b4,y:b3,platform:Windows,",
-"03000000a00500003232000000000000,8Bitdo Zero GamePad,a:b0,b:b1,back:b10,dpdown:+a2,dpleft:-a0,dpright:+a0,dpup:-a2,leftshoulder:b6,rightshoulder:b7,start:b11,x:b3,y:b4,platform:Windows,",
-"030000008f0e00001200000000000000,Acme,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b2,y:b3,platform:Windows,",
-"03000000341a00003608000000000000,Afterglow PS3 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000c01100001352000000000000,Battalife Joystick,a:b6,b:b7,back:b2,leftshoulder:b0,leftx:a0,lefty:a1,rightshoulder:b1,start:b3,x:b4,y:b5,platform:Windows,",
-"030000006b1400000055000000000000,bigben ps3padstreetnew,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Windows,",
-"0300000066f700000500000000000000,BrutalLegendTest,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000d81d00000b00000000000000,BUFFALO BSGP1601 Series ,a:b5,b:b3,back:b12,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b8,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b9,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b13,x:b4,y:b2,platform:Windows,",
-"03000000e82000006058000000000000,Cideko AK08b,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b3,y:b0,platform:Windows,",
-"030000005e0400008e02000000000000,Controller (XBOX 360 For Windows),a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b8,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:a2,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Windows,",
-"03000000260900008888000000000000,Cyber Gadget GameCube Controller,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,lefttrigger:a5,leftx:a0,lefty:a1,rightshoulder:b6,righttrigger:a4,rightx:a2,righty:a3~,start:b7,x:b2,y:b3,platform:Windows,",
-"03000000a306000022f6000000000000,Cyborg V.3 Rumble Pad,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:+a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:-a3,rightx:a2,righty:a4,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000791d00000103000000000000,Dual Box WII,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b6,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:b5,rightx:a2,righty:a3,start:b9,x:b3,y:b0,platform:Windows,",
-"030000004f04000023b3000000000000,Dual Trigger 3-in-1,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000341a00000108000000000000,EXEQ RF USB Gamepad 8206,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b8,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Windows,",
-"030000000d0f00008500000000000000,Fighting Commander 2016 PS3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00008400000000000000,Fighting Commander 5,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00008800000000000000,Fighting Stick mini 4,a:b1,b:b2,back:b9,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,rightshoulder:b5,righttrigger:b7,start:b8,x:b0,y:b3,platform:Windows,",
-"030000000d0f00008700000000000000,Fighting Stick mini 4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,rightshoulder:b5,righttrigger:b7,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00002700000000000000,FIGHTING STICK V3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,rightshoulder:b5,righttrigger:b7,start:b9,x:b0,y:b3,platform:Windows,",
-"78696e70757403000000000000000000,Fightstick TES,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,lefttrigger:a2,rightshoulder:b5,righttrigger:a5,start:b7,x:b2,y:b3,platform:Windows,",
-"03000000260900002625000000000000,Gamecube Controller,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b6,lefttrigger:a4,leftx:a0,lefty:a1,righttrigger:a5,rightx:a2,righty:a3,start:b7,x:b2,y:b3,platform:Windows,",
-"030000008f0e00000d31000000000000,GAMEPAD 3 TURBO,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000280400000140000000000000,GamePad Pro USB,a:b1,b:b2,back:b8,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000ffff00000000000000000000,GameStop Gamepad,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Windows,",
-"03000000451300000010000000000000,Generic USB Joystick,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Windows,",
-"03000000341a00000302000000000000,Hama Scorpad,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00004900000000000000,Hatsune Miku Sho Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000d81400000862000000000000,HitBox Edition Cthulhu+,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b5,lefttrigger:b4,rightshoulder:b7,righttrigger:b6,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00005f00000000000000,Hori Fighting Commander 4 (PS3),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00005e00000000000000,Hori Fighting Commander 4 (PS4),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00004000000000000000,Hori Fighting Stick Mini 3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b5,lefttrigger:b4,rightshoulder:b7,righttrigger:b6,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00006e00000000000000,HORIPAD 4 (PS3),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00006600000000000000,HORIPAD 4 (PS4),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f0000ee00000000000000,HORIPAD mini4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00004d00000000000000,HORIPAD3 A,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000250900000017000000000000,HRAP2 on PS/SS/N64 Joypad to USB BOX,a:b2,b:b1,back:b9,leftshoulder:b5,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:b6,start:b8,x:b3,y:b0,platform:Windows,",
-"030000008f0e00001330000000000000,HuiJia SNES Controller,a:b2,b:b1,back:b8,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b6,rightshoulder:b7,start:b9,x:b3,y:b0,platform:Windows,",
-"03000000d81d00000f00000000000000,iBUFFALO BSGP1204 Series,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a2,righty:a3,start:b9,x:b3,y:b0,platform:Windows,",
-"03000000d81d00001000000000000000,iBUFFALO BSGP1204P Series,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a2,righty:a3,start:b9,x:b3,y:b0,platform:Windows,",
-"03000000830500006020000000000000,iBuffalo SNES Controller,a:b1,b:b0,back:b6,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b4,rightshoulder:b5,start:b7,x:b3,y:b2,platform:Windows,",
-"03000000b50700001403000000000000,IMPACT BLACK,a:b2,b:b3,back:b8,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b0,y:b1,platform:Windows,",
-"030000006f0e00002401000000000000,INJUSTICE FightStick for PS3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,rightshoulder:b5,righttrigger:b7,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000491900000204000000000000,Ipega PG-9023,a:b0,b:b1,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b13,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:b9,rightx:a3,righty:a4,start:b11,x:b3,y:b4,platform:Windows,",
-"030000006d04000011c2000000000000,Logitech Cordless Wingman,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b9,leftstick:b5,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b10,rightstick:b2,righttrigger:b7,rightx:a3,righty:a4,x:b4,platform:Windows,",
-"030000006d04000016c2000000000000,Logitech Dual Action,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000006d04000018c2000000000000,Logitech F510 Gamepad,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000006d04000019c2000000000000,Logitech F710 Gamepad,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000380700005032000000000000,Mad Catz FightPad PRO (PS3),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000380700005082000000000000,Mad Catz FightPad PRO (PS4),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000380700008433000000000000,Mad Catz FightStick TE S+ PS3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,rightshoulder:b5,righttrigger:b7,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000380700008483000000000000,Mad Catz FightStick TE S+ PS4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b6,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000380700008134000000000000,Mad Catz FightStick TE2+ PS3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b7,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b4,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000380700008184000000000000,Mad Catz FightStick TE2+ PS4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b5,leftstick:b10,lefttrigger:a4,leftx:a0,lefty:a1,rightshoulder:b4,rightstick:b11,righttrigger:b7,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000380700008034000000000000,Mad Catz TE2 PS3 Fightstick,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000380700008084000000000000,Mad Catz TE2 PS4 Fightstick,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000380700008532000000000000,Madcatz Arcade Fightstick TE S PS3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000380700003888000000000000,Madcatz Arcade Fightstick TE S+ PS3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000380700001888000000000000,MadCatz SFIV FightStick PS3,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b5,lefttrigger:b7,leftx:a0,lefty:a1,rightshoulder:b4,righttrigger:b6,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Windows,",
-"03000000380700008081000000000000,MADCATZ SFV Arcade FightStick Alpha PS4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"030000008305000031b0000000000000,MaxfireBlaze3,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Windows,",
-"03000000250900000128000000000000,Mayflash Arcade Stick,a:b1,b:b2,back:b8,leftshoulder:b0,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b3,righttrigger:b7,start:b9,x:b5,y:b6,platform:Windows,",
-"03000000790000004418000000000000,Mayflash GameCube Controller,a:b1,b:b2,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:a4,rightx:a5,righty:a2,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000790000004318000000000000,Mayflash GameCube Controller Adapter,a:b1,b:b2,back:b0,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b0,leftshoulder:b4,leftstick:b0,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b0,righttrigger:a4,rightx:a5,righty:a2,start:b9,x:b0,y:b3,platform:Windows,",
-"030000008f0e00001030000000000000,Mayflash USB Adapter for original Sega Saturn controller,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,lefttrigger:b5,rightshoulder:b2,righttrigger:b7,start:b9,x:b3,y:b4,platform:Windows,",
-"0300000025090000e803000000000000,Mayflash Wii Classic Controller,a:b1,b:b0,back:b8,dpdown:b13,dpleft:b12,dpright:b14,dpup:b11,guide:b10,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b3,y:b2,platform:Windows,",
-"03000000790000000018000000000000,Mayflash WiiU Pro Game Controller Adapter (DInput),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000001008000001e5000000000000,NEXT SNES Controller,a:b2,b:b1,back:b8,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b4,rightshoulder:b6,start:b9,x:b3,y:b0,platform:Windows,",
-"03000000bd12000015d0000000000000,Nintendo Retrolink USB Super SNES Classic Controller,a:b2,b:b1,back:b8,leftshoulder:b4,leftx:a0,lefty:a1,rightshoulder:b5,start:b9,x:b3,y:b0,platform:Windows,",
-"030000007e0500000920000000000000,Nintendo Switch Pro Controller,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Windows,",
-"030000004b120000014d000000000000,NYKO AIRFLO,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:a3,leftstick:a0,lefttrigger:b6,leftx:h0.6,lefty:h0.12,rightshoulder:b5,rightstick:a2,righttrigger:b7,rightx:h0.9,righty:h0.4,start:b9,x:b2,y:b3,platform:Windows,",
-"03000000362800000100000000000000,OUYA Game Controller,a:b0,b:b3,dpdown:b9,dpleft:b10,dpright:b11,dpup:b8,guide:b14,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:b13,rightx:a3,righty:a4,x:b1,y:b2,platform:Windows,",
-"03000000120c0000f60e000000000000,P4 Wired Gamepad,a:b1,b:b2,back:b12,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b5,lefttrigger:b7,rightshoulder:b4,righttrigger:b6,start:b9,x:b0,y:b3,platform:Windows,",
-"030000008f0e00000300000000000000,Piranha xtreme,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a3,righty:a2,start:b9,x:b3,y:b0,platform:Windows,",
-"03000000d62000006dca000000000000,PowerA Pro Ex,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000008f0e00007530000000000000,PS (R) Gamepad,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b1,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000e30500009605000000000000,PS to USB convert cable,a:b2,b:b1,back:b9,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a2,righty:a3,start:b8,x:b3,y:b0,platform:Windows,",
-"03000000100800000100000000000000,PS1 USB,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a3,righty:a2,start:b9,x:b3,y:b0,platform:Windows,",
-"03000000100800000300000000000000,PS2 USB,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a4,righty:a2,start:b9,x:b3,y:b0,platform:Windows,",
-"03000000888800000803000000000000,PS3 Controller,a:b2,b:b1,back:b8,dpdown:h0.8,dpleft:h0.4,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b9,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:b7,rightx:a3,righty:a4,start:b11,x:b0,y:b3,platform:Windows,",
-"030000004c0500006802000000000000,PS3 Controller,a:b14,b:b13,back:b0,dpdown:b6,dpleft:b7,dpright:b5,dpup:b4,guide:b16,leftshoulder:b10,leftstick:b1,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b11,rightstick:b2,righttrigger:b9,rightx:a2,righty:a3,start:b3,x:b15,y:b12,platform:Windows,",
-"03000000250900000500000000000000,PS3 DualShock,a:b2,b:b1,back:b9,dpdown:h0.8,dpleft:h0.4,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a2,righty:a3,start:b8,x:b0,y:b3,platform:Windows,",
-"03000000100000008200000000000000,PS360+ v1.66,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:h0.4,rightshoulder:b5,righttrigger:b7,start:b9,x:b0,y:b3,platform:Windows,",
-"030000004c050000a00b000000000000,PS4 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"030000004c050000c405000000000000,PS4 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"030000004c050000cc09000000000000,PS4 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000300f00000011000000000000,QanBa Arcade JoyStick 1008,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,start:b10,x:b0,y:b3,platform:Windows,",
-"03000000300f00001611000000000000,QanBa Arcade JoyStick 4018,a:b1,b:b2,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b9,leftshoulder:b4,lefttrigger:b6,rightshoulder:b5,righttrigger:b7,start:b8,x:b0,y:b3,platform:Windows,",
-"03000000222c00000020000000000000,QANBA DRONE ARCADE JOYSTICK,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:a3,rightshoulder:b5,righttrigger:a4,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000300f00001210000000000000,QanBa Joystick Plus,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,rightshoulder:b5,start:b9,x:b2,y:b3,platform:Windows,",
-"03000000341a00000104000000000000,QanBa Joystick Q4RAF,a:b5,b:b6,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b0,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b3,righttrigger:b7,start:b9,x:b1,y:b2,platform:Windows,",
-"03000000222c00000223000000000000,Qanba Obsidian Arcade Joystick PS3 Mode,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000222c00000023000000000000,Qanba Obsidian Arcade Joystick PS4 Mode,a:b1,b:b2,back:b13,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000321500000003000000000000,Razer Hydra,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b8,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:a2,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Windows,",
-"030000000d0f00001100000000000000,REAL ARCADE PRO.3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,rightshoulder:b5,rightstick:b11,righttrigger:b7,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00008b00000000000000,Real Arcade Pro.4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00008a00000000000000,Real Arcade Pro.4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00006b00000000000000,Real Arcade Pro.4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00006a00000000000000,Real Arcade Pro.4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00007000000000000000,REAL ARCADE PRO.4 VLX,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,rightshoulder:b5,rightstick:b11,righttrigger:b7,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00002200000000000000,REAL ARCADE Pro.V3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00005c00000000000000,Real Arcade Pro.V4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000000d0f00005b00000000000000,Real Arcade Pro.V4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000790000001100000000000000,Retrolink SNES Controller,a:b2,b:b1,back:b8,dpdown:+a4,dpleft:-a3,dpright:+a3,dpup:-a4,leftshoulder:b4,rightshoulder:b5,start:b9,x:b3,y:b0,platform:Windows,",
-"0300000000f000000300000000000000,RetroUSB.com RetroPad,a:b1,b:b5,back:b2,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b3,x:b0,y:b4,platform:Windows,",
-"0300000000f00000f100000000000000,RetroUSB.com Super RetroPort,a:b1,b:b5,back:b2,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b3,x:b0,y:b4,platform:Windows,",
-"030000006b140000010d000000000000,Revolution Pro Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"030000006f0e00001e01000000000000,Rock Candy Gamepad for PS3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Windows,",
-"030000004f04000003d0000000000000,run'n'drive,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b7,leftshoulder:a3,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:a4,rightstick:b11,righttrigger:b5,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000a30600001af5000000000000,Saitek Cyborg,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a3,righty:a4,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000a306000023f6000000000000,Saitek Cyborg V.1 Game pad,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a4,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000300f00001201000000000000,Saitek Dual Analog Pad,a:b2,b:b3,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b0,y:b1,platform:Windows,",
-"03000000a30600000cff000000000000,Saitek P2500 Force Rumble Pad,a:b2,b:b3,back:b11,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,leftstick:b8,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:b7,rightx:a2,righty:a3,x:b0,y:b1,platform:Windows,",
-"03000000a30600000c04000000000000,Saitek P2900,a:b1,b:b2,back:b12,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000300f00001001000000000000,Saitek P480 Rumble Pad,a:b2,b:b3,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b0,y:b1,platform:Windows,",
-"03000000a30600000b04000000000000,Saitek P990,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000a30600000b04000000010000,Saitek P990 Dual Analog Pad,a:b1,b:b2,back:b9,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b8,x:b0,y:b3,platform:Windows,",
-"03000000300f00001101000000000000,saitek rumble pad,a:b2,b:b3,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b0,y:b1,platform:Windows,",
-"0300000000050000289b000000000000,Saturn_Adapter_2.0,a:b1,b:b2,leftshoulder:b6,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:b5,start:b9,x:b0,y:b3,platform:Windows,",
-"030000009b2800000500000000000000,Saturn_Adapter_2.0,a:b1,b:b2,leftshoulder:b6,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:b5,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000341a00000208000000000000,SL-6555-SBK,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b8,lefttrigger:-a4,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:a4,rightx:a3,righty:a2,start:b7,x:b2,y:b3,platform:Windows,",
-"030000008f0e00000800000000000000,SpeedLink Strike FX Wireless,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b3,y:b0,platform:Windows,",
-"03000000ff1100003133000000000000,SVEN X-PAD,a:b2,b:b3,back:b4,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:b9,rightx:a2,righty:a4,start:b5,x:b0,y:b1,platform:Windows,",
-"03000000fa1900000706000000000000,Team 5,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b3,y:b0,platform:Windows,",
-"03000000b50700001203000000000000,Techmobility X6-38V,a:b2,b:b3,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b0,y:b1,platform:Windows,",
-"030000004f04000015b3000000000000,Thrustmaster Dual Analog 2,a:b0,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b1,y:b3,platform:Windows,",
-"030000004f04000000b3000000000000,Thrustmaster Firestorm Dual Power,a:b0,b:b2,back:b9,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b11,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b12,righttrigger:b7,rightx:a2,righty:a3,start:b10,x:b1,y:b3,platform:Windows,",
-"030000004f04000004b3000000000000,Thrustmaster Firestorm Dual Power 3,a:b0,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b1,y:b3,platform:Windows,",
-"03000000666600000488000000000000,TigerGame PS/PS2 Game Controller Adapter,a:b2,b:b1,back:b9,dpdown:b14,dpleft:b15,dpright:b13,dpup:b12,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a2,righty:a3,start:b8,x:b3,y:b0,platform:Windows,",
-"03000000d90400000200000000000000,TwinShock PS2,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a3,righty:a2,start:b9,x:b3,y:b0,platform:Windows,",
-"03000000380700006652000000000000,UnKnown,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a3,righty:a4,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000632500002305000000000000,USB Vibration Joystick (BM),a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b3,y:b0,platform:Windows,",
-"03000000790000001b18000000000000,Venom Arcade Joystick,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,rightshoulder:b5,righttrigger:b7,start:b9,x:b0,y:b3,platform:Windows,",
-"03000000450c00002043000000000000,XEOX Gamepad SL-6556-BK,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Windows,",
-"03000000172700004431000000000000,XiaoMi Game Controller,a:b0,b:b1,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b20,leftshoulder:b6,leftstick:b13,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:a7,rightx:a2,righty:a5,start:b11,x:b3,y:b4,platform:Windows,",
-"03000000786901006e70000000000000,XInput Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,leftstick:b8,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Windows,",
-"03000000203800000900000000010000,8Bitdo NES30 Pro,a:b1,b:b0,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b13,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:b9,rightx:a2,righty:a3,start:b11,x:b4,y:b3,platform:Mac OS X,",
-"03000000022000000090000001000000,8Bitdo NES30 Pro,a:b1,b:b0,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b13,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:b9,rightx:a2,righty:a3,start:b11,x:b4,y:b3,platform:Mac OS X,",
-"03000000102800000900000000000000,8Bitdo SFC30 GamePad Joystick,a:b1,b:b0,back:b10,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b11,x:b4,y:b3,platform:Mac OS X,",
-"03000000a00500003232000008010000,8Bitdo Zero GamePad,a:b0,b:b1,back:b10,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b6,rightshoulder:b7,start:b11,x:b3,y:b4,platform:Mac OS X,",
-"030000008305000031b0000000000000,Cideko AK08b,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"03000000260900008888000088020000,Cyber Gadget GameCube Controller,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,lefttrigger:a4,leftx:a0,lefty:a1,rightshoulder:b6,righttrigger:a5,rightx:a2,righty:a3~,start:b7,x:b2,y:b3,platform:Mac OS X,",
-"03000000a306000022f6000001030000,Cyborg V.3 Rumble Pad,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:+a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:-a3,rightx:a2,righty:a4,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"03000000ad1b000001f9000000000000,Gamestop BB-070 X360 Controller,a:b0,b:b1,back:b9,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,guide:b10,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,start:b8,x:b2,y:b3,platform:Mac OS X,",
-"0500000047532047616d657061640000,GameStop Gamepad,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Mac OS X,",
-"030000000d0f00005f00000000010000,Hori Fighting Commander 4 (PS3),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000000d0f00005e00000000010000,Hori Fighting Commander 4 (PS4),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000000d0f00005f00000000000000,HORI Fighting Commander 4 PS3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000000d0f00005e00000000000000,HORI Fighting Commander 4 PS4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000000d0f00004d00000000000000,HORI Gem Pad 3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000000d0f00006e00000000010000,HORIPAD 4 (PS3),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000000d0f00006600000000010000,HORIPAD 4 (PS4),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000000d0f00006600000000000000,HORIPAD FPS PLUS 4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000008f0e00001330000011010000,HuiJia SNES Controller,a:b4,b:b2,back:b16,dpdown:+a2,dpleft:-a0,dpright:+a0,dpup:-a2,leftshoulder:b12,rightshoulder:b14,start:b18,x:b6,y:b0,platform:Mac OS X,",
-"03000000830500006020000000010000,iBuffalo SNES Controller,a:b1,b:b0,back:b6,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b4,rightshoulder:b5,start:b7,x:b3,y:b2,platform:Mac OS X,",
-"03000000830500006020000000000000,iBuffalo USB 2-axis 8-button Gamepad,a:b1,b:b0,back:b6,leftshoulder:b4,leftx:a0,lefty:a1,rightshoulder:b5,start:b7,x:b3,y:b2,platform:Mac OS X,",
-"030000006d04000016c2000000020000,Logitech Dual Action,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000006d04000016c2000000030000,Logitech Dual Action,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000006d04000016c2000014040000,Logitech Dual Action,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000006d04000016c2000000000000,Logitech F310 Gamepad (DInput),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000006d04000018c2000000000000,Logitech F510 Gamepad (DInput),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000006d0400001fc2000000000000,Logitech F710 Gamepad (XInput),a:b0,b:b1,back:b9,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,guide:b10,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,start:b8,x:b2,y:b3,platform:Mac OS X,",
-"030000006d04000019c2000000000000,Logitech Wireless Gamepad (DInput),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"03000000380700005032000000010000,Mad Catz FightPad PRO (PS3),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"03000000380700005082000000010000,Mad Catz FightPad PRO (PS4),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"03000000790000004418000000010000,Mayflash GameCube Controller,a:b1,b:b2,dpdown:b14,dpleft:b15,dpright:b13,dpup:b12,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:a4,rightx:a5,righty:a2,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"0300000025090000e803000000000000,Mayflash Wii Classic Controller,a:b1,b:b0,back:b8,dpdown:b13,dpleft:b12,dpright:b14,dpup:b11,guide:b10,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b3,y:b2,platform:Mac OS X,",
-"03000000790000000018000000000000,Mayflash WiiU Pro Game Controller Adapter (DInput),a:b4,b:b8,back:b32,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b16,leftstick:b40,lefttrigger:b24,leftx:a0,lefty:a4,rightshoulder:b20,rightstick:b44,righttrigger:b28,rightx:a8,righty:a12,start:b36,x:b0,y:b12,platform:Mac OS X,",
-"03000000d8140000cecf000000000000,MC Cthulhu,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,lefttrigger:b6,rightshoulder:b5,righttrigger:b7,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000001008000001e5000006010000,NEXT SNES Controller,a:b2,b:b1,back:b8,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b4,rightshoulder:b6,start:b9,x:b3,y:b0,platform:Mac OS X,",
-"030000007e0500000920000000000000,Nintendo Switch Pro Controller,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Mac OS X,",
-"030000008f0e00000300000000000000,Piranha xtreme,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a3,righty:a2,start:b9,x:b3,y:b0,platform:Mac OS X,",
-"030000004c0500006802000000010000,PS3 Controller,a:b14,b:b13,back:b0,dpdown:b6,dpleft:b7,dpright:b5,dpup:b4,guide:b16,leftshoulder:b10,leftstick:b1,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b11,rightstick:b2,righttrigger:b9,rightx:a2,righty:a3,start:b3,x:b15,y:b12,platform:Mac OS X,",
-"030000004c0500006802000000000000,PS3 Controller,a:b14,b:b13,back:b0,dpdown:b6,dpleft:b7,dpright:b5,dpup:b4,guide:b16,leftshoulder:b10,leftstick:b1,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b11,rightstick:b2,righttrigger:b9,rightx:a2,righty:a3,start:b3,x:b15,y:b12,platform:Mac OS X,",
-"030000004c050000a00b000000010000,PS4 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000004c050000cc09000000010000,PS4 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000004c050000c405000000000000,PS4 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000004c050000c405000000010000,PS4 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000008916000000fd000000000000,Razer Onza TE,a:b0,b:b1,back:b9,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,guide:b10,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,start:b8,x:b2,y:b3,platform:Mac OS X,",
-"03000000321500000010000000010000,Razer RAIJU,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"0300000032150000030a000000000000,Razer Wildcat,a:b0,b:b1,back:b9,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,guide:b10,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,start:b8,x:b2,y:b3,platform:Mac OS X,",
-"03000000790000001100000000000000,Retrolink Classic Controller,a:b2,b:b1,back:b8,leftshoulder:b4,leftx:a3,lefty:a4,rightshoulder:b5,start:b9,x:b3,y:b0,platform:Mac OS X,",
-"03000000790000001100000006010000,Retrolink SNES Controller,a:b2,b:b1,back:b8,dpdown:+a4,dpleft:-a3,dpright:+a3,dpup:-a4,leftshoulder:b4,rightshoulder:b5,start:b9,x:b3,y:b0,platform:Mac OS X,",
-"030000006b140000010d000000010000,Revolution Pro Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"03000000811700007e05000000000000,Sega Saturn,a:b2,b:b4,dpdown:b16,dpleft:b15,dpright:b14,dpup:b17,leftshoulder:b8,lefttrigger:a5,leftx:a0,lefty:a2,rightshoulder:b9,righttrigger:a4,start:b13,x:b0,y:b6,platform:Mac OS X,",
-"03000000b40400000a01000000000000,Sega Saturn USB Gamepad,a:b0,b:b1,back:b5,guide:b2,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b8,x:b3,y:b4,platform:Mac OS X,",
-"030000003512000021ab000000000000,SFC30 Joystick,a:b1,b:b0,back:b10,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b11,x:b4,y:b3,platform:Mac OS X,",
-"030000004c050000cc09000000000000,Sony DualShock 4 V2,a:b1,b:b2,back:b13,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000004c050000a00b000000000000,Sony DualShock 4 Wireless Adaptor,a:b1,b:b2,back:b13,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"030000005e0400008e02000001000000,Steam Virtual GamePad,a:b0,b:b1,back:b9,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,start:b8,x:b2,y:b3,platform:Mac OS X,",
-"03000000110100002014000000000000,SteelSeries Nimbus,a:b0,b:b1,dpdown:b9,dpleft:b11,dpright:b10,dpup:b8,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b12,x:b2,y:b3,platform:Mac OS X,",
-"03000000110100002014000001000000,SteelSeries Nimbus,a:b0,b:b1,dpdown:b9,dpleft:b11,dpright:b10,dpup:b8,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1~,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3~,x:b2,y:b3,platform:Mac OS X,",
-"03000000381000002014000001000000,SteelSeries Nimbus,a:b0,b:b1,dpdown:b9,dpleft:b11,dpright:b10,dpup:b8,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1~,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3~,x:b2,y:b3,platform:Mac OS X,",
-"03000000110100001714000000000000,SteelSeries Stratus XL,a:b0,b:b1,dpdown:b9,dpleft:b11,dpright:b10,dpup:b8,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1~,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3~,start:b12,x:b2,y:b3,platform:Mac OS X,",
-"03000000110100001714000020010000,SteelSeries Stratus XL,a:b0,b:b1,dpdown:b9,dpleft:b11,dpright:b10,dpup:b8,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1~,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3~,start:b12,x:b2,y:b3,platform:Mac OS X,",
-"030000004f04000015b3000000000000,Thrustmaster Dual Analog 3.2,a:b0,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b1,y:b3,platform:Mac OS X,",
-"030000004f04000000b3000000000000,Thrustmaster Firestorm Dual Power,a:b0,b:b2,back:b9,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b11,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,righttrigger:b7,rightx:a2,righty:a3,start:b10,x:b1,y:b3,platform:Mac OS X,",
-"03000000bd12000015d0000000010000,Tomee SNES USB Controller,a:b2,b:b1,back:b8,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b4,rightshoulder:b5,start:b9,x:b3,y:b0,platform:Mac OS X,",
-"03000000bd12000015d0000000000000,Tomee SNES USB Controller,a:b2,b:b1,back:b8,leftshoulder:b4,leftx:a0,lefty:a1,rightshoulder:b5,start:b9,x:b3,y:b0,platform:Mac OS X,",
-"03000000100800000100000000000000,Twin USB Joystick,a:b4,b:b2,back:b16,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b12,leftstick:b20,lefttrigger:b8,leftx:a0,lefty:a2,rightshoulder:b14,rightstick:b22,righttrigger:b10,rightx:a6,righty:a4,start:b18,x:b6,y:b0,platform:Mac OS X,",
-"050000005769696d6f74652028303000,Wii Remote,a:b4,b:b5,back:b7,dpdown:b3,dpleft:b0,dpright:b1,dpup:b2,guide:b8,leftshoulder:b11,lefttrigger:b12,leftx:a0,lefty:a1,start:b6,x:b10,y:b9,platform:Mac OS X,",
-"050000005769696d6f74652028313800,Wii U Pro Controller,a:b16,b:b15,back:b7,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,guide:b8,leftshoulder:b19,leftstick:b23,lefttrigger:b21,leftx:a0,lefty:a1,rightshoulder:b20,rightstick:b24,righttrigger:b22,rightx:a2,righty:a3,start:b6,x:b18,y:b17,platform:Mac OS X,",
-"030000005e0400008e02000000000000,X360 Controller,a:b0,b:b1,back:b9,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,guide:b10,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,start:b8,x:b2,y:b3,platform:Mac OS X,",
-"03000000c6240000045d000000000000,Xbox 360 Wired Controller,a:b0,b:b1,back:b9,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,guide:b10,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,start:b8,x:b2,y:b3,platform:Mac OS X,",
-"030000005e040000e302000000000000,Xbox One Wired Controller,a:b0,b:b1,back:b9,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,guide:b10,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,start:b8,x:b2,y:b3,platform:Mac OS X,",
-"030000005e040000d102000000000000,Xbox One Wired Controller,a:b0,b:b1,back:b9,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,guide:b10,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,start:b8,x:b2,y:b3,platform:Mac OS X,",
-"030000005e040000dd02000000000000,Xbox One Wired Controller,a:b0,b:b1,back:b9,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,guide:b10,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,start:b8,x:b2,y:b3,platform:Mac OS X,",
-"030000005e040000e002000000000000,Xbox Wireless Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,leftstick:b8,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Mac OS X,",
-"030000005e040000fd02000003090000,Xbox Wireless Controller,a:b0,b:b1,back:b16,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b15,leftshoulder:b6,leftstick:b13,lefttrigger:a5,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:a4,rightx:a2,righty:a3,start:b11,x:b3,y:b4,platform:Mac OS X,",
-"030000005e040000ea02000000000000,Xbox Wireless Controller,a:b0,b:b1,back:b9,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,guide:b10,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,start:b8,x:b2,y:b3,platform:Mac OS X,",
-"030000005e040000e002000003090000,Xbox Wireless Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,leftstick:b8,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Mac OS X,",
-"03000000172700004431000029010000,XiaoMi Game Controller,a:b0,b:b1,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b15,leftshoulder:b6,leftstick:b13,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:a6,rightx:a2,righty:a5,start:b11,x:b3,y:b4,platform:Mac OS X,",
-"03000000120c0000100e000000010000,ZEROPLUS P4 Gamepad,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Mac OS X,",
-"05000000203800000900000000010000,8Bitdo NES30 Pro,a:b1,b:b0,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b13,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:b9,rightx:a2,righty:a3,start:b11,x:b4,y:b3,platform:Linux,",
-"03000000022000000090000011010000,8Bitdo NES30 Pro,a:b1,b:b0,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b13,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:b9,rightx:a2,righty:a3,start:b11,x:b4,y:b3,platform:Linux,",
-"05000000c82d00002038000000010000,8Bitdo NES30 Pro,a:b1,b:b0,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b2,leftshoulder:b6,leftstick:b13,lefttrigger:a5,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:a4,rightx:a2,righty:a3,start:b11,x:b4,y:b3,platform:Linux,",
-"03000000c82d00000190000011010000,8Bitdo NES30 Pro 8Bitdo NES30 Pro,a:b1,b:b0,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b13,lefttrigger:a4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:a5,rightx:a2,righty:a3,start:b11,x:b4,y:b3,platform:Linux,",
-"05000000c82d00003028000000010000,8Bitdo SFC30 GamePad,a:b1,b:b0,back:b10,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b11,x:b4,y:b3,platform:Linux,",
-"05000000102800000900000000010000,8Bitdo SFC30 GamePad,a:b1,b:b0,back:b10,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b11,x:b4,y:b3,platform:Linux,",
-"05000000a00500003232000008010000,8Bitdo Zero GamePad,a:b0,b:b1,back:b10,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b6,rightshoulder:b7,start:b11,x:b3,y:b4,platform:Linux,",
-"05000000a00500003232000001000000,8Bitdo Zero GamePad,a:b0,b:b1,back:b10,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b11,x:b3,y:b4,platform:Linux,",
-"030000006f0e00003901000020060000,Afterglow Wired Controller for Xbox One,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000100000008200000011010000,Akishop Customs PS360+ v1.66,a:b1,b:b2,back:b12,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,lefttrigger:b6,rightshoulder:b5,righttrigger:b7,start:b9,x:b0,y:b3,platform:Linux,",
-"05000000050b00000045000031000000,ASUS Gamepad,a:b0,b:b1,back:b9,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b6,leftshoulder:b4,leftstick:b7,lefttrigger:a5,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b8,righttrigger:a4,rightx:a2,righty:a3,start:b10,x:b2,y:b3,platform:Linux,",
-"03000000666600006706000000010000,boom PSX to PC Converter,a:b2,b:b1,back:b8,dpdown:b14,dpleft:b15,dpright:b13,dpup:b12,leftshoulder:b6,leftstick:b9,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b10,righttrigger:b5,rightx:a2,righty:a3,start:b11,x:b3,y:b0,platform:Linux,",
-"03000000e82000006058000001010000,Cideko AK08b,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b3,y:b0,platform:Linux,",
-"03000000260900008888000000010000,Cyber Gadget GameCube Controller,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,lefttrigger:a4,leftx:a0,lefty:a1,rightshoulder:b6,righttrigger:a5,rightx:a2,righty:a3~,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000a306000022f6000011010000,Cyborg V.3 Rumble Pad,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:+a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:-a3,rightx:a2,righty:a4,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000b40400000a01000000010000,CYPRESS USB Gamepad,a:b0,b:b1,back:b5,guide:b2,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b8,x:b3,y:b4,platform:Linux,",
-"03000000790000000600000010010000,DragonRise Inc. Generic USB Joystick,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a3,righty:a4,start:b9,x:b3,y:b0,platform:Linux,",
-"030000006f0e00003001000001010000,EA Sports PS3 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000341a000005f7000010010000,GameCube {HuiJia USB box},a:b1,b:b2,dpdown:b14,dpleft:b15,dpright:b13,dpup:b12,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:a4,rightx:a5,righty:a2,start:b9,x:b0,y:b3,platform:Linux,",
-"0500000047532047616d657061640000,GameStop Gamepad,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Linux,",
-"030000006f0e00000104000000010000,Gamestop Logic3 Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000006f0e00001304000000010000,Generic X-Box pad,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:a0,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:a3,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000006f0e00001f01000000010000,Generic X-Box pad,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000f0250000c183000010010000,Goodbetterbest Ltd USB Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000280400000140000000010000,Gravis GamePad Pro USB ,a:b1,b:b2,back:b8,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,start:b9,x:b0,y:b3,platform:Linux,",
-"030000008f0e00000610000000010000,GreenAsia Electronics 4Axes 12Keys GamePad ,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b9,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b10,righttrigger:b5,rightx:a3,righty:a2,start:b11,x:b3,y:b0,platform:Linux,",
-"030000008f0e00001200000010010000,GreenAsia Inc. USB Joystick,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b2,y:b3,platform:Linux,",
-"030000008f0e00000300000010010000,GreenAsia Inc. USB Joystick,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a3,righty:a2,start:b9,x:b3,y:b0,platform:Linux,",
-"0500000047532067616d657061640000,GS gamepad,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Linux,",
-"06000000adde0000efbe000002010000,Hidromancer Game Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000d81400000862000011010000,HitBox (PS3/PC) Analog Mode,a:b1,b:b2,back:b8,guide:b9,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,start:b12,x:b0,y:b3,platform:Linux,",
-"03000000c9110000f055000011010000,HJC Game GAMEPAD,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Linux,",
-"030000000d0f00000d00000000010000,hori,a:b0,b:b6,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b3,leftx:b4,lefty:b5,rightshoulder:b7,start:b9,x:b1,y:b2,platform:Linux,",
-"030000000d0f00001000000011010000,HORI CO. LTD. FIGHTING STICK 3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,rightshoulder:b5,righttrigger:b7,start:b9,x:b0,y:b3,platform:Linux,",
-"030000000d0f00006a00000011010000,HORI CO. LTD. Real Arcade Pro.4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"030000000d0f00006b00000011010000,HORI CO. LTD. Real Arcade Pro.4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"030000000d0f00002200000011010000,HORI CO. LTD. REAL ARCADE Pro.V3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,rightshoulder:b5,righttrigger:b7,start:b9,x:b0,y:b3,platform:Linux,",
-"030000000d0f00005f00000011010000,Hori Fighting Commander 4 (PS3),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"030000000d0f00005e00000011010000,Hori Fighting Commander 4 (PS4),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000ad1b000001f5000033050000,Hori Pad EX Turbo 2,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000000d0f00006e00000011010000,HORIPAD 4 (PS3),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"030000000d0f00006600000011010000,HORIPAD 4 (PS4),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"030000000d0f00006700000001010000,HORIPAD ONE,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000008f0e00001330000010010000,HuiJia SNES Controller,a:b2,b:b1,back:b8,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b6,rightshoulder:b7,start:b9,x:b3,y:b0,platform:Linux,",
-"03000000830500006020000010010000,iBuffalo SNES Controller,a:b1,b:b0,back:b6,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b4,rightshoulder:b5,start:b7,x:b3,y:b2,platform:Linux,",
-"050000006964726f69643a636f6e0000,idroid:con,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000b50700001503000010010000,impact,a:b2,b:b3,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b0,y:b1,platform:Linux,",
-"03000000fd0500000030000000010000,InterAct GoPad I-73000 (Fighting Game Layout),a:b3,b:b4,back:b6,leftx:a0,lefty:a1,rightshoulder:b2,righttrigger:b5,start:b7,x:b0,y:b1,platform:Linux,",
-"030000006e0500000320000010010000,JC-U3613M - DirectInput Mode,a:b2,b:b3,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b8,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:b7,rightx:a2,righty:a3,start:b11,x:b0,y:b1,platform:Linux,",
-"03000000300f00001001000010010000,Jess Tech Dual Analog Rumble Pad,a:b2,b:b3,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b0,y:b1,platform:Linux,",
-"03000000ba2200002010000001010000,Jess Technology USB Game Controller,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a3,righty:a2,start:b9,x:b3,y:b0,platform:Linux,",
-"030000006f0e00000103000000020000,Logic3 Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000006d04000019c2000010010000,Logitech Cordless RumblePad 2,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"030000006d04000016c2000011010000,Logitech Dual Action,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"030000006d04000016c2000010010000,Logitech Dual Action,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"030000006d0400001dc2000014400000,Logitech F310 Gamepad (XInput),a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000006d0400001ec2000020200000,Logitech F510 Gamepad (XInput),a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000006d04000019c2000011010000,Logitech F710 Gamepad (DInput),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"030000006d0400001fc2000005030000,Logitech F710 Gamepad (XInput),a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000006d04000015c2000010010000,Logitech Logitech Extreme 3D,a:b0,b:b4,back:b6,guide:b8,leftshoulder:b9,leftstick:h0.8,leftx:a0,lefty:a1,rightshoulder:b10,rightstick:h0.2,start:b7,x:b2,y:b5,platform:Linux,",
-"030000006d04000018c2000010010000,Logitech RumblePad 2,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"030000006d04000011c2000010010000,Logitech WingMan Cordless RumblePad,a:b0,b:b1,back:b2,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b5,leftshoulder:b6,lefttrigger:b9,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:b10,rightx:a3,righty:a4,start:b8,x:b3,y:b4,platform:Linux,",
-"05000000380700006652000025010000,Mad Catz C.T.R.L.R ,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000380700005032000011010000,Mad Catz FightPad PRO (PS3),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000380700005082000011010000,Mad Catz FightPad PRO (PS4),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000ad1b00002ef0000090040000,Mad Catz Fightpad SFxT,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,lefttrigger:a2,rightshoulder:b5,righttrigger:a5,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000380700008034000011010000,Mad Catz fightstick (PS3),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000380700008084000011010000,Mad Catz fightstick (PS4),a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000380700008433000011010000,Mad Catz FightStick TE S+ PS3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000380700008483000011010000,Mad Catz FightStick TE S+ PS4,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000380700001647000010040000,Mad Catz Wired Xbox 360 Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000380700003847000090040000,Mad Catz Wired Xbox 360 Controller (SFIV),a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Linux,",
-"03000000ad1b000016f0000090040000,Mad Catz Xbox 360 Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000380700001888000010010000,MadCatz PC USB Wired Stick 8818,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000380700003888000010010000,MadCatz PC USB Wired Stick 8838,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:a0,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000790000004418000010010000,Mayflash GameCube Controller,a:b1,b:b2,dpdown:b14,dpleft:b15,dpright:b13,dpup:b12,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:a4,rightx:a5,righty:a2,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000780000000600000010010000,Microntek USB Joystick,a:b2,b:b1,back:b8,leftshoulder:b6,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:b5,start:b9,x:b3,y:b0,platform:Linux,",
-"030000005e0400008e02000004010000,Microsoft X-Box 360 pad,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000005e0400008e02000062230000,Microsoft X-Box 360 pad,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000005e040000d102000001010000,Microsoft X-Box One pad,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000005e040000d102000003020000,Microsoft X-Box One pad v2,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000005e0400008502000000010000,Microsoft X-Box pad (Japan),a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b5,leftstick:b8,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b2,rightstick:b9,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b3,y:b4,platform:Linux,",
-"030000005e0400008902000021010000,Microsoft X-Box pad v2 (US),a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b5,leftstick:b8,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b2,rightstick:b9,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b3,y:b4,platform:Linux,",
-"05000000d6200000ad0d000001000000,Moga Pro,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b7,lefttrigger:a5,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b8,righttrigger:a4,rightx:a2,righty:a3,start:b6,x:b2,y:b3,platform:Linux,",
-"030000001008000001e5000010010000,NEXT SNES Controller,a:b2,b:b1,back:b8,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b4,rightshoulder:b6,start:b9,x:b3,y:b0,platform:Linux,",
-"050000007e0500000920000001000000,Nintendo Switch Pro Controller,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Linux,",
-"050000007e0500003003000001000000,Nintendo Wii Remote Pro Controller,a:b0,b:b1,back:b8,dpdown:b14,dpleft:b15,dpright:b16,dpup:b13,guide:b10,leftshoulder:b4,leftstick:b11,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b12,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b3,y:b2,platform:Linux,",
-"05000000010000000100000003000000,Nintendo Wiimote,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,leftstick:b11,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b12,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Linux,",
-"030000000d0500000308000010010000,Nostromo n45 Dual Analog Gamepad,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b9,leftshoulder:b4,leftstick:b12,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b10,x:b2,y:b3,platform:Linux,",
-"03000000550900001072000011010000,NVIDIA Controller,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b13,leftshoulder:b4,leftstick:b8,lefttrigger:a5,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:a4,rightx:a2,righty:a3,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000451300000830000010010000,NYKO CORE,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"030000005e0400000202000000010000,Old Xbox pad,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b5,leftstick:b8,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b2,rightstick:b9,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b3,y:b4,platform:Linux,",
-"05000000362800000100000002010000,OUYA Game Controller,a:b0,b:b3,dpdown:b9,dpleft:b10,dpright:b11,dpup:b8,guide:b14,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,x:b1,y:b2,platform:Linux,",
-"05000000362800000100000003010000,OUYA Game Controller,a:b0,b:b3,dpdown:b9,dpleft:b10,dpright:b11,dpup:b8,guide:b14,leftshoulder:b4,leftstick:b6,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b7,righttrigger:a5,rightx:a3,righty:a4,x:b1,y:b2,platform:Linux,",
-"03000000ff1100003133000010010000,PC Game Controller,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b3,y:b0,platform:Linux,",
-"030000006f0e00006401000001010000,PDP Battlefield One,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000ff1100004133000010010000,PS2 Controller,a:b2,b:b1,back:b8,leftshoulder:b6,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:b5,start:b9,x:b3,y:b0,platform:Linux,",
-"030000004c0500006802000010010000,PS3 Controller,a:b14,b:b13,back:b0,dpdown:b6,dpleft:b7,dpright:b5,dpup:b4,guide:b16,leftshoulder:b10,leftstick:b1,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b11,rightstick:b2,righttrigger:b9,rightx:a2,righty:a3,start:b3,x:b15,y:b12,platform:Linux,",
-"050000004c0500006802000000810000,PS3 Controller,a:b0,b:b1,back:b8,dpdown:b14,dpleft:b15,dpright:b16,dpup:b13,guide:b10,leftshoulder:b4,leftstick:b11,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b12,righttrigger:a5,rightx:a3,righty:a4,start:b9,x:b3,y:b2,platform:Linux,",
-"03000000341a00003608000011010000,PS3 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"030000004c0500006802000011810000,PS3 Controller,a:b0,b:b1,back:b8,dpdown:b14,dpleft:b15,dpright:b16,dpup:b13,guide:b10,leftshoulder:b4,leftstick:b11,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b12,righttrigger:a5,rightx:a3,righty:a4,start:b9,x:b3,y:b2,platform:Linux,",
-"050000004c0500006802000000010000,PS3 Controller,a:b14,b:b13,back:b0,dpdown:b6,dpleft:b7,dpright:b5,dpup:b4,guide:b16,leftshoulder:b10,leftstick:b1,lefttrigger:a12,leftx:a0,lefty:a1,rightshoulder:b11,rightstick:b2,righttrigger:a13,rightx:a2,righty:a3,start:b3,x:b15,y:b12,platform:Linux,",
-"030000004c0500006802000010810000,PS3 Controller,a:b0,b:b1,back:b8,dpdown:b14,dpleft:b15,dpright:b16,dpup:b13,guide:b10,leftshoulder:b4,leftstick:b11,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b12,righttrigger:a5,rightx:a3,righty:a4,start:b9,x:b3,y:b2,platform:Linux,",
-"030000004c0500006802000011010000,PS3 Controller,a:b14,b:b13,back:b0,dpdown:b6,dpleft:b7,dpright:b5,dpup:b4,guide:b16,leftshoulder:b10,leftstick:b1,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b11,rightstick:b2,righttrigger:b9,rightx:a2,righty:a3,start:b3,x:b15,y:b12,platform:Linux,",
-"060000004c0500006802000000010000,PS3 Controller (Bluetooth),a:b14,b:b13,back:b0,dpdown:b6,dpleft:b7,dpright:b5,dpup:b4,guide:b16,leftshoulder:b10,leftstick:b1,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b11,rightstick:b2,righttrigger:b9,rightx:a2,righty:a3,start:b3,x:b15,y:b12,platform:Linux,",
-"05000000504c415953544154494f4e00,PS3 Controller (Bluetooth),a:b14,b:b13,back:b0,dpdown:b6,dpleft:b7,dpright:b5,dpup:b4,guide:b16,leftshoulder:b10,leftstick:b1,lefttrigger:b8,leftx:a0,lefty:a1,rightshoulder:b11,rightstick:b2,righttrigger:b9,rightx:a2,righty:a3,start:b3,x:b15,y:b12,platform:Linux,",
-"050000004c050000c405000000010000,PS4 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"030000004c050000a00b000011010000,PS4 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"050000004c050000cc09000000810000,PS4 Controller,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,leftstick:b11,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b12,righttrigger:a5,rightx:a3,righty:a4,start:b9,x:b3,y:b2,platform:Linux,",
-"050000004c050000c405000000810000,PS4 Controller,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,leftstick:b11,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b12,righttrigger:a5,rightx:a3,righty:a4,start:b9,x:b3,y:b2,platform:Linux,",
-"030000004c050000c405000011810000,PS4 Controller,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,leftstick:b11,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b12,righttrigger:a5,rightx:a3,righty:a4,start:b9,x:b3,y:b2,platform:Linux,",
-"050000004c050000cc09000000010000,PS4 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"030000004c050000cc09000011010000,PS4 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"030000004c050000a00b000011810000,PS4 Controller,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,leftstick:b11,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b12,righttrigger:a5,rightx:a3,righty:a4,start:b9,x:b3,y:b2,platform:Linux,",
-"030000004c050000cc09000011810000,PS4 Controller,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,leftstick:b11,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b12,righttrigger:a5,rightx:a3,righty:a4,start:b9,x:b3,y:b2,platform:Linux,",
-"030000004c050000c405000011010000,PS4 Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000300f00001211000011010000,QanBa Arcade JoyStick,a:b2,b:b0,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b5,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,righttrigger:b6,start:b9,x:b1,y:b3,platform:Linux,",
-"030000009b2800000300000001010000,raphnet.net 4nes4snes v1.5,a:b0,b:b4,back:b2,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b3,x:b1,y:b5,platform:Linux,",
-"030000008916000001fd000024010000,Razer Onza Classic Edition,a:b0,b:b1,back:b6,dpdown:b14,dpleft:b11,dpright:b12,dpup:b13,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000008916000000fd000024010000,Razer Onza Tournament,a:b0,b:b1,back:b6,dpdown:b14,dpleft:b11,dpright:b12,dpup:b13,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000321500000010000011010000,Razer RAIJU,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000c6240000045d000025010000,Razer Sabertooth,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000321500000009000011010000,Razer Serval,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a5,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a4,rightx:a2,righty:a3,start:b7,x:b2,y:b3,platform:Linux,",
-"050000003215000000090000163a0000,Razer Serval,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a5,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a4,rightx:a2,righty:a3,start:b7,x:b2,y:b3,platform:Linux,",
-"0300000032150000030a000001010000,Razer Wildcat,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000790000001100000010010000,Retrolink SNES Controller,a:b2,b:b1,back:b8,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b4,rightshoulder:b5,start:b9,x:b3,y:b0,platform:Linux,",
-"0300000000f000000300000000010000,RetroUSB.com RetroPad,a:b1,b:b5,back:b2,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b3,x:b0,y:b4,platform:Linux,",
-"0300000000f00000f100000000010000,RetroUSB.com Super RetroPort,a:b1,b:b5,back:b2,leftshoulder:b6,leftx:a0,lefty:a1,rightshoulder:b7,start:b3,x:b0,y:b4,platform:Linux,",
-"030000006b140000010d000011010000,Revolution Pro Controller,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"030000006f0e00001e01000011010000,Rock Candy Gamepad for PS3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"030000006f0e00004601000001010000,Rock Candy Wired Controller for Xbox One,a:b0,b:b1,back:b6,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000a306000023f6000011010000,Saitek Cyborg V.1 Game Pad,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a4,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000a30600000cff000010010000,Saitek P2500 Force Rumble Pad,a:b2,b:b3,back:b11,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,leftstick:b8,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:b7,rightx:a3,righty:a2,x:b0,y:b1,platform:Linux,",
-"03000000a30600000c04000011010000,Saitek P2900 Wireless Pad,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b9,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a3,righty:a2,start:b12,x:b0,y:b3,platform:Linux,",
-"03000000a30600000901000000010000,Saitek P880,a:b2,b:b3,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b8,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:b7,rightx:a3,righty:a2,x:b0,y:b1,platform:Linux,",
-"03000000a30600000b04000000010000,Saitek P990 Dual Analog Pad,a:b1,b:b2,back:b9,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a3,righty:a2,start:b8,x:b0,y:b3,platform:Linux,",
-"03000000a306000018f5000010010000,Saitek PLC Saitek P3200 Rumble Pad,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a3,righty:a4,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000c01600008704000011010000,Serial/Keyboard/Mouse/Joystick,a:b12,b:b10,back:b4,dpdown:b2,dpleft:b3,dpright:b1,dpup:b0,leftshoulder:b9,leftstick:b14,lefttrigger:b6,leftx:a1,lefty:a0,rightshoulder:b8,rightstick:b15,righttrigger:b7,rightx:a2,righty:a3,start:b5,x:b13,y:b11,platform:Linux,",
-"03000000f025000021c1000010010000,ShanWan Gioteck PS3 Wired Controller,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b3,y:b0,platform:Linux,",
-"03000000250900000500000000010000,Sony PS2 pad with SmartJoy adapter,a:b2,b:b1,back:b9,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a2,righty:a3,start:b8,x:b3,y:b0,platform:Linux,",
-"030000005e0400008e02000073050000,Speedlink TORID Wireless Gamepad,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000005e0400008e02000020200000,SpeedLink XEOX Pro Analog Gamepad pad,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000de2800000211000001000000,Steam Controller,a:b0,b:b1,back:b6,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a3,start:b7,x:b2,y:b3,platform:Linux,",
-"05000000de2800000511000001000000,Steam Controller,a:b0,b:b1,back:b6,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a3,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000de2800000112000001000000,Steam Controller,a:b0,b:b1,back:b6,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a3,start:b7,x:b2,y:b3,platform:Linux,",
-"05000000de2800000212000001000000,Steam Controller,a:b0,b:b1,back:b6,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a3,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000de280000fc11000001000000,Steam Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000de2800004211000001000000,Steam Controller,a:b0,b:b1,back:b6,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a3,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000de280000ff11000001000000,Steam Virtual Gamepad,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"03000000666600000488000000010000,Super Joy Box 5 Pro,a:b2,b:b1,back:b9,dpdown:b14,dpleft:b15,dpright:b13,dpup:b12,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a2,righty:a3,start:b8,x:b3,y:b0,platform:Linux,",
-"030000004f04000020b3000010010000,Thrustmaster 2 in 1 DT,a:b0,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b1,y:b3,platform:Linux,",
-"030000004f04000015b3000010010000,Thrustmaster Dual Analog 4,a:b0,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b1,y:b3,platform:Linux,",
-"030000004f04000023b3000000010000,Thrustmaster Dual Trigger 3-in-1,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"030000004f04000000b3000010010000,Thrustmaster Firestorm Dual Power,a:b0,b:b2,back:b9,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b11,lefttrigger:b5,leftx:a0,lefty:a1,rightshoulder:b6,rightstick:b12,righttrigger:b7,rightx:a2,righty:a3,start:b10,x:b1,y:b3,platform:Linux,",
-"030000004f04000008d0000000010000,Thrustmaster Run N Drive Wireless,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"030000004f04000009d0000000010000,Thrustmaster Run N Drive Wireless PS3,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b0,y:b3,platform:Linux,",
-"03000000bd12000015d0000010010000,Tomee SNES USB Controller,a:b2,b:b1,back:b8,dpdown:+a1,dpleft:-a0,dpright:+a0,dpup:-a1,leftshoulder:b4,rightshoulder:b5,start:b9,x:b3,y:b0,platform:Linux,",
-"03000000d814000007cd000011010000,Toodles 2008 Chimp PC/PS3,a:b0,b:b1,back:b8,leftshoulder:b4,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:b7,start:b9,x:b3,y:b2,platform:Linux,",
-"03000000100800000100000010010000,Twin USB PS2 Adapter,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a3,righty:a2,start:b9,x:b3,y:b0,platform:Linux,",
-"03000000100800000300000010010000,USB Gamepad,a:b2,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a3,righty:a2,start:b9,x:b3,y:b0,platform:Linux,",
-"03000000790000001100000000010000,USB Gamepad1,a:b2,b:b1,back:b8,dpdown:a0,dpleft:a1,dpright:a2,dpup:a4,start:b9,platform:Linux,",
-"05000000ac0500003232000001000000,VR-BOX,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b6,leftstick:b10,lefttrigger:b4,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b11,righttrigger:b5,rightx:a3,righty:a2,start:b9,x:b2,y:b3,platform:Linux,",
-"030000005e0400008e02000014010000,X360 Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000005e0400008e02000010010000,X360 Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000005e0400001907000000010000,X360 Wireless Controller,a:b0,b:b1,back:b6,dpdown:b14,dpleft:b11,dpright:b12,dpup:b13,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000005e0400009102000007010000,X360 Wireless Controller,a:b0,b:b1,back:b6,dpdown:b14,dpleft:b11,dpright:b12,dpup:b13,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000005e040000a102000007010000,X360 Wireless Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"030000005e040000a102000000010000,X360 Wireless Controller,a:b0,b:b1,back:b6,dpdown:b14,dpleft:b11,dpright:b12,dpup:b13,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"0000000058626f782033363020576900,Xbox 360 Wireless Controller,a:b0,b:b1,back:b14,dpdown:b11,dpleft:b12,dpright:b13,dpup:b10,guide:b7,leftshoulder:b4,leftstick:b8,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:a5,rightx:a3,righty:a4,start:b6,x:b2,y:b3,platform:Linux,",
-"0000000058626f782047616d65706100,Xbox Gamepad (userspace driver),a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a5,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a4,rightx:a2,righty:a3,start:b7,x:b2,y:b3,platform:Linux,",
-"050000005e040000e002000003090000,Xbox One Wireless Controller,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b4,leftstick:b8,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b9,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:Linux,",
-"050000005e040000fd02000003090000,Xbox One Wireless Controller,a:b0,b:b1,back:b15,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b16,leftshoulder:b6,leftstick:b13,lefttrigger:a5,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:a4,rightx:a2,righty:a3,start:b11,x:b3,y:b4,platform:Linux,",
-"03000000450c00002043000010010000,XEOX Gamepad SL-6556-BK,a:b0,b:b1,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,leftstick:b10,lefttrigger:b6,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:b7,rightx:a2,righty:a3,start:b9,x:b2,y:b3,platform:Linux,",
-"05000000172700004431000029010000,XiaoMi Game Controller,a:b0,b:b1,back:b10,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b20,leftshoulder:b6,leftstick:b13,lefttrigger:a7,leftx:a0,lefty:a1,rightshoulder:b7,rightstick:b14,righttrigger:a6,rightx:a2,righty:a5,start:b11,x:b3,y:b4,platform:Linux,",
-"03000000c0160000e105000001010000,Xin-Mo Xin-Mo Dual Arcade,a:b4,b:b3,back:b6,dpdown:b12,dpleft:b13,dpright:b14,dpup:b11,guide:b9,leftshoulder:b2,leftx:a0,lefty:a1,rightshoulder:b5,start:b7,x:b1,y:b0,platform:Linux,",
-"03000000120c0000100e000011010000,ZEROPLUS P4 Gamepad,a:b1,b:b2,back:b8,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b12,leftshoulder:b4,leftstick:b10,lefttrigger:a3,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b11,righttrigger:a4,rightx:a2,righty:a5,start:b9,x:b0,y:b3,platform:Linux,",
-"64633436313965656664373634323364,Microsoft X-Box 360 pad,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b9,leftstick:b7,lefttrigger:a4,leftx:a0,lefty:a1,rightshoulder:b10,rightstick:b8,righttrigger:a5,rightx:a2,righty:a3,x:b2,y:b3,platform:Android,",
-"61363931656135336130663561616264,NVIDIA Controller,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b9,leftstick:b7,lefttrigger:a4,leftx:a0,lefty:a1,rightshoulder:b10,rightstick:b8,righttrigger:a5,rightx:a2,righty:a3,start:b6,x:b2,y:b3,platform:Android,",
-"4e564944494120436f72706f72617469,NVIDIA Controller,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b9,leftstick:b7,lefttrigger:a4,leftx:a0,lefty:a1,rightshoulder:b10,rightstick:b8,righttrigger:a5,rightx:a2,righty:a3,start:b6,x:b2,y:b3,platform:Android,",
-"37336435666338653565313731303834,NVIDIA Controller,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b9,leftstick:b7,lefttrigger:a4,leftx:a0,lefty:a1,rightshoulder:b10,rightstick:b8,righttrigger:a5,rightx:a2,righty:a3,start:b6,x:b2,y:b3,platform:Android,",
-"35643031303033326130316330353564,PS4 Controller,a:b1,b:b17,back:b15,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b5,leftshoulder:b3,leftstick:b4,lefttrigger:+a3,leftx:a0,lefty:a1,rightshoulder:b18,rightstick:b6,righttrigger:+a4,rightx:a2,righty:a5,start:b16,x:b0,y:b2,platform:Android,",
-"05000000de2800000511000001000000,Steam Controller,a:b0,b:b1,back:b6,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a3,start:b7,x:b2,y:b3,platform:Android,",
-"5477696e20555342204a6f7973746963,Twin USB Joystick,a:b22,b:b21,back:b28,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b26,leftstick:b30,lefttrigger:b24,leftx:a0,lefty:a1,rightshoulder:b27,rightstick:b31,righttrigger:b25,rightx:a3,righty:a2,start:b29,x:b23,y:b20,platform:Android,",
-"34356136633366613530316338376136,Xbox Wireless Controller,a:b0,b:b1,back:b9,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b10,leftshoulder:b3,leftstick:b15,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b18,rightstick:b16,righttrigger:a5,rightx:a3,righty:a4,x:b17,y:b2,platform:Android,",
-"4d466947616d65706164010000000000,MFi Extended Gamepad,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a5,rightx:a3,righty:a4,start:b6,x:b2,y:b3,platform:iOS,",
-"4d466947616d65706164020000000000,MFi Gamepad,a:b0,b:b1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,leftshoulder:b4,rightshoulder:b5,start:b6,x:b2,y:b3,platform:iOS,",
-"05000000de2800000511000001000000,Steam Controller,a:b0,b:b1,back:b6,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,righttrigger:a3,start:b7,x:b2,y:b3,platform:iOS,",
+// GLFW specific gamepad mappings, in the same format as gamecontrollerdb.txt
+// These are read from mappings.h.in by GenerateMappings.cmake and compiled into
+// the tables below along with the SDL_GameControllerDB ones
+//
+// 78696e70757401000000000000000000,XInput Gamepad (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,
+// 78696e70757402000000000000000000,XInput Wheel (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,
+// 78696e70757403000000000000000000,XInput Arcade Stick (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,
+// 78696e70757404000000000000000000,XInput Flight Stick (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,
+// 78696e70757405000000000000000000,XInput Dance Pad (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,
+// 78696e70757406000000000000000000,XInput Guitar (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,
+// 78696e70757408000000000000000000,XInput Drum Kit (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,
 
-"78696e70757401000000000000000000,XInput Gamepad (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,",
-"78696e70757402000000000000000000,XInput Wheel (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,",
-"78696e70757403000000000000000000,XInput Arcade Stick (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,",
-"78696e70757404000000000000000000,XInput Flight Stick (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,",
-"78696e70757405000000000000000000,XInput Dance Pad (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,",
-"78696e70757406000000000000000000,XInput Guitar (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,",
-"78696e70757408000000000000000000,XInput Drum Kit (GLFW),platform:Windows,a:b0,b:b1,x:b2,y:b3,leftshoulder:b4,rightshoulder:b5,back:b6,start:b7,leftstick:b8,rightstick:b9,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,dpup:h0.1,dpright:h0.2,dpdown:h0.4,dpleft:h0.8,",
-NULL
+// The pre-parsed default mappings for the current platform, sorted by GUID
+//
+#if defined(_GLFW_WIN32)
+const _GLFWmapping _glfwDefaultMappings[] =
+{
+{ "Saturn_Adapter_2.0", "0300000000050000289b000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "RetroUSB.com RetroPad", "0300000000f000000300000000000000",
+  { {2,1,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "RetroUSB.com Super RetroPort", "0300000000f00000f100000000000000",
+  { {2,1,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "8Bitdo NES30 Pro", "03000000022000000090000000000000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "REAL ARCADE PRO.3", "030000000d0f00001100000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "REAL ARCADE Pro.V3", "030000000d0f00002200000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "FIGHTING STICK V3", "030000000d0f00002700000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Hori Fighting Stick Mini 3", "030000000d0f00004000000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}} } },
+{ "Hatsune Miku Sho Controller", "030000000d0f00004900000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HORIPAD3 A", "030000000d0f00004d00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Real Arcade Pro.V4", "030000000d0f00005b00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Real Arcade Pro.V4", "030000000d0f00005c00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Hori Fighting Commander 4 (PS4)", "030000000d0f00005e00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Hori Fighting Commander 4 (PS3)", "030000000d0f00005f00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HORIPAD 4 (PS4)", "030000000d0f00006600000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Real Arcade Pro.4", "030000000d0f00006a00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Real Arcade Pro.4", "030000000d0f00006b00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HORIPAD 4 (PS3)", "030000000d0f00006e00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "REAL ARCADE PRO.4 VLX", "030000000d0f00007000000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Fighting Commander 5", "030000000d0f00008400000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Fighting Commander 2016 PS3", "030000000d0f00008500000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Fighting Stick mini 4", "030000000d0f00008700000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Fighting Stick mini 4", "030000000d0f00008800000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Real Arcade Pro.4", "030000000d0f00008a00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Real Arcade Pro.4", "030000000d0f00008b00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HORIPAD mini4", "030000000d0f0000ee00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "PS360+ v1.66", "03000000100000008200000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{3,4,-1,1,2.f,-1.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "PS1 USB", "03000000100800000100000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "NEXT SNES Controller", "030000001008000001e5000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "PS2 USB", "03000000100800000300000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "8Bitdo SFC30 GamePad", "03000000102800000900000000000000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "P4 Wired Gamepad", "03000000120c0000f60e000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,7,-1,1,2.f,-1.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}} } },
+{ "XiaoMi Game Controller", "03000000172700004431000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,20,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{1,7,-1,1,1.f,0.f},{0}} } },
+{ "8Bitdo NES30 Pro", "03000000203800000900000000000000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "QANBA DRONE ARCADE JOYSTICK", "03000000222c00000020000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Qanba Obsidian Arcade Joystick PS4 Mode", "03000000222c00000023000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Qanba Obsidian Arcade Joystick PS3 Mode", "03000000222c00000223000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HRAP2 on PS/SS/N64 Joypad to USB BOX", "03000000250900000017000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}} } },
+{ "Mayflash Arcade Stick", "03000000250900000128000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "PS3 DualShock", "03000000250900000500000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,8,0,1,1.f,0.f},{3,4,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "Mayflash Wii Classic Controller", "0300000025090000e803000000000000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{0},{0},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,12,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Gamecube Controller", "03000000260900002625000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{0},{0},{2,7,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Cyber Gadget GameCube Controller", "03000000260900008888000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{2,6,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{0},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,-1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "GamePad Pro USB", "03000000280400000140000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "QanBa Arcade JoyStick 1008", "03000000300f00000011000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{0},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Saitek P480 Rumble Pad", "03000000300f00001001000000000000",
+  { {2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "saitek rumble pad", "03000000300f00001101000000000000",
+  { {2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Saitek Dual Analog Pad", "03000000300f00001201000000000000",
+  { {2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "QanBa Joystick Plus", "03000000300f00001210000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{0},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "QanBa Arcade JoyStick 4018", "03000000300f00001611000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Razer Hydra", "03000000321500000003000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{0},{0}},{{1,2,-1,1,1.f,0.f},{0}} } },
+{ "QanBa Joystick Q4RAF", "03000000341a00000104000000000000",
+  { {2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "EXEQ RF USB Gamepad 8206", "03000000341a00000108000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}} } },
+{ "SL-6555-SBK", "03000000341a00000208000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,4,-1,1,-2.f,-1.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Hama Scorpad", "03000000341a00000302000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Afterglow PS3 Controller", "03000000341a00003608000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "OUYA Game Controller", "03000000362800000100000000000000",
+  { {2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{0},{2,14,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,13,-1,1,2.f,-1.f},{0}} } },
+{ "MadCatz SFIV FightStick PS3", "03000000380700001888000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}} } },
+{ "Madcatz Arcade Fightstick TE S+ PS3", "03000000380700003888000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz FightPad PRO (PS3)", "03000000380700005032000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz FightPad PRO (PS4)", "03000000380700005082000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "UnKnown", "03000000380700006652000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz TE2 PS3 Fightstick", "03000000380700008034000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "MADCATZ SFV Arcade FightStick Alpha PS4", "03000000380700008081000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz TE2 PS4 Fightstick", "03000000380700008084000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Mad Catz FightStick TE2+ PS3", "03000000380700008134000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz FightStick TE2+ PS4", "03000000380700008184000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz FightStick TE S+ PS3", "03000000380700008433000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz FightStick TE S+ PS4", "03000000380700008483000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}} } },
+{ "Madcatz Arcade Fightstick TE S PS3", "03000000380700008532000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "XEOX Gamepad SL-6556-BK", "03000000450c00002043000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Generic USB Joystick", "03000000451300000010000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Ipega PG-9023", "03000000491900000204000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "NYKO AIRFLO", "030000004b120000014d000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{1,3,0,1,0.5f,0.5f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{1,0,0,1,0.5f,0.5f},{1,2,0,1,0.5f,0.5f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{3,6,-1,1,2.f,-1.f},{0}},{{3,12,-1,1,2.f,-1.f},{0}},{{3,9,-1,1,2.f,-1.f},{0}},{{3,4,-1,1,2.f,-1.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "PS3 Controller", "030000004c0500006802000000000000",
+  { {2,14,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "PS4 Controller", "030000004c050000a00b000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "030000004c050000c405000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "030000004c050000cc09000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Thrustmaster Firestorm Dual Power", "030000004f04000000b3000000000000",
+  { {2,0,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "run'n'drive", "030000004f04000003d0000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{1,3,0,1,0.5f,0.5f},{1,4,0,1,0.5f,0.5f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "Thrustmaster Firestorm Dual Power 3", "030000004f04000004b3000000000000",
+  { {2,0,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Thrustmaster Dual Analog 2", "030000004f04000015b3000000000000",
+  { {2,0,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Dual Trigger 3-in-1", "030000004f04000023b3000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Controller (XBOX 360 For Windows)", "030000005e0400008e02000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{0},{0}},{{1,2,-1,1,1.f,0.f},{0}} } },
+{ "USB Vibration Joystick (BM)", "03000000632500002305000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "TigerGame PS/PS2 Game Controller Adapter", "03000000666600000488000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,15,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "BrutalLegendTest", "0300000066f700000500000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "bigben ps3padstreetnew", "030000006b1400000055000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Revolution Pro Controller", "030000006b140000010d000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Logitech Cordless Wingman", "030000006d04000011c2000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{0},{2,5,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech Dual Action", "030000006d04000016c2000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech F510 Gamepad", "030000006d04000018c2000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech F710 Gamepad", "030000006d04000019c2000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Rock Candy Gamepad for PS3", "030000006f0e00001e01000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "INJUSTICE FightStick for PS3", "030000006f0e00002401000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "XInput Controller", "03000000786901006e70000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Mayflash WiiU Pro Game Controller Adapter (DInput)", "03000000790000000018000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Retrolink SNES Controller", "03000000790000001100000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{1,4,0,1,-1.f,0.f},{1,3,0,1,1.f,0.f},{1,4,0,1,1.f,0.f},{1,3,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Venom Arcade Joystick", "03000000790000001b18000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mayflash GameCube Controller Adapter", "03000000790000004318000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Mayflash GameCube Controller", "03000000790000004418000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{0},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Dual Box WII", "03000000791d00000103000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "Nintendo Switch Pro Controller", "030000007e0500000920000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "MaxfireBlaze3", "030000008305000031b0000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "iBuffalo SNES Controller", "03000000830500006020000000000000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "PS3 Controller", "03000000888800000803000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,8,0,1,1.f,0.f},{3,4,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Piranha xtreme", "030000008f0e00000300000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "SpeedLink Strike FX Wireless", "030000008f0e00000800000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "GAMEPAD 3 TURBO", "030000008f0e00000d31000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mayflash USB Adapter for original Sega Saturn controller", "030000008f0e00001030000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{0},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Acme", "030000008f0e00001200000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HuiJia SNES Controller", "030000008f0e00001330000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "PS (R) Gamepad", "030000008f0e00007530000000000000",
+  { {0},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,1,-1,1,2.f,-1.f},{0}} } },
+{ "Saturn_Adapter_2.0", "030000009b2800000500000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "8Bitdo Zero GamePad", "03000000a00500003232000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{0},{0},{1,2,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,2,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Saitek P990", "03000000a30600000b04000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Saitek P990 Dual Analog Pad", "03000000a30600000b04000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Saitek P2900", "03000000a30600000c04000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Saitek P2500 Force Rumble Pad", "03000000a30600000cff000000000000",
+  { {2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Saitek Cyborg", "03000000a30600001af5000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Cyborg V.3 Rumble Pad", "03000000a306000022f6000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,3,-1,1,2.f,-1.f},{0}},{{1,3,-1,1,-2.f,-1.f},{0}} } },
+{ "Saitek Cyborg V.1 Game pad", "03000000a306000023f6000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Techmobility X6-38V", "03000000b50700001203000000000000",
+  { {2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "IMPACT BLACK", "03000000b50700001403000000000000",
+  { {2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Nintendo Retrolink USB Super SNES Classic Controller", "03000000bd12000015d0000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Battalife Joystick", "03000000c01100001352000000000000",
+  { {2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "PowerA Pro Ex", "03000000d62000006dca000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HitBox Edition Cthulhu+", "03000000d81400000862000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}} } },
+{ "BUFFALO BSGP1601 Series ", "03000000d81d00000b00000000000000",
+  { {2,5,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "iBUFFALO BSGP1204 Series", "03000000d81d00000f00000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "iBUFFALO BSGP1204P Series", "03000000d81d00001000000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "TwinShock PS2", "03000000d90400000200000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "PS to USB convert cable", "03000000e30500009605000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "Cideko AK08b", "03000000e82000006058000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Team 5", "03000000fa1900000706000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "3DRUDDER", "03000000fa2d00000100000000000000",
+  { {0},{0},{0},{0},{0},{0},{0},{0},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}} } },
+{ "SVEN X-PAD", "03000000ff1100003133000000000000",
+  { {2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "GameStop Gamepad", "03000000ffff00000000000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "XInput Gamepad (GLFW)", "78696e70757401000000000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "XInput Wheel (GLFW)", "78696e70757402000000000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "XInput Arcade Stick (GLFW)", "78696e70757403000000000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "XInput Flight Stick (GLFW)", "78696e70757404000000000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "XInput Dance Pad (GLFW)", "78696e70757405000000000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "XInput Guitar (GLFW)", "78696e70757406000000000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "XInput Drum Kit (GLFW)", "78696e70757408000000000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
 };
-
+#elif defined(_GLFW_COCOA)
+const _GLFWmapping _glfwDefaultMappings[] =
+{
+{ "8Bitdo NES30 Pro", "03000000022000000090000001000000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "HORI Gem Pad 3", "030000000d0f00004d00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HORI Fighting Commander 4 PS4", "030000000d0f00005e00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Hori Fighting Commander 4 (PS4)", "030000000d0f00005e00000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "HORI Fighting Commander 4 PS3", "030000000d0f00005f00000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Hori Fighting Commander 4 (PS3)", "030000000d0f00005f00000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HORIPAD FPS PLUS 4", "030000000d0f00006600000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "HORIPAD 4 (PS4)", "030000000d0f00006600000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "HORIPAD 4 (PS3)", "030000000d0f00006e00000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Twin USB Joystick", "03000000100800000100000000000000",
+  { {2,4,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,18,0,1,1.f,0.f},{0},{2,20,0,1,1.f,0.f},{2,22,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,6,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,10,-1,1,2.f,-1.f},{0}} } },
+{ "NEXT SNES Controller", "030000001008000001e5000006010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "8Bitdo SFC30 GamePad Joystick", "03000000102800000900000000000000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "SteelSeries Stratus XL", "03000000110100001714000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{2,12,0,1,1.f,0.f},{0},{0},{0},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,11,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,-1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,-1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "SteelSeries Stratus XL", "03000000110100001714000020010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{2,12,0,1,1.f,0.f},{0},{0},{0},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,11,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,-1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,-1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "SteelSeries Nimbus", "03000000110100002014000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{2,12,0,1,1.f,0.f},{0},{0},{0},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,11,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "SteelSeries Nimbus", "03000000110100002014000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{0},{2,12,0,1,1.f,0.f},{0},{0},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,11,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,-1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,-1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "ZEROPLUS P4 Gamepad", "03000000120c0000100e000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "XiaoMi Game Controller", "03000000172700004431000029010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{1,6,-1,1,1.f,0.f},{0}} } },
+{ "8Bitdo NES30 Pro", "03000000203800000900000000010000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "Mayflash Wii Classic Controller", "0300000025090000e803000000000000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{0},{0},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,12,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Cyber Gadget GameCube Controller", "03000000260900008888000088020000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{2,6,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{0},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,-1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Razer RAIJU", "03000000321500000010000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Razer Wildcat", "0300000032150000030a000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "SFC30 Joystick", "030000003512000021ab000000000000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Mad Catz FightPad PRO (PS3)", "03000000380700005032000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz FightPad PRO (PS4)", "03000000380700005082000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "SteelSeries Nimbus", "03000000381000002014000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{0},{2,12,0,1,1.f,0.f},{0},{0},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,11,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,-1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,-1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "PS3 Controller", "030000004c0500006802000000000000",
+  { {2,14,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "PS3 Controller", "030000004c0500006802000000010000",
+  { {2,14,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "Sony DualShock 4 Wireless Adaptor", "030000004c050000a00b000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "030000004c050000a00b000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "030000004c050000c405000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "030000004c050000c405000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Sony DualShock 4 V2", "030000004c050000cc09000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "030000004c050000cc09000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Thrustmaster Firestorm Dual Power", "030000004f04000000b3000000000000",
+  { {2,0,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Thrustmaster Dual Analog 3.2", "030000004f04000015b3000000000000",
+  { {2,0,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "X360 Controller", "030000005e0400008e02000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Steam Virtual GamePad", "030000005e0400008e02000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Xbox One Wired Controller", "030000005e040000d102000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Xbox One Wired Controller", "030000005e040000dd02000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Xbox Wireless Controller", "030000005e040000e002000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Xbox Wireless Controller", "030000005e040000e002000003090000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Xbox One Wired Controller", "030000005e040000e302000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Xbox Wireless Controller", "030000005e040000ea02000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Xbox Wireless Controller", "030000005e040000fd02000003090000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Revolution Pro Controller", "030000006b140000010d000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Logitech F310 Gamepad (DInput)", "030000006d04000016c2000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech Dual Action", "030000006d04000016c2000000020000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech Dual Action", "030000006d04000016c2000000030000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech Dual Action", "030000006d04000016c2000014040000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech F510 Gamepad (DInput)", "030000006d04000018c2000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech Wireless Gamepad (DInput)", "030000006d04000019c2000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech F710 Gamepad (XInput)", "030000006d0400001fc2000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Mayflash WiiU Pro Game Controller Adapter (DInput)", "03000000790000000018000000000000",
+  { {2,4,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,20,0,1,1.f,0.f},{2,32,0,1,1.f,0.f},{2,36,0,1,1.f,0.f},{0},{2,40,0,1,1.f,0.f},{2,44,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,8,-1,1,1.f,0.f},{0}},{{1,12,-1,1,1.f,0.f},{0}},{{2,24,-1,1,2.f,-1.f},{0}},{{2,28,-1,1,2.f,-1.f},{0}} } },
+{ "Retrolink Classic Controller", "03000000790000001100000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Retrolink SNES Controller", "03000000790000001100000006010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{1,4,0,1,-1.f,0.f},{1,3,0,1,1.f,0.f},{1,4,0,1,1.f,0.f},{1,3,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Mayflash GameCube Controller", "03000000790000004418000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{0},{0},{0},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,15,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Nintendo Switch Pro Controller", "030000007e0500000920000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Sega Saturn", "03000000811700007e05000000000000",
+  { {2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,13,0,1,1.f,0.f},{0},{0},{0},{2,17,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,15,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Cideko AK08b", "030000008305000031b0000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "iBuffalo USB 2-axis 8-button Gamepad", "03000000830500006020000000000000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "iBuffalo SNES Controller", "03000000830500006020000000010000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Razer Onza TE", "030000008916000000fd000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Piranha xtreme", "030000008f0e00000300000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "HuiJia SNES Controller", "030000008f0e00001330000011010000",
+  { {2,4,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,18,0,1,1.f,0.f},{0},{0},{0},{1,2,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,2,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "8Bitdo Zero GamePad", "03000000a00500003232000008010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Cyborg V.3 Rumble Pad", "03000000a306000022f6000001030000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,3,-1,1,2.f,-1.f},{0}},{{1,3,-1,1,-2.f,-1.f},{0}} } },
+{ "Gamestop BB-070 X360 Controller", "03000000ad1b000001f9000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Sega Saturn USB Gamepad", "03000000b40400000a01000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Tomee SNES USB Controller", "03000000bd12000015d0000000000000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Tomee SNES USB Controller", "03000000bd12000015d0000000010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Xbox 360 Wired Controller", "03000000c6240000045d000000000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "MC Cthulhu", "03000000d8140000cecf000000000000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "GameStop Gamepad", "0500000047532047616d657061640000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Wii Remote", "050000005769696d6f74652028303000",
+  { {2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{0},{2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,12,-1,1,2.f,-1.f},{0}},{{0},{0}} } },
+{ "Wii U Pro Controller", "050000005769696d6f74652028313800",
+  { {2,16,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,18,0,1,1.f,0.f},{2,17,0,1,1.f,0.f},{2,19,0,1,1.f,0.f},{2,20,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,23,0,1,1.f,0.f},{2,24,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,21,-1,1,2.f,-1.f},{0}},{{2,22,-1,1,2.f,-1.f},{0}} } },
+};
+#elif defined(_GLFW_ANDROID)
+const _GLFWmapping _glfwDefaultMappings[] =
+{
+{ "Steam Controller", "05000000de2800000511000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}} } },
+{ "Xbox Wireless Controller", "34356136633366613530316338376136",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,17,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,18,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "35643031303033326130316330353564",
+  { {2,1,0,1,1.f,0.f},{2,17,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,18,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,2.f,-1.f},{0}},{{1,4,-1,1,2.f,-1.f},{0}} } },
+{ "NVIDIA Controller", "37336435666338653565313731303834",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{0},{2,6,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "NVIDIA Controller", "4e564944494120436f72706f72617469",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{0},{2,6,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Twin USB Joystick", "5477696e20555342204a6f7973746963",
+  { {2,22,0,1,1.f,0.f},{2,21,0,1,1.f,0.f},{2,23,0,1,1.f,0.f},{2,20,0,1,1.f,0.f},{2,26,0,1,1.f,0.f},{2,27,0,1,1.f,0.f},{2,28,0,1,1.f,0.f},{2,29,0,1,1.f,0.f},{0},{2,30,0,1,1.f,0.f},{2,31,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,24,-1,1,2.f,-1.f},{0}},{{2,25,-1,1,2.f,-1.f},{0}} } },
+{ "NVIDIA Controller", "61363931656135336130663561616264",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{0},{2,6,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Microsoft X-Box 360 pad", "64633436313965656664373634323364",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{0},{0},{0},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+};
+#else
+const _GLFWmapping _glfwDefaultMappings[] =
+{
+{ "Xbox 360 Wireless Controller", "0000000058626f782033363020576900",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Xbox Gamepad (userspace driver)", "0000000058626f782047616d65706100",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "RetroUSB.com RetroPad", "0300000000f000000300000000010000",
+  { {2,1,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "RetroUSB.com Super RetroPort", "0300000000f00000f100000000010000",
+  { {2,1,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "8Bitdo NES30 Pro", "03000000022000000090000011010000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "Nostromo n45 Dual Analog Gamepad", "030000000d0500000308000010010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "hori", "030000000d0f00000d00000000010000",
+  { {2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "HORI CO. LTD. FIGHTING STICK 3", "030000000d0f00001000000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HORI CO. LTD. REAL ARCADE Pro.V3", "030000000d0f00002200000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Hori Fighting Commander 4 (PS4)", "030000000d0f00005e00000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Hori Fighting Commander 4 (PS3)", "030000000d0f00005f00000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HORIPAD 4 (PS4)", "030000000d0f00006600000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "HORIPAD ONE", "030000000d0f00006700000001010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "HORI CO. LTD. Real Arcade Pro.4", "030000000d0f00006a00000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "HORI CO. LTD. Real Arcade Pro.4", "030000000d0f00006b00000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HORIPAD 4 (PS3)", "030000000d0f00006e00000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Akishop Customs PS360+ v1.66", "03000000100000008200000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Twin USB PS2 Adapter", "03000000100800000100000010010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "NEXT SNES Controller", "030000001008000001e5000010010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "USB Gamepad", "03000000100800000300000010010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "ZEROPLUS P4 Gamepad", "03000000120c0000100e000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Sony PS2 pad with SmartJoy adapter", "03000000250900000500000000010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "Cyber Gadget GameCube Controller", "03000000260900008888000000010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{2,6,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{0},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,-1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Gravis GamePad Pro USB ", "03000000280400000140000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Jess Tech Dual Analog Rumble Pad", "03000000300f00001001000010010000",
+  { {2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "QanBa Arcade JoyStick", "03000000300f00001211000011010000",
+  { {2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}} } },
+{ "Razer Serval", "03000000321500000009000011010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Razer RAIJU", "03000000321500000010000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Razer Wildcat", "0300000032150000030a000001010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "GameCube {HuiJia USB box}", "03000000341a000005f7000010010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{0},{0},{0},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,15,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "PS3 Controller", "03000000341a00003608000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz Wired Xbox 360 Controller", "03000000380700001647000010040000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "MadCatz PC USB Wired Stick 8818", "03000000380700001888000010010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz Wired Xbox 360 Controller (SFIV)", "03000000380700003847000090040000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "MadCatz PC USB Wired Stick 8838", "03000000380700003888000010010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{1,0,0,1,0.5f,0.5f},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz FightPad PRO (PS3)", "03000000380700005032000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz FightPad PRO (PS4)", "03000000380700005082000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Mad Catz fightstick (PS3)", "03000000380700008034000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz fightstick (PS4)", "03000000380700008084000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Mad Catz FightStick TE S+ PS3", "03000000380700008433000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Mad Catz FightStick TE S+ PS4", "03000000380700008483000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "XEOX Gamepad SL-6556-BK", "03000000450c00002043000010010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "NYKO CORE", "03000000451300000830000010010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "PS3 Controller", "030000004c0500006802000010010000",
+  { {2,14,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "PS3 Controller", "030000004c0500006802000010810000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,15,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "PS3 Controller", "030000004c0500006802000011010000",
+  { {2,14,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "PS3 Controller", "030000004c0500006802000011810000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,15,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "030000004c050000a00b000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "030000004c050000a00b000011810000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "030000004c050000c405000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "030000004c050000c405000011810000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "030000004c050000cc09000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "030000004c050000cc09000011810000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Thrustmaster Firestorm Dual Power", "030000004f04000000b3000010010000",
+  { {2,0,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Thrustmaster Run N Drive Wireless", "030000004f04000008d0000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Thrustmaster Run N Drive Wireless PS3", "030000004f04000009d0000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Thrustmaster Dual Analog 4", "030000004f04000015b3000010010000",
+  { {2,0,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Thrustmaster 2 in 1 DT", "030000004f04000020b3000010010000",
+  { {2,0,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Thrustmaster Dual Trigger 3-in-1", "030000004f04000023b3000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "NVIDIA Controller", "03000000550900001072000011010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Old Xbox pad", "030000005e0400000202000000010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "X360 Wireless Controller", "030000005e0400001907000000010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,11,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Microsoft X-Box pad (Japan)", "030000005e0400008502000000010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Microsoft X-Box pad v2 (US)", "030000005e0400008902000021010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Microsoft X-Box 360 pad", "030000005e0400008e02000004010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "X360 Controller", "030000005e0400008e02000010010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "X360 Controller", "030000005e0400008e02000014010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "SpeedLink XEOX Pro Analog Gamepad pad", "030000005e0400008e02000020200000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Microsoft X-Box 360 pad", "030000005e0400008e02000062230000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Speedlink TORID Wireless Gamepad", "030000005e0400008e02000073050000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "X360 Wireless Controller", "030000005e0400009102000007010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,11,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "X360 Wireless Controller", "030000005e040000a102000000010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,11,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "X360 Wireless Controller", "030000005e040000a102000007010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Microsoft X-Box One pad", "030000005e040000d102000001010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Microsoft X-Box One pad v2", "030000005e040000d102000003020000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Super Joy Box 5 Pro", "03000000666600000488000000010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,15,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "boom PSX to PC Converter", "03000000666600006706000000010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,15,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "Revolution Pro Controller", "030000006b140000010d000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Logitech WingMan Cordless RumblePad", "030000006d04000011c2000010010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}},{{2,10,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech Logitech Extreme 3D", "030000006d04000015c2000010010000",
+  { {2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{3,8,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Logitech Dual Action", "030000006d04000016c2000010010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech Dual Action", "030000006d04000016c2000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech RumblePad 2", "030000006d04000018c2000010010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech Cordless RumblePad 2", "030000006d04000019c2000010010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech F710 Gamepad (DInput)", "030000006d04000019c2000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logitech F310 Gamepad (XInput)", "030000006d0400001dc2000014400000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Logitech F510 Gamepad (XInput)", "030000006d0400001ec2000020200000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Logitech F710 Gamepad (XInput)", "030000006d0400001fc2000005030000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "JC-U3613M - DirectInput Mode", "030000006e0500000320000010010000",
+  { {2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Logic3 Controller", "030000006f0e00000103000000020000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Gamestop Logic3 Controller", "030000006f0e00000104000000010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Generic X-Box pad", "030000006f0e00001304000000010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{1,0,0,1,0.5f,0.5f},{1,3,0,1,0.5f,0.5f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Rock Candy Gamepad for PS3", "030000006f0e00001e01000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Generic X-Box pad", "030000006f0e00001f01000000010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "EA Sports PS3 Controller", "030000006f0e00003001000001010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Afterglow Wired Controller for Xbox One", "030000006f0e00003901000020060000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Rock Candy Wired Controller for Xbox One", "030000006f0e00004601000001010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "PDP Battlefield One", "030000006f0e00006401000001010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Microntek USB Joystick", "03000000780000000600000010010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "DragonRise Inc. Generic USB Joystick", "03000000790000000600000010010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "USB Gamepad1", "03000000790000001100000000010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{0},{0},{0},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{1,4,0,1,0.5f,0.5f},{1,2,0,1,0.5f,0.5f},{1,0,0,1,0.5f,0.5f},{1,1,0,1,0.5f,0.5f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Retrolink SNES Controller", "03000000790000001100000010010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Mayflash GameCube Controller", "03000000790000004418000010010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{0},{0},{0},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,15,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "iBuffalo SNES Controller", "03000000830500006020000010010000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Razer Onza Tournament", "030000008916000000fd000024010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,11,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Razer Onza Classic Edition", "030000008916000001fd000024010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,11,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "GreenAsia Inc. USB Joystick", "030000008f0e00000300000010010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "GreenAsia Electronics 4Axes 12Keys GamePad ", "030000008f0e00000610000000010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "GreenAsia Inc. USB Joystick", "030000008f0e00001200000010010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HuiJia SNES Controller", "030000008f0e00001330000010010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "raphnet.net 4nes4snes v1.5", "030000009b2800000300000001010000",
+  { {2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Saitek P880", "03000000a30600000901000000010000",
+  { {2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{0},{0},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Saitek P990 Dual Analog Pad", "03000000a30600000b04000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Saitek P2900 Wireless Pad", "03000000a30600000c04000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "Saitek P2500 Force Rumble Pad", "03000000a30600000cff000010010000",
+  { {2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Saitek PLC Saitek P3200 Rumble Pad", "03000000a306000018f5000010010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Cyborg V.3 Rumble Pad", "03000000a306000022f6000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,3,-1,1,2.f,-1.f},{0}},{{1,3,-1,1,-2.f,-1.f},{0}} } },
+{ "Saitek Cyborg V.1 Game Pad", "03000000a306000023f6000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Hori Pad EX Turbo 2", "03000000ad1b000001f5000033050000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Mad Catz Xbox 360 Controller", "03000000ad1b000016f0000090040000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Mad Catz Fightpad SFxT", "03000000ad1b00002ef0000090040000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "CYPRESS USB Gamepad", "03000000b40400000a01000000010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "impact", "03000000b50700001503000010010000",
+  { {2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Jess Technology USB Game Controller", "03000000ba2200002010000001010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Tomee SNES USB Controller", "03000000bd12000015d0000010010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Serial/Keyboard/Mouse/Joystick", "03000000c01600008704000011010000",
+  { {2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{2,14,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f} },
+  { {{1,1,-1,1,1.f,0.f},{0}},{{1,0,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Xin-Mo Xin-Mo Dual Arcade", "03000000c0160000e105000001010000",
+  { {2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{2,11,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Razer Sabertooth", "03000000c6240000045d000025010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "8Bitdo NES30 Pro 8Bitdo NES30 Pro", "03000000c82d00000190000011010000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "HJC Game GAMEPAD", "03000000c9110000f055000011010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Toodles 2008 Chimp PC/PS3", "03000000d814000007cd000011010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "HitBox (PS3/PC) Analog Mode", "03000000d81400000862000011010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Steam Controller", "03000000de2800000112000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}} } },
+{ "Steam Controller", "03000000de2800000211000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}} } },
+{ "Steam Controller", "03000000de2800004211000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}} } },
+{ "Steam Controller", "03000000de280000fc11000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Steam Virtual Gamepad", "03000000de280000ff11000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Cideko AK08b", "03000000e82000006058000001010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "ShanWan Gioteck PS3 Wired Controller", "03000000f025000021c1000010010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Goodbetterbest Ltd USB Controller", "03000000f0250000c183000010010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "InterAct GoPad I-73000 (Fighting Game Layout)", "03000000fd0500000030000000010000",
+  { {2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{0},{2,2,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "PC Game Controller", "03000000ff1100003133000010010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "PS2 Controller", "03000000ff1100004133000010010000",
+  { {2,2,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "Nintendo Wiimote", "05000000010000000100000003000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "ASUS Gamepad", "05000000050b00000045000031000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "8Bitdo SFC30 GamePad", "05000000102800000900000000010000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "XiaoMi Game Controller", "05000000172700004431000029010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,20,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,7,-1,1,1.f,0.f},{0}},{{1,6,-1,1,1.f,0.f},{0}} } },
+{ "8Bitdo NES30 Pro", "05000000203800000900000000010000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "Razer Serval", "050000003215000000090000163a0000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "OUYA Game Controller", "05000000362800000100000002010000",
+  { {2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{0},{2,14,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "OUYA Game Controller", "05000000362800000100000003010000",
+  { {2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{0},{2,14,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Mad Catz C.T.R.L.R ", "05000000380700006652000025010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "GameStop Gamepad", "0500000047532047616d657061640000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "GS gamepad", "0500000047532067616d657061640000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{2,9,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "PS3 Controller", "050000004c0500006802000000010000",
+  { {2,14,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,12,-1,1,1.f,0.f},{0}},{{1,13,-1,1,1.f,0.f},{0}} } },
+{ "PS3 Controller", "050000004c0500006802000000810000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,15,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "050000004c050000c405000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "050000004c050000c405000000810000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "050000004c050000cc09000000010000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "PS4 Controller", "050000004c050000cc09000000810000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "PS3 Controller (Bluetooth)", "05000000504c415953544154494f4e00",
+  { {2,14,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "Xbox One Wireless Controller", "050000005e040000e002000003090000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+{ "Xbox One Wireless Controller", "050000005e040000fd02000003090000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "idroid:con", "050000006964726f69643a636f6e0000",
+  { {2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Nintendo Switch Pro Controller", "050000007e0500000920000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "Nintendo Wii Remote Pro Controller", "050000007e0500003003000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{2,15,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,6,-1,1,2.f,-1.f},{0}},{{2,7,-1,1,2.f,-1.f},{0}} } },
+{ "8Bitdo Zero GamePad", "05000000a00500003232000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "8Bitdo Zero GamePad", "05000000a00500003232000008010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{0},{0},{1,1,0,1,-1.f,0.f},{1,0,0,1,1.f,0.f},{1,1,0,1,1.f,0.f},{1,0,0,1,-1.f,0.f} },
+  { {{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "VR-BOX", "05000000ac0500003232000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{2,4,-1,1,2.f,-1.f},{0}},{{2,5,-1,1,2.f,-1.f},{0}} } },
+{ "8Bitdo NES30 Pro", "05000000c82d00002038000000010000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,14,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "8Bitdo SFC30 GamePad", "05000000c82d00003028000000010000",
+  { {2,1,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{0},{0},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{0},{0}},{{0},{0}} } },
+{ "Moga Pro", "05000000d6200000ad0d000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{0},{2,6,0,1,1.f,0.f},{0},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}} } },
+{ "Steam Controller", "05000000de2800000212000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}} } },
+{ "Steam Controller", "05000000de2800000511000001000000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{0},{0},{0},{0},{0} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{0},{0}},{{0},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}} } },
+{ "PS3 Controller (Bluetooth)", "060000004c0500006802000000010000",
+  { {2,14,0,1,1.f,0.f},{2,13,0,1,1.f,0.f},{2,15,0,1,1.f,0.f},{2,12,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{2,11,0,1,1.f,0.f},{2,0,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,16,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{2,8,-1,1,2.f,-1.f},{0}},{{2,9,-1,1,2.f,-1.f},{0}} } },
+{ "Hidromancer Game Controller", "06000000adde0000efbe000002010000",
+  { {2,0,0,1,1.f,0.f},{2,1,0,1,1.f,0.f},{2,2,0,1,1.f,0.f},{2,3,0,1,1.f,0.f},{2,4,0,1,1.f,0.f},{2,5,0,1,1.f,0.f},{2,6,0,1,1.f,0.f},{2,7,0,1,1.f,0.f},{2,8,0,1,1.f,0.f},{2,9,0,1,1.f,0.f},{2,10,0,1,1.f,0.f},{3,1,0,1,1.f,0.f},{3,2,0,1,1.f,0.f},{3,4,0,1,1.f,0.f},{3,8,0,1,1.f,0.f} },
+  { {{1,0,-1,1,1.f,0.f},{0}},{{1,1,-1,1,1.f,0.f},{0}},{{1,3,-1,1,1.f,0.f},{0}},{{1,4,-1,1,1.f,0.f},{0}},{{1,2,-1,1,1.f,0.f},{0}},{{1,5,-1,1,1.f,0.f},{0}} } },
+};
+#endif
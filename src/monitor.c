@@ -115,18 +115,35 @@ void _glfwInputMonitor(_GLFWmonitor* monitor, int action, int placement)
     else if (action == GLFW_DISCONNECTED)
     {
         int i;
-        _GLFWwindow* window;
 
-        for (window = _glfw.windowListHead;  window;  window = window->next)
+        // The window list is only locked while searching it, as leaving full
+        // screen mode may call back into the application
+        for (;;)
         {
-            if (window->monitor == monitor)
+            int width, height, xoff, yoff;
+            _GLFWwindow* window;
+
+            _glfwPlatformLockMutex(&_glfw.windowLock);
+
+            for (window = _glfw.windowListHead;  window;  window = window->next)
             {
-                int width, height, xoff, yoff;
-                _glfwPlatformGetWindowSize(window, &width, &height);
-                _glfwPlatformSetWindowMonitor(window, NULL, 0, 0, width, height, 0);
-                _glfwPlatformGetWindowFrameSize(window, &xoff, &yoff, NULL, NULL);
-                _glfwPlatformSetWindowPos(window, xoff, yoff);
+                if (window->monitor == monitor)
+                    break;
             }
+
+            _glfwPlatformUnlockMutex(&_glfw.windowLock);
+
+            if (!window)
+                break;
+
+            _glfwPlatformGetWindowSize(window, &width, &height);
+            _glfwPlatformSetWindowMonitor(window, NULL, 0, 0, width, height, 0);
+            window->context.resized = GLFW_TRUE;
+            _glfwPlatformGetWindowFrameSize(window, &xoff, &yoff, NULL, NULL);
+            _glfwPlatformSetWindowPos(window, xoff, yoff);
+
+            // Make sure the search moves on even if the platform did not
+            _glfwInputWindowMonitor(window, NULL);
         }
 
         for (i = 0;  i < _glfw.monitorCount;  i++)
@@ -54,6 +54,8 @@ typedef struct _GLFWlibraryNSGL
     // dlopen handle for OpenGL.framework (for glfwGetProcAddress)
     CFBundleRef     framework;
 
+    _GLFWproccache  procs;
+
 } _GLFWlibraryNSGL;
 
 
@@ -90,10 +90,10 @@ static void swapIntervalNSGL(int interval)
     } // autoreleasepool
 }
 
-static int extensionSupportedNSGL(const char* extension)
+static const char* getExtensionsNSGL(void)
 {
     // There are no NSGL extensions
-    return GLFW_FALSE;
+    return NULL;
 }
 
 static GLFWglproc getProcAddressNSGL(const char* procname)
@@ -151,6 +151,7 @@ GLFWbool _glfwInitNSGL(void)
 //
 void _glfwTerminateNSGL(void)
 {
+    _glfwFreeProcCache(&_glfw.nsgl.procs);
 }
 
 // Create the OpenGL context
@@ -334,15 +335,21 @@ GLFWbool _glfwCreateContextNSGL(_GLFWwindow* window,
                                   forParameter:NSOpenGLContextParameterSurfaceOpacity];
     }
 
-    [window->ns.view setWantsBestResolutionOpenGLSurface:window->ns.retina];
+    // An NSOpenGLContext without a view can be made current and render to
+    // framebuffer objects, which is all a windowless context needs
+    if (!window->windowless)
+    {
+        [window->ns.view setWantsBestResolutionOpenGLSurface:window->ns.retina];
 
-    [window->context.nsgl.object setView:window->ns.view];
+        [window->context.nsgl.object setView:window->ns.view];
+    }
 
     window->context.makeCurrent = makeContextCurrentNSGL;
     window->context.swapBuffers = swapBuffersNSGL;
     window->context.swapInterval = swapIntervalNSGL;
-    window->context.extensionSupported = extensionSupportedNSGL;
+    window->context.getExtensions = getExtensionsNSGL;
     window->context.getProcAddress = getProcAddressNSGL;
+    window->context.procCache = &_glfw.nsgl.procs;
     window->context.destroy = destroyContextNSGL;
 
     return GLFW_TRUE;
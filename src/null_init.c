@@ -29,6 +29,8 @@
 
 #include "internal.h"
 
+#include <stdlib.h>
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -37,16 +39,37 @@
 int _glfwPlatformInit(void)
 {
     _glfwInitTimerPOSIX();
+
+    if (pthread_mutex_init(&_glfw.null.lock, NULL) != 0 ||
+        pthread_mutex_init(&_glfw.null.contextLock, NULL) != 0 ||
+        pthread_cond_init(&_glfw.null.cond, NULL) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to create event queue lock");
+        return GLFW_FALSE;
+    }
+
     return GLFW_TRUE;
 }
 
 void _glfwPlatformTerminate(void)
 {
+    _glfwTerminateJoysticksNull();
+    _glfwTerminateEGL();
     _glfwTerminateOSMesa();
+
+    pthread_cond_destroy(&_glfw.null.cond);
+    pthread_mutex_destroy(&_glfw.null.contextLock);
+    pthread_mutex_destroy(&_glfw.null.lock);
+
+    free(_glfw.null.pending.events);
+    free(_glfw.null.pending.touches);
+    free(_glfw.null.dispatch.events);
+    free(_glfw.null.dispatch.touches);
 }
 
 const char* _glfwPlatformGetVersionString(void)
 {
-    return _GLFW_VERSION_NUMBER " null OSMesa";
+    return _GLFW_VERSION_NUMBER " null OSMesa EGL";
 }
 
@@ -29,13 +29,31 @@
 #include "internal.h"
 
 
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Frees the joysticks recreated by an input log replay
+//
+void _glfwTerminateJoysticksNull(void)
+{
+    for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        _GLFWjoystick* js = _glfw.joysticks + jid;
+        if (js->present)
+            _glfwFreeJoystick(js);
+    }
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
 //////////////////////////////////////////////////////////////////////////
 
 int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode)
 {
-    return GLFW_FALSE;
+    // Only replayed joysticks exist here and their state is already current
+    return js->present;
 }
 
 void _glfwPlatformUpdateGamepadGUID(char* guid)
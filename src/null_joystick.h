@@ -29,3 +29,5 @@
 
 #define _GLFW_PLATFORM_MAPPING_NAME ""
 
+void _glfwTerminateJoysticksNull(void);
+
@@ -26,17 +26,19 @@
 //========================================================================
 
 #include <dlfcn.h>
+#include <pthread.h>
 
 #define _GLFW_PLATFORM_WINDOW_STATE _GLFWwindowNull null
 
 #define _GLFW_PLATFORM_CONTEXT_STATE         struct { int dummyContext; }
 #define _GLFW_PLATFORM_MONITOR_STATE         struct { int dummyMonitor; }
 #define _GLFW_PLATFORM_CURSOR_STATE          struct { int dummyCursor; }
-#define _GLFW_PLATFORM_LIBRARY_WINDOW_STATE  struct { int dummyLibraryWindow; }
+#define _GLFW_PLATFORM_LIBRARY_WINDOW_STATE  _GLFWlibraryNull null
 #define _GLFW_PLATFORM_LIBRARY_CONTEXT_STATE struct { int dummyLibraryContext; }
-#define _GLFW_EGL_CONTEXT_STATE              struct { int dummyEGLContext; }
-#define _GLFW_EGL_LIBRARY_CONTEXT_STATE      struct { int dummyEGLLibraryContext; }
 
+#define _GLFW_EGL_HEADLESS
+
+#include "egl_context.h"
 #include "osmesa_context.h"
 #include "posix_time.h"
 #include "posix_thread.h"
@@ -52,6 +54,11 @@
  #define _glfw_dlsym(handle, name) dlsym(handle, name)
 #endif
 
+#define _GLFW_NULL_EVENT_KEY           1
+#define _GLFW_NULL_EVENT_CHAR          2
+#define _GLFW_NULL_EVENT_MULTITOUCH    3
+#define _GLFW_NULL_EVENT_WINDOW_SIZE   4
+
 // Null-specific per-window data
 //
 typedef struct _GLFWwindowNull
@@ -60,3 +67,49 @@ typedef struct _GLFWwindowNull
     int height;
 } _GLFWwindowNull;
 
+// Null-specific injected input event
+//
+typedef struct _GLFWeventNull
+{
+    int                 type;
+    _GLFWwindow*        window;
+    int                 mods;
+    int                 key;
+    int                 scancode;
+    int                 action;
+    unsigned int        codepoint;
+    int                 width;
+    int                 height;
+    // Range of the touch array holding the multitouch events
+    int                 first;
+    int                 count;
+} _GLFWeventNull;
+
+// Null-specific queue of injected input events
+// The touch array holds the multitouch events referenced by the queue
+//
+typedef struct _GLFWqueueNull
+{
+    _GLFWeventNull*     events;
+    int                 count;
+    int                 capacity;
+    GLFWinputEvent*     touches;
+    int                 touchCount;
+    int                 touchCapacity;
+} _GLFWqueueNull;
+
+// Null-specific global data
+//
+typedef struct _GLFWlibraryNull
+{
+    // Events are injected into one queue while the other is being dispatched
+    pthread_mutex_t     lock;
+    pthread_cond_t      cond;
+    GLFWbool            wakeup;
+    _GLFWqueueNull      pending;
+    _GLFWqueueNull      dispatch;
+    // Serializes the loading of context libraries and context creation, as
+    // windows may be created on any thread
+    pthread_mutex_t     contextLock;
+} _GLFWlibraryNull;
+
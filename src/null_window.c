@@ -29,6 +29,13 @@
 
 #include "internal.h"
 
+#include <assert.h>
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
 
 static int createNativeWindow(_GLFWwindow* window,
                               const _GLFWwndconfig* wndconfig)
@@ -39,6 +46,100 @@ static int createNativeWindow(_GLFWwindow* window,
     return GLFW_TRUE;
 }
 
+// Appends an event to the pending queue
+// The queue lock must be held by the caller
+//
+static _GLFWeventNull* pushEvent(int type, _GLFWwindow* window, int mods)
+{
+    _GLFWqueueNull* queue = &_glfw.null.pending;
+    _GLFWeventNull* event;
+
+    if (queue->count == queue->capacity)
+    {
+        const int capacity = queue->capacity ? queue->capacity * 2 : 256;
+        _GLFWeventNull* events =
+            realloc(queue->events, capacity * sizeof(_GLFWeventNull));
+        if (!events)
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return NULL;
+        }
+
+        queue->events = events;
+        queue->capacity = capacity;
+    }
+
+    event = queue->events + queue->count++;
+    memset(event, 0, sizeof(_GLFWeventNull));
+    event->type = type;
+    event->window = window;
+    event->mods = mods;
+    return event;
+}
+
+// Dispatches all events injected before this call
+//
+static void dispatchEvents(void)
+{
+    _GLFWqueueNull* queue = &_glfw.null.dispatch;
+    _GLFWqueueNull swap;
+
+    // Swap the queues so other threads can keep injecting while dispatching
+    pthread_mutex_lock(&_glfw.null.lock);
+    swap = _glfw.null.pending;
+    _glfw.null.pending = *queue;
+    *queue = swap;
+    _glfw.null.wakeup = GLFW_FALSE;
+    pthread_mutex_unlock(&_glfw.null.lock);
+
+    for (int i = 0;  i < queue->count;  i++)
+    {
+        const _GLFWeventNull* event = queue->events + i;
+        _GLFWwindow* window = event->window;
+
+        // The window was destroyed after this event was injected
+        if (!window)
+            continue;
+
+        switch (event->type)
+        {
+            case _GLFW_NULL_EVENT_KEY:
+                _glfwInputKey(window, event->key, event->scancode,
+                              event->action, event->mods);
+                break;
+
+            case _GLFW_NULL_EVENT_CHAR:
+                _glfwInputChar(window, event->codepoint, event->mods,
+                               !(event->mods & (GLFW_MOD_CONTROL | GLFW_MOD_ALT)));
+                break;
+
+            case _GLFW_NULL_EVENT_MULTITOUCH:
+                _glfwInputMulitouchEvents(window,
+                                          queue->touches + event->first,
+                                          event->count, event->mods);
+                break;
+
+            case _GLFW_NULL_EVENT_WINDOW_SIZE:
+                if (window->null.width != event->width ||
+                    window->null.height != event->height)
+                {
+                    window->null.width = event->width;
+                    window->null.height = event->height;
+                    _glfwInputFramebufferSize(window, event->width, event->height);
+                    _glfwInputWindowSize(window, event->width, event->height);
+                }
+                break;
+        }
+    }
+
+    // The allocations are kept for reuse by the next swap, and windows being
+    // destroyed on other threads may be reading the count
+    pthread_mutex_lock(&_glfw.null.lock);
+    queue->count = 0;
+    queue->touchCount = 0;
+    pthread_mutex_unlock(&_glfw.null.lock);
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -54,28 +155,69 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
 
     if (ctxconfig->client != GLFW_NO_API)
     {
-        if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API ||
-            ctxconfig->source == GLFW_OSMESA_CONTEXT_API)
-        {
-            if (!_glfwInitOSMesa())
-                return GLFW_FALSE;
-            if (!_glfwCreateContextOSMesa(window, ctxconfig, fbconfig))
-                return GLFW_FALSE;
-        }
-        else
-        {
-            _glfwInputError(GLFW_API_UNAVAILABLE, "Null: EGL not available");
+        if (!_glfwPlatformCreateContext(window, ctxconfig, fbconfig))
             return GLFW_FALSE;
-        }
     }
 
     return GLFW_TRUE;
 }
 
-void _glfwPlatformDestroyWindow(_GLFWwindow* window)
+int _glfwPlatformCreateContext(_GLFWwindow* window,
+                               const _GLFWctxconfig* ctxconfig,
+                               const _GLFWfbconfig* fbconfig)
 {
+    GLFWbool result = GLFW_FALSE;
+
+    // The context libraries are loaded on first use and their config and
+    // entry point caches are shared by all windows
+    pthread_mutex_lock(&_glfw.null.contextLock);
+
+    if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API ||
+        ctxconfig->source == GLFW_OSMESA_CONTEXT_API)
+    {
+        if (_glfwInitOSMesa())
+            result = _glfwCreateContextOSMesa(window, ctxconfig, fbconfig);
+    }
+    else if (ctxconfig->source == GLFW_EGL_CONTEXT_API)
+    {
+        if (_glfwInitEGL())
+            result = _glfwCreateContextEGL(window, ctxconfig, fbconfig);
+    }
+
+    pthread_mutex_unlock(&_glfw.null.contextLock);
+    return result;
+}
+
+void _glfwPlatformDestroyContext(_GLFWwindow* window)
+{
+    // Destroying a context may also touch the shared library state
+    pthread_mutex_lock(&_glfw.null.contextLock);
+
     if (window->context.destroy)
         window->context.destroy(window);
+
+    pthread_mutex_unlock(&_glfw.null.contextLock);
+}
+
+void _glfwPlatformDestroyWindow(_GLFWwindow* window)
+{
+    pthread_mutex_lock(&_glfw.null.lock);
+
+    for (int i = 0;  i < _glfw.null.pending.count;  i++)
+    {
+        if (_glfw.null.pending.events[i].window == window)
+            _glfw.null.pending.events[i].window = NULL;
+    }
+
+    for (int i = 0;  i < _glfw.null.dispatch.count;  i++)
+    {
+        if (_glfw.null.dispatch.events[i].window == window)
+            _glfw.null.dispatch.events[i].window = NULL;
+    }
+
+    pthread_mutex_unlock(&_glfw.null.lock);
+
+    _glfwPlatformDestroyContext(window);
 }
 
 void _glfwPlatformSetWindowTitle(_GLFWwindow* window, const char* title)
@@ -245,18 +387,54 @@ int _glfwPlatformWindowVisible(_GLFWwindow* window)
 
 void _glfwPlatformPollEvents(void)
 {
+    dispatchEvents();
 }
 
 void _glfwPlatformWaitEvents(void)
 {
+    pthread_mutex_lock(&_glfw.null.lock);
+
+    while (!_glfw.null.pending.count && !_glfw.null.wakeup)
+        pthread_cond_wait(&_glfw.null.cond, &_glfw.null.lock);
+
+    pthread_mutex_unlock(&_glfw.null.lock);
+
+    dispatchEvents();
 }
 
 void _glfwPlatformWaitEventsTimeout(double timeout)
 {
+    struct timeval now;
+    struct timespec deadline;
+    double seconds;
+
+    gettimeofday(&now, NULL);
+    seconds = now.tv_sec + now.tv_usec / 1e6 + timeout;
+    deadline.tv_sec = (time_t) seconds;
+    deadline.tv_nsec = (long) ((seconds - floor(seconds)) * 1e9);
+
+    pthread_mutex_lock(&_glfw.null.lock);
+
+    while (!_glfw.null.pending.count && !_glfw.null.wakeup)
+    {
+        if (pthread_cond_timedwait(&_glfw.null.cond, &_glfw.null.lock,
+                                   &deadline) == ETIMEDOUT)
+        {
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&_glfw.null.lock);
+
+    dispatchEvents();
 }
 
 void _glfwPlatformPostEmptyEvent(void)
 {
+    pthread_mutex_lock(&_glfw.null.lock);
+    _glfw.null.wakeup = GLFW_TRUE;
+    pthread_cond_signal(&_glfw.null.cond);
+    pthread_mutex_unlock(&_glfw.null.lock);
 }
 
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
@@ -330,3 +508,149 @@ VkResult _glfwPlatformCreateWindowSurface(VkInstance instance,
     return VK_ERROR_INITIALIZATION_FAILED;
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+//////                        GLFW native API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWAPI void glfwNullInjectKey(GLFWwindow* handle,
+                               int key, int scancode, int action, int mods)
+{
+    _GLFWeventNull* event;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (key != GLFW_KEY_UNKNOWN && (key < GLFW_KEY_SPACE || key > GLFW_KEY_LAST))
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid key %i", key);
+        return;
+    }
+
+    if (action != GLFW_PRESS && action != GLFW_RELEASE && action != GLFW_REPEAT)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid key action %i", action);
+        return;
+    }
+
+    pthread_mutex_lock(&_glfw.null.lock);
+
+    event = pushEvent(_GLFW_NULL_EVENT_KEY, window, mods);
+    if (event)
+    {
+        event->key = key;
+        event->scancode = scancode;
+        event->action = action;
+        pthread_cond_signal(&_glfw.null.cond);
+    }
+
+    pthread_mutex_unlock(&_glfw.null.lock);
+}
+
+GLFWAPI void glfwNullInjectChar(GLFWwindow* handle,
+                                unsigned int codepoint, int mods)
+{
+    _GLFWeventNull* event;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    pthread_mutex_lock(&_glfw.null.lock);
+
+    event = pushEvent(_GLFW_NULL_EVENT_CHAR, window, mods);
+    if (event)
+    {
+        event->codepoint = codepoint;
+        pthread_cond_signal(&_glfw.null.cond);
+    }
+
+    pthread_mutex_unlock(&_glfw.null.lock);
+}
+
+GLFWAPI void glfwNullInjectMultitouch(GLFWwindow* handle,
+                                      const GLFWinputEvent* events,
+                                      int count, int mods)
+{
+    _GLFWqueueNull* queue = &_glfw.null.pending;
+    _GLFWeventNull* event;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(events != NULL || count == 0);
+    assert(count >= 0);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (count < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid event count %i", count);
+        return;
+    }
+
+    pthread_mutex_lock(&_glfw.null.lock);
+
+    if (queue->touchCount + count > queue->touchCapacity)
+    {
+        int capacity = queue->touchCapacity ? queue->touchCapacity : 256;
+        GLFWinputEvent* touches;
+
+        while (capacity < queue->touchCount + count)
+            capacity *= 2;
+
+        touches = realloc(queue->touches, capacity * sizeof(GLFWinputEvent));
+        if (!touches)
+        {
+            pthread_mutex_unlock(&_glfw.null.lock);
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return;
+        }
+
+        queue->touches = touches;
+        queue->touchCapacity = capacity;
+    }
+
+    event = pushEvent(_GLFW_NULL_EVENT_MULTITOUCH, window, mods);
+    if (event)
+    {
+        event->first = queue->touchCount;
+        event->count = count;
+        if (count)
+            memcpy(queue->touches + queue->touchCount, events, count * sizeof(GLFWinputEvent));
+        queue->touchCount += count;
+        pthread_cond_signal(&_glfw.null.cond);
+    }
+
+    pthread_mutex_unlock(&_glfw.null.lock);
+}
+
+GLFWAPI void glfwNullInjectWindowSize(GLFWwindow* handle, int width, int height)
+{
+    _GLFWeventNull* event;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(width >= 0);
+    assert(height >= 0);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (width < 0 || height < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid window size %ix%i", width, height);
+        return;
+    }
+
+    pthread_mutex_lock(&_glfw.null.lock);
+
+    event = pushEvent(_GLFW_NULL_EVENT_WINDOW_SIZE, window, 0);
+    if (event)
+    {
+        event->width = width;
+        event->height = height;
+        pthread_cond_signal(&_glfw.null.cond);
+    }
+
+    pthread_mutex_unlock(&_glfw.null.lock);
+}
+
@@ -34,35 +34,89 @@
 #include "internal.h"
 
 
+// Frees the allocated buffers of the specified window, keeping their count
+//
+static void freeBuffers(_GLFWwindow* window)
+{
+    int i;
+
+    for (i = 0;  i < _GLFW_OSMESA_MAX_BUFFERS;  i++)
+    {
+        free(window->context.osmesa.buffers[i]);
+        window->context.osmesa.buffers[i] = NULL;
+        window->context.osmesa.sizes[i] = 0;
+    }
+}
+
 static void makeContextCurrentOSMesa(_GLFWwindow* window)
 {
     if (window)
     {
-        int width, height;
-        _glfwPlatformGetFramebufferSize(window, &width, &height);
+        void* buffer;
+        int width, height, rowLength;
 
-        // Check to see if we need to allocate a new buffer
-        if ((window->context.osmesa.buffer == NULL) ||
-            (width != window->context.osmesa.width) ||
-            (height != window->context.osmesa.height))
+        if (window->context.osmesa.userBuffer)
         {
-            free(window->context.osmesa.buffer);
-
-            // Allocate the new buffer (width * height * 8-bit RGBA)
-            window->context.osmesa.buffer = calloc(4, (size_t) width * height);
-            window->context.osmesa.width  = width;
-            window->context.osmesa.height = height;
+            buffer = window->context.osmesa.userBuffer;
+            width = window->context.osmesa.userWidth;
+            height = window->context.osmesa.userHeight;
+            rowLength = window->context.osmesa.userRowLength;
+        }
+        else
+        {
+            size_t size;
+            const int current = window->context.osmesa.current;
+
+            // The framebuffer size is only queried after it has changed
+            if (window->context.resized)
+            {
+                _glfwPlatformGetFramebufferSize(window, &width, &height);
+                window->context.osmesa.width  = width;
+                window->context.osmesa.height = height;
+                window->context.resized = GLFW_FALSE;
+            }
+
+            size = 4 * (size_t) window->context.osmesa.width *
+                       window->context.osmesa.height;
+            if (size < 4)
+                size = 4;
+
+            // Only the buffer about to be rendered into is reallocated, as the
+            // others may still be held by the frame callback and are grown
+            // when the ring comes back to them
+            if (size > window->context.osmesa.sizes[current])
+            {
+                free(window->context.osmesa.buffers[current]);
+                window->context.osmesa.buffers[current] = calloc(1, size);
+                if (!window->context.osmesa.buffers[current])
+                {
+                    window->context.osmesa.sizes[current] = 0;
+                    _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                    return;
+                }
+
+                window->context.osmesa.sizes[current] = size;
+            }
+
+            buffer = window->context.osmesa.buffers[window->context.osmesa.current];
+            width = window->context.osmesa.width;
+            height = window->context.osmesa.height;
+            rowLength = 0;
         }
 
         if (!OSMesaMakeCurrent(window->context.osmesa.handle,
-                               window->context.osmesa.buffer,
-                               GL_UNSIGNED_BYTE,
+                               buffer, GL_UNSIGNED_BYTE,
                                width, height))
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
                             "OSMesa: Failed to make context current");
             return;
         }
+
+        // The row length is kept by the context across make current calls, so
+        // it is always set, with zero meaning the width of the buffer
+        if (OSMesaPixelStore)
+            OSMesaPixelStore(OSMESA_ROW_LENGTH, rowLength);
     }
 
     _glfwPlatformSetTls(&_glfw.contextSlot, window);
@@ -81,17 +135,57 @@ static void destroyContextOSMesa(_GLFWwindow* window)
         window->context.osmesa.handle = NULL;
     }
 
-    if (window->context.osmesa.buffer)
-    {
-        free(window->context.osmesa.buffer);
-        window->context.osmesa.width = 0;
-        window->context.osmesa.height = 0;
-    }
+    freeBuffers(window);
+    window->context.osmesa.width = 0;
+    window->context.osmesa.height = 0;
 }
 
 static void swapBuffersOSMesa(_GLFWwindow* window)
 {
-    // No double buffering on OSMesa
+    const void* buffer;
+    int width, height, pitch;
+    const int count = window->context.osmesa.bufferCount;
+
+    // With a single buffer and no one to notify there is nothing to do
+    if (count == 1 && !window->context.osmesa.frame)
+        return;
+
+    // OSMesa may render on other threads, so the frame has to be finished
+    // before it is handed out
+    if (_glfwPlatformGetTls(&_glfw.contextSlot) == window)
+        window->context.osmesa.Finish();
+
+    if (window->context.osmesa.userBuffer)
+    {
+        buffer = window->context.osmesa.userBuffer;
+        width = window->context.osmesa.userWidth;
+        height = window->context.osmesa.userHeight;
+        pitch = window->context.osmesa.userRowLength * 4;
+    }
+    else
+    {
+        buffer = window->context.osmesa.buffers[window->context.osmesa.current];
+        width = window->context.osmesa.width;
+        height = window->context.osmesa.height;
+        pitch = width * 4;
+
+        if (count > 1)
+        {
+            window->context.osmesa.current =
+                (window->context.osmesa.current + 1) % count;
+
+            // A context that is not current will render into the next buffer
+            // when it is next made current
+            if (_glfwPlatformGetTls(&_glfw.contextSlot) == window)
+                makeContextCurrentOSMesa(window);
+        }
+    }
+
+    if (buffer && window->context.osmesa.frame)
+    {
+        window->context.osmesa.frame((GLFWwindow*) window,
+                                     buffer, width, height, pitch);
+    }
 }
 
 static void swapIntervalOSMesa(int interval)
@@ -99,10 +193,10 @@ static void swapIntervalOSMesa(int interval)
     // No swap interval on OSMesa
 }
 
-static int extensionSupportedOSMesa(const char* extension)
+static const char* getExtensionsOSMesa(void)
 {
     // OSMesa does not have extensions
-    return GLFW_FALSE;
+    return NULL;
 }
 
 
@@ -161,6 +255,8 @@ GLFWbool _glfwInitOSMesa(void)
         _glfw_dlsym(_glfw.osmesa.handle, "OSMesaGetDepthBuffer");
     _glfw.osmesa.GetProcAddress = (PFN_OSMesaGetProcAddress)
         _glfw_dlsym(_glfw.osmesa.handle, "OSMesaGetProcAddress");
+    _glfw.osmesa.PixelStore = (PFN_OSMesaPixelStore)
+        _glfw_dlsym(_glfw.osmesa.handle, "OSMesaPixelStore");
 
     if (!_glfw.osmesa.CreateContextExt ||
         !_glfw.osmesa.DestroyContext ||
@@ -181,6 +277,8 @@ GLFWbool _glfwInitOSMesa(void)
 
 void _glfwTerminateOSMesa(void)
 {
+    _glfwFreeProcCache(&_glfw.osmesa.procs);
+
     if (_glfw.osmesa.handle)
     {
         _glfw_dlclose(_glfw.osmesa.handle);
@@ -275,13 +373,35 @@ GLFWbool _glfwCreateContextOSMesa(_GLFWwindow* window,
         return GLFW_FALSE;
     }
 
+    window->context.osmesa.Finish = (PFN_glFinish)
+        OSMesaGetProcAddress("glFinish");
+    if (!window->context.osmesa.Finish)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "OSMesa: Failed to load glFinish");
+        return GLFW_FALSE;
+    }
+
+    window->context.osmesa.bufferCount = 1;
+
     window->context.makeCurrent = makeContextCurrentOSMesa;
     window->context.swapBuffers = swapBuffersOSMesa;
     window->context.swapInterval = swapIntervalOSMesa;
-    window->context.extensionSupported = extensionSupportedOSMesa;
+    window->context.getExtensions = getExtensionsOSMesa;
     window->context.getProcAddress = getProcAddressOSMesa;
+    window->context.procCache = &_glfw.osmesa.procs;
     window->context.destroy = destroyContextOSMesa;
 
+    // OSMesa cannot make a context current without a color buffer, so a
+    // windowless context is given a single pixel to render into
+    if (window->windowless)
+    {
+        window->context.osmesa.width = 1;
+        window->context.osmesa.height = 1;
+    }
+    else
+        window->context.resized = GLFW_TRUE;
+
     return GLFW_TRUE;
 }
 
@@ -323,6 +443,129 @@ GLFWAPI int glfwGetOSMesaColorBuffer(GLFWwindow* handle, int* width,
     return GLFW_TRUE;
 }
 
+GLFWAPI int glfwSetOSMesaColorBuffer(GLFWwindow* handle, void* buffer,
+                                     int width, int height,
+                                     int pitch, int format)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (window->context.client == GLFW_NO_API ||
+        window->context.makeCurrent != makeContextCurrentOSMesa)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                        "OSMesa: Window has no OSMesa context");
+        return GLFW_FALSE;
+    }
+
+    if (buffer)
+    {
+        if (width <= 0 || height <= 0)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "OSMesa: Invalid color buffer size %ix%i",
+                            width, height);
+            return GLFW_FALSE;
+        }
+
+        if (pitch == 0)
+            pitch = width * 4;
+
+        if (pitch < width * 4 || pitch % 4)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "OSMesa: Invalid color buffer pitch %i", pitch);
+            return GLFW_FALSE;
+        }
+
+        if (pitch != width * 4 && !OSMesaPixelStore)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "OSMesa: Color buffer pitch requires OSMesaPixelStore");
+            return GLFW_FALSE;
+        }
+
+        // GLFW always creates OSMesa contexts with the RGBA format
+        if (format != OSMESA_RGBA)
+        {
+            _glfwInputError(GLFW_INVALID_ENUM,
+                            "OSMesa: Invalid color buffer format 0x%08X",
+                            format);
+            return GLFW_FALSE;
+        }
+    }
+
+    window->context.osmesa.userBuffer = buffer;
+    window->context.osmesa.userWidth = width;
+    window->context.osmesa.userHeight = height;
+    window->context.osmesa.userRowLength = pitch / 4;
+
+    // Switching back to the allocated buffer needs the current size
+    if (!buffer)
+        window->context.resized = GLFW_TRUE;
+
+    if (_glfwPlatformGetTls(&_glfw.contextSlot) == window)
+        makeContextCurrentOSMesa(window);
+
+    return GLFW_TRUE;
+}
+
+GLFWAPI int glfwSetOSMesaBufferCount(GLFWwindow* handle, int count)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (window->context.client == GLFW_NO_API ||
+        window->context.makeCurrent != makeContextCurrentOSMesa)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                        "OSMesa: Window has no OSMesa context");
+        return GLFW_FALSE;
+    }
+
+    if (count < 1 || count > _GLFW_OSMESA_MAX_BUFFERS)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "OSMesa: Invalid buffer count %i", count);
+        return GLFW_FALSE;
+    }
+
+    // Buffers left outside the ring may still be held by the frame callback,
+    // so they are kept until the context is destroyed
+    window->context.osmesa.bufferCount = count;
+    if (window->context.osmesa.current >= count)
+        window->context.osmesa.current = 0;
+
+    if (_glfwPlatformGetTls(&_glfw.contextSlot) == window)
+        makeContextCurrentOSMesa(window);
+
+    return GLFW_TRUE;
+}
+
+GLFWAPI GLFWosmesaframefun glfwSetOSMesaFrameCallback(GLFWwindow* handle,
+                                                      GLFWosmesaframefun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (window->context.client == GLFW_NO_API ||
+        window->context.makeCurrent != makeContextCurrentOSMesa)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                        "OSMesa: Window has no OSMesa context");
+        return NULL;
+    }
+
+    _GLFW_SWAP_POINTERS(window->context.osmesa.frame, cbfun);
+    return cbfun;
+}
+
 GLFWAPI int glfwGetOSMesaDepthBuffer(GLFWwindow* handle,
                                      int* width, int* height,
                                      int* bytesPerValue,
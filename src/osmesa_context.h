@@ -35,6 +35,9 @@
 #define OSMESA_COMPAT_PROFILE 0x35
 #define OSMESA_CONTEXT_MAJOR_VERSION 0x36
 #define OSMESA_CONTEXT_MINOR_VERSION 0x37
+#define OSMESA_ROW_LENGTH 0x10
+
+#define _GLFW_OSMESA_MAX_BUFFERS 4
 
 typedef void* OSMesaContext;
 typedef void (*OSMESAproc)(void);
@@ -46,6 +49,15 @@ typedef int (GLAPIENTRY * PFN_OSMesaMakeCurrent)(OSMesaContext,void*,int,int,int
 typedef int (GLAPIENTRY * PFN_OSMesaGetColorBuffer)(OSMesaContext,int*,int*,int*,void**);
 typedef int (GLAPIENTRY * PFN_OSMesaGetDepthBuffer)(OSMesaContext,int*,int*,int*,void**);
 typedef GLFWglproc (GLAPIENTRY * PFN_OSMesaGetProcAddress)(const char*);
+typedef void (GLAPIENTRY * PFN_OSMesaPixelStore)(GLint,GLint);
+typedef void (APIENTRY * PFN_glFinish)(void);
+
+// The public frame callback type is declared by the native header, which is
+// included without the system OSMesa header it would otherwise pull in
+#define GLFW_EXPOSE_NATIVE_OSMESA
+#define GLFW_NATIVE_INCLUDE_NONE
+#include "../include/GLFW/glfw3native.h"
+
 #define OSMesaCreateContextExt _glfw.osmesa.CreateContextExt
 #define OSMesaCreateContextAttribs _glfw.osmesa.CreateContextAttribs
 #define OSMesaDestroyContext _glfw.osmesa.DestroyContext
@@ -53,6 +65,7 @@ typedef GLFWglproc (GLAPIENTRY * PFN_OSMesaGetProcAddress)(const char*);
 #define OSMesaGetColorBuffer _glfw.osmesa.GetColorBuffer
 #define OSMesaGetDepthBuffer _glfw.osmesa.GetDepthBuffer
 #define OSMesaGetProcAddress _glfw.osmesa.GetProcAddress
+#define OSMesaPixelStore _glfw.osmesa.PixelStore
 
 #define _GLFW_OSMESA_CONTEXT_STATE              _GLFWcontextOSMesa osmesa
 #define _GLFW_OSMESA_LIBRARY_CONTEXT_STATE      _GLFWlibraryOSMesa osmesa
@@ -65,7 +78,21 @@ typedef struct _GLFWcontextOSMesa
     OSMesaContext       handle;
     int                 width;
     int                 height;
-    void*               buffer;
+    // The ring of GLFW allocated buffers, rotated on swap, with the one
+    // currently rendered into at the current index
+    void*               buffers[_GLFW_OSMESA_MAX_BUFFERS];
+    int                 bufferCount;
+    int                 current;
+    // The size of each allocated buffer, which is only ever grown
+    size_t              sizes[_GLFW_OSMESA_MAX_BUFFERS];
+    // The buffer supplied by the application, if any, with its row length in
+    // pixels, used instead of the allocated buffer
+    void*               userBuffer;
+    int                 userWidth;
+    int                 userHeight;
+    int                 userRowLength;
+    GLFWosmesaframefun  frame;
+    PFN_glFinish        Finish;
 
 } _GLFWcontextOSMesa;
 
@@ -82,6 +109,9 @@ typedef struct _GLFWlibraryOSMesa
     PFN_OSMesaGetColorBuffer        GetColorBuffer;
     PFN_OSMesaGetDepthBuffer        GetDepthBuffer;
     PFN_OSMesaGetProcAddress        GetProcAddress;
+    PFN_OSMesaPixelStore            PixelStore;
+
+    _GLFWproccache  procs;
 
 } _GLFWlibraryOSMesa;
 
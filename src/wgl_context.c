@@ -365,15 +365,19 @@ static void swapIntervalWGL(int interval)
         wglSwapIntervalEXT(interval);
 }
 
-static int extensionSupportedWGL(const char* extension)
+static const char* getExtensionsWGL(void)
 {
-    const char* extensions = NULL;
-
     if (_glfw.wgl.GetExtensionsStringARB)
-        extensions = wglGetExtensionsStringARB(wglGetCurrentDC());
+        return wglGetExtensionsStringARB(wglGetCurrentDC());
     else if (_glfw.wgl.GetExtensionsStringEXT)
-        extensions = wglGetExtensionsStringEXT();
+        return wglGetExtensionsStringEXT();
+
+    return NULL;
+}
 
+static int extensionSupportedWGL(const char* extension)
+{
+    const char* extensions = getExtensionsWGL();
     if (!extensions)
         return GLFW_FALSE;
 
@@ -766,8 +770,11 @@ GLFWbool _glfwCreateContextWGL(_GLFWwindow* window,
     window->context.makeCurrent = makeContextCurrentWGL;
     window->context.swapBuffers = swapBuffersWGL;
     window->context.swapInterval = swapIntervalWGL;
-    window->context.extensionSupported = extensionSupportedWGL;
+    window->context.getExtensions = getExtensionsWGL;
     window->context.getProcAddress = getProcAddressWGL;
+    // NOTE: Entry points returned by wglGetProcAddress may differ between pixel
+    //       formats and drivers, so they are not cached per library
+    window->context.procCache = NULL;
     window->context.destroy = destroyContextWGL;
 
     return GLFW_TRUE;
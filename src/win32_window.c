@@ -1529,27 +1529,8 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
 
     if (ctxconfig->client != GLFW_NO_API)
     {
-        if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API)
-        {
-            if (!_glfwInitWGL())
-                return GLFW_FALSE;
-            if (!_glfwCreateContextWGL(window, ctxconfig, fbconfig))
-                return GLFW_FALSE;
-        }
-        else if (ctxconfig->source == GLFW_EGL_CONTEXT_API)
-        {
-            if (!_glfwInitEGL())
-                return GLFW_FALSE;
-            if (!_glfwCreateContextEGL(window, ctxconfig, fbconfig))
-                return GLFW_FALSE;
-        }
-        else if (ctxconfig->source == GLFW_OSMESA_CONTEXT_API)
-        {
-            if (!_glfwInitOSMesa())
-                return GLFW_FALSE;
-            if (!_glfwCreateContextOSMesa(window, ctxconfig, fbconfig))
-                return GLFW_FALSE;
-        }
+        if (!_glfwPlatformCreateContext(window, ctxconfig, fbconfig))
+            return GLFW_FALSE;
     }
 
     if (window->monitor)
@@ -1563,6 +1544,59 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
     return GLFW_TRUE;
 }
 
+int _glfwPlatformCreateContext(_GLFWwindow* window,
+                               const _GLFWctxconfig* ctxconfig,
+                               const _GLFWfbconfig* fbconfig)
+{
+    if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API)
+    {
+        if (!_glfwInitWGL())
+            return GLFW_FALSE;
+
+        // WGL contexts can only be made current on the device context of a
+        // window, so a windowless context is given a hidden one of its own
+        // and from then on is treated as a regular window, including when it
+        // is swapped and destroyed, as documented for glfwCreateSharedContext
+        if (window->windowless)
+        {
+            _GLFWwndconfig wndconfig;
+            memset(&wndconfig, 0, sizeof(wndconfig));
+            wndconfig.width  = 1;
+            wndconfig.height = 1;
+            wndconfig.title  = "GLFW";
+
+            window->windowless = GLFW_FALSE;
+            if (!createNativeWindow(window, &wndconfig, fbconfig))
+                return GLFW_FALSE;
+        }
+
+        if (!_glfwCreateContextWGL(window, ctxconfig, fbconfig))
+            return GLFW_FALSE;
+    }
+    else if (ctxconfig->source == GLFW_EGL_CONTEXT_API)
+    {
+        if (!_glfwInitEGL())
+            return GLFW_FALSE;
+        if (!_glfwCreateContextEGL(window, ctxconfig, fbconfig))
+            return GLFW_FALSE;
+    }
+    else if (ctxconfig->source == GLFW_OSMESA_CONTEXT_API)
+    {
+        if (!_glfwInitOSMesa())
+            return GLFW_FALSE;
+        if (!_glfwCreateContextOSMesa(window, ctxconfig, fbconfig))
+            return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
+void _glfwPlatformDestroyContext(_GLFWwindow* window)
+{
+    if (window->context.destroy)
+        window->context.destroy(window);
+}
+
 void _glfwPlatformDestroyWindow(_GLFWwindow* window)
 {
     if (window->monitor)
@@ -2069,12 +2103,7 @@ void _glfwPlatformWaitEventsTimeout(double timeout)
         if (waiters[r - WAIT_OBJECT_0] != _glfw.win32.iocpEvent) {
             // The iocp thread died. Fail and exit the application.
             OutputDebugStringA("iocpThread has exited, exiting app.\n");
-            _GLFWwindow* window = _glfw.windowListHead;
-            while (window)
-            {
-                _glfwInputWindowCloseRequest(window);
-                window = window->next;
-            }
+            _glfwInputWindowCloseRequestAll();
         }
     } else if (r == WAIT_FAILED) {
         char msg[256];
@@ -2104,12 +2133,7 @@ void _glfwPlatformWaitEventsTimeout(double timeout)
             //       may post it to this one, for example Task Manager
             // HACK: Treat WM_QUIT as a close on all windows
 
-            window = _glfw.windowListHead;
-            while (window)
-            {
-                _glfwInputWindowCloseRequest(window);
-                window = window->next;
-            }
+            _glfwInputWindowCloseRequestAll();
         }
         else
         {
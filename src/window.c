@@ -34,6 +34,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <float.h>
+#include <stdio.h>
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -44,6 +45,16 @@
 //
 void _glfwInputWindowFocus(_GLFWwindow* window, GLFWbool focused)
 {
+    if (_glfw.inputLog.active)
+    {
+        const int data[] = { focused };
+        if (!_glfwRecordInput(_GLFW_RECORD_WINDOW_FOCUS, window->serial,
+                              data))
+        {
+            return;
+        }
+    }
+
     if (window->callbacks.focus)
         window->callbacks.focus((GLFWwindow*) window, focused);
 
@@ -51,6 +62,9 @@ void _glfwInputWindowFocus(_GLFWwindow* window, GLFWbool focused)
     {
         int key, button;
 
+        // The releases below are implied by the focus event when replaying
+        _glfw.inputLog.suspended++;
+
         for (key = 0;  key <= GLFW_KEY_LAST;  key++)
         {
             if (window->keys[key] == GLFW_PRESS)
@@ -65,6 +79,8 @@ void _glfwInputWindowFocus(_GLFWwindow* window, GLFWbool focused)
             if (window->mouseButtons[button] == GLFW_PRESS)
                 _glfwInputMouseClick(window, button, GLFW_RELEASE, 0);
         }
+
+        _glfw.inputLog.suspended--;
     }
 }
 
@@ -82,6 +98,16 @@ void _glfwInputWindowPos(_GLFWwindow* window, int x, int y)
 //
 void _glfwInputWindowSize(_GLFWwindow* window, int width, int height)
 {
+    if (_glfw.inputLog.active)
+    {
+        const int data[] = { width, height };
+        if (!_glfwRecordInput(_GLFW_RECORD_WINDOW_SIZE, window->serial,
+                              data))
+        {
+            return;
+        }
+    }
+
     if (window->callbacks.size)
         window->callbacks.size((GLFWwindow*) window, width, height);
 }
@@ -107,6 +133,18 @@ void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized)
 //
 void _glfwInputFramebufferSize(_GLFWwindow* window, int width, int height)
 {
+    window->context.resized = GLFW_TRUE;
+
+    if (_glfw.inputLog.active)
+    {
+        const int data[] = { width, height };
+        if (!_glfwRecordInput(_GLFW_RECORD_FRAMEBUFFER_SIZE, window->serial,
+                              data))
+        {
+            return;
+        }
+    }
+
     if (window->callbacks.fbsize)
         window->callbacks.fbsize((GLFWwindow*) window, width, height);
 }
@@ -132,12 +170,60 @@ void _glfwInputWindowDamage(_GLFWwindow* window)
 //
 void _glfwInputWindowCloseRequest(_GLFWwindow* window)
 {
+    if (_glfw.inputLog.active)
+    {
+        if (!_glfwRecordInput(_GLFW_RECORD_WINDOW_CLOSE, window->serial,
+                              NULL))
+        {
+            return;
+        }
+    }
+
     window->shouldClose = GLFW_TRUE;
 
     if (window->callbacks.close)
         window->callbacks.close((GLFWwindow*) window);
 }
 
+// Notifies shared code that the user wishes to close all windows
+// The window list is only locked while searching it, as the close callback may
+// create windows, which are not notified
+//
+void _glfwInputWindowCloseRequestAll(void)
+{
+    _GLFWwindow* window;
+    int serial;
+
+    _glfwPlatformLockMutex(&_glfw.windowLock);
+    serial = _glfw.windowSerial + 1;
+    _glfwPlatformUnlockMutex(&_glfw.windowLock);
+
+    for (;;)
+    {
+        _GLFWwindow* next = NULL;
+
+        // Find the newest window that has not been notified yet
+        _glfwPlatformLockMutex(&_glfw.windowLock);
+
+        for (window = _glfw.windowListHead;  window;  window = window->next)
+        {
+            if (window->serial < serial &&
+                (!next || window->serial > next->serial))
+            {
+                next = window;
+            }
+        }
+
+        _glfwPlatformUnlockMutex(&_glfw.windowLock);
+
+        if (!next)
+            break;
+
+        serial = next->serial;
+        _glfwInputWindowCloseRequest(next);
+    }
+}
+
 // Notifies shared code that a window has changed its desired monitor
 //
 void _glfwInputWindowMonitor(_GLFWwindow* window, _GLFWmonitor* monitor)
@@ -145,6 +231,224 @@ void _glfwInputWindowMonitor(_GLFWwindow* window, _GLFWmonitor* monitor)
     window->monitor = monitor;
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Fills in the frame time statistics of the window
+//
+static void summarizeFrameTimes(_GLFWwindow* window, GLFWframestats* stats)
+{
+    _glfwHistogramSummary(&window->frametime.histogram,
+                          &stats->count, &stats->mean,
+                          &stats->p50, &stats->p95, &stats->p99, &stats->max);
+    stats->stutters = window->frametime.stutters;
+}
+
+// Adds the interval since the previous frame to the frame time histogram
+//
+static void recordFrameTime(_GLFWwindow* window, uint64_t now)
+{
+    uint32_t sample;
+    uint64_t frequency;
+
+    if (!window->frametime.last)
+    {
+        window->frametime.last = now;
+        return;
+    }
+
+    frequency = _glfwPlatformGetTimerFrequency();
+    {
+        const uint64_t delta = (now - window->frametime.last) * 1000000 / frequency;
+        sample = delta > 0xffffffffu ? 0xffffffffu : (uint32_t) delta;
+    }
+
+    window->frametime.last = now;
+    _glfwHistogramAdd(&window->frametime.histogram, sample);
+
+    // A stutter is a frame taking more than twice the moving average of the
+    // frames before it, which follows changes of the refresh rate or load
+    if (window->frametime.average)
+    {
+        if (sample / 2 > window->frametime.average)
+            window->frametime.stutters++;
+
+        window->frametime.average = (uint32_t)
+            (((uint64_t) window->frametime.average * 15 + sample) / 16);
+    }
+    else
+        window->frametime.average = sample;
+
+    // The summary is refreshed a few times per second for the title hook, so
+    // the cost of computing the percentiles does not depend on the frame rate
+    if (now - window->frametime.published >= frequency / 2)
+    {
+        GLFWframestats summary;
+        summarizeFrameTimes(window, &summary);
+
+        // An odd sequence number tells readers an update is in progress
+        window->frametime.sequence++;
+        _GLFW_MEMORY_BARRIER();
+        window->frametime.summary = summary;
+        _GLFW_MEMORY_BARRIER();
+        window->frametime.sequence++;
+
+        window->frametime.published = now;
+    }
+}
+
+// Completes the latency sample of any input consumed since the last frame and
+// the frame time sample of the window
+//
+void _glfwProbeFrameSubmitted(_GLFWwindow* window)
+{
+    uint64_t now, pending;
+
+    if (!window->latency.pending && !window->frametime.enabled)
+        return;
+
+    now = _glfwPlatformGetTimerValue();
+
+    // Input arriving after this belongs to the next frame
+    pending = _GLFW_ATOMIC_EXCHANGE64(&window->latency.pending, 0);
+    if (pending)
+    {
+        const uint64_t delta = now > pending ? now - pending : 0;
+
+        // An odd sequence number tells readers an update is in progress
+        window->latency.sequence++;
+        _GLFW_MEMORY_BARRIER();
+        _glfwHistogramAdd(&window->latency.histogram,
+                          delta * 1000000 / _glfwPlatformGetTimerFrequency());
+        _GLFW_MEMORY_BARRIER();
+        window->latency.sequence++;
+    }
+
+    if (window->frametime.enabled)
+        recordFrameTime(window, now);
+}
+
+// Shows the latest frame time summary in the titles of the windows that have
+// a title hook
+//
+void _glfwUpdateFrameTimeTitles(void)
+{
+    _GLFWwindow* window;
+
+    _glfwPlatformLockMutex(&_glfw.windowLock);
+
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        GLFWframestats summary;
+        uint32_t sequence;
+        char title[sizeof(window->frametime.title) + 128];
+
+        if (!window->frametime.titled)
+            continue;
+
+        do
+        {
+            sequence = window->frametime.sequence;
+            _GLFW_MEMORY_BARRIER();
+            summary = window->frametime.summary;
+            _GLFW_MEMORY_BARRIER();
+        } while ((sequence & 1) || sequence != window->frametime.sequence);
+
+        if (!sequence || sequence == window->frametime.shown)
+            continue;
+
+        window->frametime.shown = sequence;
+
+        snprintf(title, sizeof(title),
+                 "%s%s(%.1f ms p50, %.1f ms p95, %.1f ms p99, %.1f ms max, %u stutters)",
+                 window->frametime.title, window->frametime.title[0] ? " " : "",
+                 summary.p50 * 1e3, summary.p95 * 1e3, summary.p99 * 1e3,
+                 summary.max * 1e3, summary.stutters);
+        _glfwPlatformSetWindowTitle(window, title);
+    }
+
+    _glfwPlatformUnlockMutex(&_glfw.windowLock);
+}
+
+// Records the timing of a buffer swap that started at the specified timer value
+//
+void _glfwRecordSwap(_GLFWwindow* window, uint64_t start)
+{
+    const uint64_t frame = ++window->timing.frame;
+    _GLFWswaptiming* timing = window->timing.swaps + frame % _GLFW_FRAME_TIMINGS;
+
+    timing->frame = frame;
+    timing->start = start;
+    timing->end = _glfwPlatformGetTimerValue();
+    timing->present = 0;
+    timing->ust = 0;
+    timing->msc = 0;
+    timing->presented = GLFW_FALSE;
+
+    if (window->context.getPresentation)
+        timing->swap = window->context.swaps;
+    else
+        timing->swap = 0;
+}
+
+// Converts a timer value to the time base of glfwGetTime, allowing values from
+// before the last call to glfwSetTime
+//
+static double timerToTime(uint64_t value)
+{
+    return (double) (int64_t) (value - _glfw.timer.offset) /
+        _glfwPlatformGetTimerFrequency();
+}
+
+// Applies the latest presentation feedback of the context to the swaps still
+// waiting for it
+//
+static void updatePresentation(_GLFWwindow* window)
+{
+    int i;
+    uint64_t swap, time;
+    int64_t ust, msc;
+
+    if (!window->context.getPresentation)
+        return;
+
+    if (!window->context.getPresentation(window, &swap, &time, &ust, &msc))
+        return;
+
+    for (i = 0;  i < _GLFW_FRAME_TIMINGS;  i++)
+    {
+        _GLFWswaptiming* timing = window->timing.swaps + i;
+        if (!timing->swap || timing->swap > swap)
+            continue;
+
+        // Feedback is only reported for the latest presented swap, so earlier
+        // swaps that were not seen waiting have no presentation time
+        if (timing->swap == swap)
+        {
+            timing->present = time;
+            timing->ust = ust;
+            timing->msc = msc;
+            timing->presented = GLFW_TRUE;
+        }
+
+        timing->swap = 0;
+    }
+}
+
+// Adds a fully created window to the global linked list, making it visible to
+// other threads walking the list
+//
+static void linkWindow(_GLFWwindow* window)
+{
+    _glfwPlatformLockMutex(&_glfw.windowLock);
+    window->next = _glfw.windowListHead;
+    _glfw.windowListHead = window;
+    _glfwPlatformUnlockMutex(&_glfw.windowLock);
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                        GLFW public API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -187,8 +491,10 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
         return NULL;
 
     window = calloc(1, sizeof(_GLFWwindow));
-    window->next = _glfw.windowListHead;
-    _glfw.windowListHead = window;
+
+    _glfwPlatformLockMutex(&_glfw.windowLock);
+    window->serial = ++_glfw.windowSerial;
+    _glfwPlatformUnlockMutex(&_glfw.windowLock);
 
     window->videoMode.width       = width;
     window->videoMode.height      = height;
@@ -228,6 +534,8 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
         }
     }
 
+    linkWindow(window);
+
     if (window->monitor)
     {
         if (wndconfig.centerCursor)
@@ -246,6 +554,78 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
     return (GLFWwindow*) window;
 }
 
+GLFWAPI GLFWwindow* glfwCreateSharedContext(GLFWwindow* share)
+{
+    _GLFWfbconfig fbconfig;
+    _GLFWctxconfig ctxconfig;
+    _GLFWwindow* window;
+    _GLFWwindow* source = (_GLFWwindow*) share;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    fbconfig  = _glfw.hints.framebuffer;
+    ctxconfig = _glfw.hints.context;
+
+    // A shared context is only useful if it can run the same code as the
+    // context it shares with, so it inherits its client API and version
+    if (source)
+    {
+        if (source->context.client == GLFW_NO_API)
+        {
+            _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                            "Cannot share with a window that has no context");
+            return NULL;
+        }
+
+        ctxconfig.client     = source->context.client;
+        ctxconfig.source     = source->context.source;
+        ctxconfig.major      = source->context.major;
+        ctxconfig.minor      = source->context.minor;
+        ctxconfig.forward    = source->context.forward;
+        ctxconfig.debug      = source->context.debug;
+        ctxconfig.noerror    = source->context.noerror;
+        ctxconfig.profile    = source->context.profile;
+        ctxconfig.robustness = source->context.robustness;
+        ctxconfig.release    = source->context.release;
+    }
+
+    ctxconfig.share = source;
+
+    if (ctxconfig.client == GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Cannot create a shared context without a client API");
+        return NULL;
+    }
+
+    if (!_glfwIsValidContextConfig(&ctxconfig))
+        return NULL;
+
+    window = calloc(1, sizeof(_GLFWwindow));
+
+    _glfwPlatformLockMutex(&_glfw.windowLock);
+    window->serial = ++_glfw.windowSerial;
+    _glfwPlatformUnlockMutex(&_glfw.windowLock);
+
+    window->windowless = GLFW_TRUE;
+    window->cursorMode = GLFW_CURSOR_NORMAL;
+
+    if (!_glfwPlatformCreateContext(window, &ctxconfig, &fbconfig))
+    {
+        glfwDestroyWindow((GLFWwindow*) window);
+        return NULL;
+    }
+
+    if (!_glfwRefreshContextAttribs(window, &ctxconfig))
+    {
+        glfwDestroyWindow((GLFWwindow*) window);
+        return NULL;
+    }
+
+    linkWindow(window);
+    return (GLFWwindow*) window;
+}
+
 void glfwDefaultWindowHints(void)
 {
     _GLFW_REQUIRE_INIT();
@@ -459,16 +839,29 @@ GLFWAPI void glfwDestroyWindow(GLFWwindow* handle)
     if (window == _glfwPlatformGetTls(&_glfw.contextSlot))
         glfwMakeContextCurrent(NULL);
 
-    _glfwPlatformDestroyWindow(window);
+    if (window->windowless)
+        _glfwPlatformDestroyContext(window);
+    else
+        _glfwPlatformDestroyWindow(window);
+
+    free(window->context.extensions);
+    free(window->context.extensionNames);
 
-    // Unlink window from global linked list
+    // Unlink window from global linked list, unless its creation failed before
+    // it was linked
     {
-        _GLFWwindow** prev = &_glfw.windowListHead;
+        _GLFWwindow** prev;
 
-        while (*prev != window)
+        _glfwPlatformLockMutex(&_glfw.windowLock);
+
+        prev = &_glfw.windowListHead;
+        while (*prev && *prev != window)
             prev = &((*prev)->next);
 
-        *prev = window->next;
+        if (*prev)
+            *prev = window->next;
+
+        _glfwPlatformUnlockMutex(&_glfw.windowLock);
     }
 
     free(window);
@@ -568,6 +961,10 @@ GLFWAPI void glfwSetWindowSize(GLFWwindow* handle, int width, int height)
     window->videoMode.height = height;
 
     _glfwPlatformSetWindowSize(window, width, height);
+
+    // Some platforms only report the new framebuffer size with a later event,
+    // so context APIs tracking it are told to query it right away
+    window->context.resized = GLFW_TRUE;
 }
 
 GLFWAPI void glfwSetWindowSizeLimits(GLFWwindow* handle,
@@ -613,6 +1010,7 @@ GLFWAPI void glfwSetWindowSizeLimits(GLFWwindow* handle,
     _glfwPlatformSetWindowSizeLimits(window,
                                      minwidth, minheight,
                                      maxwidth, maxheight);
+    window->context.resized = GLFW_TRUE;
 }
 
 GLFWAPI void glfwSetWindowAspectRatio(GLFWwindow* handle, int numer, int denom)
@@ -642,6 +1040,7 @@ GLFWAPI void glfwSetWindowAspectRatio(GLFWwindow* handle, int numer, int denom)
         return;
 
     _glfwPlatformSetWindowAspectRatio(window, numer, denom);
+    window->context.resized = GLFW_TRUE;
 }
 
 GLFWAPI void glfwGetFramebufferSize(GLFWwindow* handle, int* width, int* height)
@@ -728,6 +1127,7 @@ GLFWAPI void glfwIconifyWindow(GLFWwindow* handle)
 
     _GLFW_REQUIRE_INIT();
     _glfwPlatformIconifyWindow(window);
+    window->context.resized = GLFW_TRUE;
 }
 
 GLFWAPI void glfwRestoreWindow(GLFWwindow* handle)
@@ -737,6 +1137,7 @@ GLFWAPI void glfwRestoreWindow(GLFWwindow* handle)
 
     _GLFW_REQUIRE_INIT();
     _glfwPlatformRestoreWindow(window);
+    window->context.resized = GLFW_TRUE;
 }
 
 GLFWAPI void glfwMaximizeWindow(GLFWwindow* handle)
@@ -750,6 +1151,7 @@ GLFWAPI void glfwMaximizeWindow(GLFWwindow* handle)
         return;
 
     _glfwPlatformMaximizeWindow(window);
+    window->context.resized = GLFW_TRUE;
 }
 
 GLFWAPI void glfwShowWindow(GLFWwindow* handle)
@@ -950,6 +1352,7 @@ GLFWAPI void glfwSetWindowMonitor(GLFWwindow* wh,
     _glfwPlatformSetWindowMonitor(window, monitor,
                                   xpos, ypos, width, height,
                                   refreshRate);
+    window->context.resized = GLFW_TRUE;
 }
 
 GLFWAPI void glfwSetWindowUserPointer(GLFWwindow* handle, void* pointer)
@@ -1073,12 +1476,24 @@ GLFWAPI void glfwPollEvents(void)
 {
     _GLFW_REQUIRE_INIT();
     _glfwPlatformPollEvents();
+    _glfwUpdateInputLog();
+    _glfwPublishInputSnapshots();
+    _glfwUpdateFrameTimeTitles();
 }
 
 GLFWAPI void glfwWaitEvents(void)
 {
     _GLFW_REQUIRE_INIT();
-    _glfwPlatformWaitEvents();
+
+    // A replayed log supplies the events, so there is nothing to wait for
+    if (_glfw.inputLog.data)
+        _glfwPlatformPollEvents();
+    else
+        _glfwPlatformWaitEvents();
+
+    _glfwUpdateInputLog();
+    _glfwPublishInputSnapshots();
+    _glfwUpdateFrameTimeTitles();
 }
 
 GLFWAPI void glfwWaitEventsTimeout(double timeout)
@@ -1094,7 +1509,14 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout)
         return;
     }
 
-    _glfwPlatformWaitEventsTimeout(timeout);
+    if (_glfw.inputLog.data)
+        _glfwPlatformPollEvents();
+    else
+        _glfwPlatformWaitEventsTimeout(timeout);
+
+    _glfwUpdateInputLog();
+    _glfwPublishInputSnapshots();
+    _glfwUpdateFrameTimeTitles();
 }
 
 GLFWAPI void glfwPostEmptyEvent(void)
@@ -1102,3 +1524,191 @@ GLFWAPI void glfwPostEmptyEvent(void)
     _GLFW_REQUIRE_INIT();
     _glfwPlatformPostEmptyEvent();
 }
+
+GLFWAPI void glfwSetInputLatencyProbe(GLFWwindow* handle, int enabled)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    window->latency.enabled = enabled ? GLFW_TRUE : GLFW_FALSE;
+    _GLFW_ATOMIC_EXCHANGE64(&window->latency.pending, 0);
+}
+
+GLFWAPI void glfwMarkFrameSubmitted(GLFWwindow* handle)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+    _glfwProbeFrameSubmitted(window);
+}
+
+GLFWAPI int glfwGetInputLatency(GLFWwindow* handle, GLFWlatencystats* stats)
+{
+    _GLFWhistogram histogram;
+    uint32_t sequence;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(stats != NULL);
+
+    memset(stats, 0, sizeof(GLFWlatencystats));
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    // Swaps on other threads may be adding samples, so the histogram is copied
+    // until a consistent copy is made
+    do
+    {
+        sequence = window->latency.sequence;
+        _GLFW_MEMORY_BARRIER();
+        histogram = window->latency.histogram;
+        _GLFW_MEMORY_BARRIER();
+    } while ((sequence & 1) || sequence != window->latency.sequence);
+
+    if (!histogram.count)
+        return GLFW_FALSE;
+
+    _glfwHistogramSummary(&histogram, &stats->count, &stats->mean,
+                          &stats->p50, &stats->p95, &stats->p99, &stats->max);
+    return GLFW_TRUE;
+}
+
+GLFWAPI void glfwResetInputLatency(GLFWwindow* handle)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    window->latency.sequence++;
+    _GLFW_MEMORY_BARRIER();
+    memset(&window->latency.histogram, 0, sizeof(window->latency.histogram));
+    _GLFW_MEMORY_BARRIER();
+    window->latency.sequence++;
+
+    _GLFW_ATOMIC_EXCHANGE64(&window->latency.pending, 0);
+}
+
+GLFWAPI void glfwSetFrameTimeProbe(GLFWwindow* handle, int enabled)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    window->frametime.enabled = enabled ? GLFW_TRUE : GLFW_FALSE;
+    window->frametime.last = 0;
+}
+
+GLFWAPI int glfwGetFrameTimeStats(GLFWwindow* handle, GLFWframestats* stats)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(stats != NULL);
+
+    memset(stats, 0, sizeof(GLFWframestats));
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!window->frametime.histogram.count)
+        return GLFW_FALSE;
+
+    summarizeFrameTimes(window, stats);
+    return GLFW_TRUE;
+}
+
+GLFWAPI void glfwResetFrameTimeStats(GLFWwindow* handle)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    memset(&window->frametime.histogram, 0, sizeof(window->frametime.histogram));
+    window->frametime.last = 0;
+    window->frametime.average = 0;
+    window->frametime.stutters = 0;
+}
+
+GLFWAPI void glfwSetFrameTimeTitle(GLFWwindow* handle, const char* title)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (title)
+    {
+        size_t length = strlen(title);
+
+        // Long titles are cut before the code point that does not fit, so the
+        // title stays valid UTF-8
+        if (length > sizeof(window->frametime.title) - 1)
+        {
+            length = sizeof(window->frametime.title) - 1;
+            while (length && (title[length] & 0xc0) == 0x80)
+                length--;
+        }
+
+        memcpy(window->frametime.title, title, length);
+        window->frametime.title[length] = '\0';
+        window->frametime.titled = GLFW_TRUE;
+        _glfwPlatformSetWindowTitle(window, window->frametime.title);
+    }
+    else if (window->frametime.titled)
+    {
+        _glfwPlatformSetWindowTitle(window, window->frametime.title);
+        window->frametime.title[0] = '\0';
+        window->frametime.titled = GLFW_FALSE;
+    }
+
+    // Show the next summary even if it was already shown with another title
+    window->frametime.shown = 0;
+}
+
+GLFWAPI int glfwGetFrameTimings(GLFWwindow* handle,
+                                GLFWframetiming* timings, int count)
+{
+    int i;
+    uint64_t first;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(timings != NULL || count == 0);
+    assert(count >= 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (count > _GLFW_FRAME_TIMINGS)
+        count = _GLFW_FRAME_TIMINGS;
+    if ((uint64_t) count > window->timing.frame)
+        count = (int) window->timing.frame;
+
+    updatePresentation(window);
+
+    first = window->timing.frame - count + 1;
+
+    for (i = 0;  i < count;  i++)
+    {
+        const _GLFWswaptiming* timing =
+            window->timing.swaps + (first + i) % _GLFW_FRAME_TIMINGS;
+        GLFWframetiming* result = timings + i;
+
+        result->frame = timing->frame;
+        result->swapStart = timerToTime(timing->start);
+        result->swapEnd = timerToTime(timing->end);
+        result->msc = timing->msc;
+        result->ust = timing->ust;
+        result->presented = timing->presented;
+        result->pending = timing->swap != 0;
+
+        // The end of the swap is the best estimate available on the CPU
+        if (timing->present)
+            result->present = timerToTime(timing->present);
+        else
+            result->present = result->swapEnd;
+    }
+
+    return count;
+}
@@ -53,9 +53,11 @@ static _GLFWwindow* findWindowFromDecorationSurface(struct wl_surface* surface,
                                                     int* which)
 {
     int focus;
-    _GLFWwindow* window = _glfw.windowListHead;
+    _GLFWwindow* window;
     if (!which)
         which = &focus;
+    _glfwPlatformLockMutex(&_glfw.windowLock);
+    window = _glfw.windowListHead;
     while (window)
     {
         if (surface == window->wl.decorations.top.surface)
@@ -80,6 +82,7 @@ static _GLFWwindow* findWindowFromDecorationSurface(struct wl_surface* surface,
         }
         window = window->next;
     }
+    _glfwPlatformUnlockMutex(&_glfw.windowLock);
     return window;
 }
 
@@ -505,7 +508,10 @@ static int toGLFWKeyCode(uint32_t key)
 }
 
 #ifdef HAVE_XKBCOMMON_COMPOSE_H
-static xkb_keysym_t composeSymbol(xkb_keysym_t sym)
+// Feeds the keysym to the compose state and, if that completes a sequence,
+// retrieves the full composed text into the specified buffer
+//
+static xkb_keysym_t composeSymbol(xkb_keysym_t sym, char* text, size_t size)
 {
     if (sym == XKB_KEY_NoSymbol || !_glfw.wl.xkb.composeState)
         return sym;
@@ -515,6 +521,8 @@ static xkb_keysym_t composeSymbol(xkb_keysym_t sym)
     switch (xkb_compose_state_get_status(_glfw.wl.xkb.composeState))
     {
         case XKB_COMPOSE_COMPOSED:
+            if (xkb_compose_state_get_utf8)
+                xkb_compose_state_get_utf8(_glfw.wl.xkb.composeState, text, size);
             return xkb_compose_state_get_one_sym(_glfw.wl.xkb.composeState);
         case XKB_COMPOSE_COMPOSING:
         case XKB_COMPOSE_CANCELLED:
@@ -532,23 +540,28 @@ static GLFWbool inputChar(_GLFWwindow* window, uint32_t key)
     long cp;
     const xkb_keysym_t *syms;
     xkb_keysym_t sym;
+    char text[64] = "";
 
     code = key + 8;
     numSyms = xkb_state_key_get_syms(_glfw.wl.xkb.state, code, &syms);
 
     if (numSyms == 1)
     {
+        const int mods = _glfw.wl.xkb.modifiers;
+        const int plain = !(mods & (GLFW_MOD_CONTROL | GLFW_MOD_ALT));
+
 #ifdef HAVE_XKBCOMMON_COMPOSE_H
-        sym = composeSymbol(syms[0]);
+        sym = composeSymbol(syms[0], text, sizeof(text));
 #else
         sym = syms[0];
 #endif
-        cp = _glfwKeySym2Unicode(sym);
-        if (cp != -1)
+        if (text[0])
+            _glfwInputText(window, text, mods, plain);
+        else
         {
-            const int mods = _glfw.wl.xkb.modifiers;
-            const int plain = !(mods & (GLFW_MOD_CONTROL | GLFW_MOD_ALT));
-            _glfwInputChar(window, cp, mods, plain);
+            cp = _glfwKeySym2Unicode(sym);
+            if (cp != -1)
+                _glfwInputChar(window, cp, mods, plain);
         }
     }
 
@@ -1117,6 +1130,8 @@ int _glfwPlatformInit(void)
         _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_compose_state_get_status");
     _glfw.wl.xkb.compose_state_get_one_sym = (PFN_xkb_compose_state_get_one_sym)
         _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_compose_state_get_one_sym");
+    _glfw.wl.xkb.compose_state_get_utf8 = (PFN_xkb_compose_state_get_utf8)
+        _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_compose_state_get_utf8");
 #endif
 
     _glfw.wl.display = wl_display_connect(NULL);
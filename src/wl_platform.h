@@ -137,6 +137,7 @@ typedef void (* PFN_xkb_compose_state_unref)(struct xkb_compose_state*);
 typedef enum xkb_compose_feed_result (* PFN_xkb_compose_state_feed)(struct xkb_compose_state*, xkb_keysym_t);
 typedef enum xkb_compose_status (* PFN_xkb_compose_state_get_status)(struct xkb_compose_state*);
 typedef xkb_keysym_t (* PFN_xkb_compose_state_get_one_sym)(struct xkb_compose_state*);
+typedef int (* PFN_xkb_compose_state_get_utf8)(struct xkb_compose_state*, char*, size_t);
 #define xkb_compose_table_new_from_locale _glfw.wl.xkb.compose_table_new_from_locale
 #define xkb_compose_table_unref _glfw.wl.xkb.compose_table_unref
 #define xkb_compose_state_new _glfw.wl.xkb.compose_state_new
@@ -144,6 +145,7 @@ typedef xkb_keysym_t (* PFN_xkb_compose_state_get_one_sym)(struct xkb_compose_st
 #define xkb_compose_state_feed _glfw.wl.xkb.compose_state_feed
 #define xkb_compose_state_get_status _glfw.wl.xkb.compose_state_get_status
 #define xkb_compose_state_get_one_sym _glfw.wl.xkb.compose_state_get_one_sym
+#define xkb_compose_state_get_utf8 _glfw.wl.xkb.compose_state_get_utf8
 #endif
 
 #define _GLFW_DECORATION_WIDTH 4
@@ -301,6 +303,7 @@ typedef struct _GLFWlibraryWayland
         PFN_xkb_compose_state_feed compose_state_feed;
         PFN_xkb_compose_state_get_status compose_state_get_status;
         PFN_xkb_compose_state_get_one_sym compose_state_get_one_sym;
+        PFN_xkb_compose_state_get_utf8 compose_state_get_utf8;
 #endif
     } xkb;
 
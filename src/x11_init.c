@@ -490,8 +490,10 @@ static void inputMethodInstantiateCallback(Display* display,
         callback.client_data = NULL;
         XSetIMValues(_glfw.x11.im, XNDestroyCallback, &callback, NULL);
 
+        _glfwPlatformLockMutex(&_glfw.windowLock);
         for (_GLFWwindow* window = _glfw.windowListHead;  window;  window = window->next)
             _glfwCreateInputContextX11(window);
+        _glfwPlatformUnlockMutex(&_glfw.windowLock);
     }
 }
 
@@ -451,6 +451,8 @@ typedef struct _GLFWlibraryX11
     int             epollfd;
     int             epoll_wait_enosys;
     int             epoll_pwait_enosys;
+    // Whether the last wait drained input from a joystick device
+    GLFWbool        joystickWakeup;
 #else
 #error BSD that is not apple - use kevent like cocoa_window does, not epoll_ctl
 #endif
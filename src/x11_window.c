@@ -195,6 +195,10 @@ static GLFWbool waitForEvent(double* timeout)
             if (alerts[i].data.fd == _glfw.linjs.inotify) {
                 continue;
             }
+            if (_glfwHandleJoystickFDLinux(alerts[i].data.fd)) {
+                _glfw.x11.joystickWakeup = GLFW_TRUE;
+                continue;
+            }
 #endif
             if (_glfw.callbacks.io) {
                 if (!_glfw.callbacks.io(alerts[i].data.fd,
@@ -545,62 +549,6 @@ static char** parseUriList(char* text, int* count)
     return paths;
 }
 
-// Encode a Unicode code point to a UTF-8 stream
-// Based on cutef8 by Jeff Bezanson (Public Domain)
-//
-static size_t encodeUTF8(char* s, unsigned int ch)
-{
-    size_t count = 0;
-
-    if (ch < 0x80)
-        s[count++] = (char) ch;
-    else if (ch < 0x800)
-    {
-        s[count++] = (ch >> 6) | 0xc0;
-        s[count++] = (ch & 0x3f) | 0x80;
-    }
-    else if (ch < 0x10000)
-    {
-        s[count++] = (ch >> 12) | 0xe0;
-        s[count++] = ((ch >> 6) & 0x3f) | 0x80;
-        s[count++] = (ch & 0x3f) | 0x80;
-    }
-    else if (ch < 0x110000)
-    {
-        s[count++] = (ch >> 18) | 0xf0;
-        s[count++] = ((ch >> 12) & 0x3f) | 0x80;
-        s[count++] = ((ch >> 6) & 0x3f) | 0x80;
-        s[count++] = (ch & 0x3f) | 0x80;
-    }
-
-    return count;
-}
-
-// Decode a Unicode code point from a UTF-8 stream
-// Based on cutef8 by Jeff Bezanson (Public Domain)
-//
-#if defined(X_HAVE_UTF8_STRING)
-static unsigned int decodeUTF8(const char** s)
-{
-    unsigned int ch = 0, count = 0;
-    static const unsigned int offsets[] =
-    {
-        0x00000000u, 0x00003080u, 0x000e2080u,
-        0x03c82080u, 0xfa082080u, 0x82082080u
-    };
-
-    do
-    {
-        ch = (ch << 6) + (unsigned char) **s;
-        (*s)++;
-        count++;
-    } while ((**s & 0xc0) == 0x80);
-
-    assert(count <= 6);
-    return ch - offsets[count - 1];
-}
-#endif /*X_HAVE_UTF8_STRING*/
-
 // Convert the specified Latin-1 string to UTF-8
 //
 static char* convertLatin1toUTF8(const char* source)
@@ -615,7 +563,7 @@ static char* convertLatin1toUTF8(const char* source)
     char* tp = target;
 
     for (sp = source;  *sp;  sp++)
-        tp += encodeUTF8(tp, *sp);
+        tp += _glfwEncodeUTF8(tp, *sp);
 
     return target;
 }
@@ -1417,10 +1365,8 @@ static void processEvent(XEvent *event)
 
                     if (status == XLookupChars || status == XLookupBoth)
                     {
-                        const char* c = chars;
                         chars[count] = '\0';
-                        while (c - chars < count)
-                            _glfwInputChar(window, decodeUTF8(&c), mods, plain);
+                        _glfwInputText(window, chars, mods, plain);
                     }
 #else /*X_HAVE_UTF8_STRING*/
                     wchar_t buffer[16];
@@ -1445,8 +1391,17 @@ static void processEvent(XEvent *event)
                     if (status == XLookupChars || status == XLookupBoth)
                     {
                         int i;
-                        for (i = 0;  i < count;  i++)
-                            _glfwInputChar(window, chars[i], mods, plain);
+                        size_t length = 0;
+                        char* text = calloc(count * 4 + 1, 1);
+                        if (text)
+                        {
+                            for (i = 0;  i < count;  i++)
+                                length += _glfwEncodeUTF8(text + length, chars[i]);
+                            _glfwInputText(window, text, mods, plain);
+                            free(text);
+                        }
+                        else
+                            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
                     }
 #endif /*X_HAVE_UTF8_STRING*/
 
@@ -2169,21 +2124,8 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
 
     if (ctxconfig->client != GLFW_NO_API)
     {
-        if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API)
-        {
-            if (!_glfwCreateContextGLX(window, ctxconfig, fbconfig))
-                return GLFW_FALSE;
-        }
-        else if (ctxconfig->source == GLFW_EGL_CONTEXT_API)
-        {
-            if (!_glfwCreateContextEGL(window, ctxconfig, fbconfig))
-                return GLFW_FALSE;
-        }
-        else if (ctxconfig->source == GLFW_OSMESA_CONTEXT_API)
-        {
-            if (!_glfwCreateContextOSMesa(window, ctxconfig, fbconfig))
-                return GLFW_FALSE;
-        }
+        if (!_glfwPlatformCreateContext(window, ctxconfig, fbconfig))
+            return GLFW_FALSE;
     }
 
     if (window->monitor)
@@ -2197,6 +2139,42 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
     return GLFW_TRUE;
 }
 
+int _glfwPlatformCreateContext(_GLFWwindow* window,
+                               const _GLFWctxconfig* ctxconfig,
+                               const _GLFWfbconfig* fbconfig)
+{
+    if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API)
+    {
+        if (!_glfwInitGLX())
+            return GLFW_FALSE;
+        if (!_glfwCreateContextGLX(window, ctxconfig, fbconfig))
+            return GLFW_FALSE;
+    }
+    else if (ctxconfig->source == GLFW_EGL_CONTEXT_API)
+    {
+        if (!_glfwInitEGL())
+            return GLFW_FALSE;
+        if (!_glfwCreateContextEGL(window, ctxconfig, fbconfig))
+            return GLFW_FALSE;
+    }
+    else if (ctxconfig->source == GLFW_OSMESA_CONTEXT_API)
+    {
+        if (!_glfwInitOSMesa())
+            return GLFW_FALSE;
+        if (!_glfwCreateContextOSMesa(window, ctxconfig, fbconfig))
+            return GLFW_FALSE;
+    }
+
+    XFlush(_glfw.x11.display);
+    return GLFW_TRUE;
+}
+
+void _glfwPlatformDestroyContext(_GLFWwindow* window)
+{
+    if (window->context.destroy)
+        window->context.destroy(window);
+}
+
 void _glfwPlatformDestroyWindow(_GLFWwindow* window)
 {
     if (_glfw.x11.disabledCursorWindow == window)
@@ -2928,6 +2906,8 @@ void _glfwPlatformWaitEventsTimeout(double timeout)
     _glfwDetectJoystickConnectionLinux();
 #endif
 
+    _glfw.x11.joystickWakeup = GLFW_FALSE;
+
     do
     {
         if (timeout < 0) {
@@ -2940,6 +2920,9 @@ void _glfwPlatformWaitEventsTimeout(double timeout)
                 break;
             timeout = 0;
         }
+        // Joystick input has already been delivered by waitForEvent
+        if (_glfw.x11.joystickWakeup)
+            break;
     } while (!XPending(_glfw.x11.display));
 
     while (QLength(_glfw.x11.display))
@@ -3043,7 +3026,7 @@ const char* _glfwPlatformGetScancodeName(int scancode)
     if (ch == -1)
         return NULL;
 
-    const size_t count = encodeUTF8(_glfw.x11.keynames[key], (unsigned int) ch);
+    const size_t count = _glfwEncodeUTF8(_glfw.x11.keynames[key], (unsigned int) ch);
     if (count == 0)
         return NULL;
 
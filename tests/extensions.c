@@ -0,0 +1,240 @@
+//========================================================================
+// Extension query benchmark
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test measures how long it takes to create a context and to probe it
+// for the kind of extension list a renderer checks at startup, with a mix of
+// client API and context creation API extensions, present and missing
+//
+//========================================================================
+
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static const char* extensions[] =
+{
+    "GL_ARB_base_instance",
+    "GL_ARB_bindless_texture",
+    "GL_ARB_buffer_storage",
+    "GL_ARB_clear_buffer_object",
+    "GL_ARB_clear_texture",
+    "GL_ARB_clip_control",
+    "GL_ARB_compatibility",
+    "GL_ARB_compute_shader",
+    "GL_ARB_copy_image",
+    "GL_ARB_debug_output",
+    "GL_ARB_direct_state_access",
+    "GL_ARB_draw_indirect",
+    "GL_ARB_enhanced_layouts",
+    "GL_ARB_explicit_uniform_location",
+    "GL_ARB_fragment_shader_interlock",
+    "GL_ARB_framebuffer_no_attachments",
+    "GL_ARB_framebuffer_sRGB",
+    "GL_ARB_get_program_binary",
+    "GL_ARB_gl_spirv",
+    "GL_ARB_gpu_shader5",
+    "GL_ARB_gpu_shader_int64",
+    "GL_ARB_indirect_parameters",
+    "GL_ARB_instanced_arrays",
+    "GL_ARB_internalformat_query2",
+    "GL_ARB_invalidate_subdata",
+    "GL_ARB_map_buffer_range",
+    "GL_ARB_multi_bind",
+    "GL_ARB_multi_draw_indirect",
+    "GL_ARB_parallel_shader_compile",
+    "GL_ARB_pipeline_statistics_query",
+    "GL_ARB_polygon_offset_clamp",
+    "GL_ARB_program_interface_query",
+    "GL_ARB_robustness",
+    "GL_ARB_sample_shading",
+    "GL_ARB_seamless_cube_map",
+    "GL_ARB_separate_shader_objects",
+    "GL_ARB_shader_atomic_counters",
+    "GL_ARB_shader_ballot",
+    "GL_ARB_shader_draw_parameters",
+    "GL_ARB_shader_image_load_store",
+    "GL_ARB_shader_storage_buffer_object",
+    "GL_ARB_shader_viewport_layer_array",
+    "GL_ARB_sparse_buffer",
+    "GL_ARB_sparse_texture",
+    "GL_ARB_spirv_extensions",
+    "GL_ARB_sync",
+    "GL_ARB_texture_barrier",
+    "GL_ARB_texture_buffer_range",
+    "GL_ARB_texture_compression_bptc",
+    "GL_ARB_texture_filter_anisotropic",
+    "GL_ARB_texture_storage",
+    "GL_ARB_texture_view",
+    "GL_ARB_timer_query",
+    "GL_ARB_uniform_buffer_object",
+    "GL_ARB_vertex_attrib_binding",
+    "GL_ARB_viewport_array",
+    "GL_AMD_vertex_shader_layer",
+    "GL_EXT_debug_label",
+    "GL_EXT_debug_marker",
+    "GL_EXT_memory_object",
+    "GL_EXT_memory_object_fd",
+    "GL_EXT_polygon_offset_clamp",
+    "GL_EXT_semaphore",
+    "GL_EXT_texture_compression_s3tc",
+    "GL_EXT_texture_filter_anisotropic",
+    "GL_EXT_texture_sRGB_decode",
+    "GL_KHR_blend_equation_advanced",
+    "GL_KHR_context_flush_control",
+    "GL_KHR_debug",
+    "GL_KHR_no_error",
+    "GL_KHR_parallel_shader_compile",
+    "GL_KHR_robustness",
+    "GL_KHR_texture_compression_astc_ldr",
+    "GL_NV_command_list",
+    "GL_NV_mesh_shader",
+    "GL_NVX_gpu_memory_info",
+    "GLX_ARB_create_context",
+    "GLX_EXT_swap_control",
+    "GLX_EXT_swap_control_tear",
+    "EGL_KHR_create_context",
+    "EGL_KHR_swap_buffers_with_damage",
+    "WGL_EXT_swap_control",
+    "WGL_EXT_swap_control_tear"
+};
+
+static void usage(void)
+{
+    printf("Usage: extensions [-h] [-n COUNT] [-c COUNT]\n");
+    printf("Options:\n");
+    printf("  -n the number of times to probe the extension list (default 1000)\n");
+    printf("  -c the number of contexts to create (default 10)\n");
+    printf("  -h show this help\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, j, count = 1000, contexts = 10, supported = 0;
+    const int extension_count = sizeof(extensions) / sizeof(extensions[0]);
+    double start, create = 0.0, first = 0.0, probe;
+
+    while ((ch = getopt(argc, argv, "hn:c:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                count = atoi(optarg);
+                break;
+
+            case 'c':
+                contexts = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (count < 1 || contexts < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    // Context re-creation is timed together with the first round of probes,
+    // as that is what a renderer pays each time it loses its context
+    for (i = 0;  i < contexts;  i++)
+    {
+        GLFWwindow* window;
+
+        start = glfwGetTime();
+        window = glfwCreateWindow(64, 64, "Extension Query Benchmark", NULL, NULL);
+        if (!window)
+        {
+            glfwTerminate();
+            exit(EXIT_FAILURE);
+        }
+
+        glfwMakeContextCurrent(window);
+        create += glfwGetTime() - start;
+
+        start = glfwGetTime();
+        for (j = 0;  j < extension_count;  j++)
+            glfwExtensionSupported(extensions[j]);
+        first += glfwGetTime() - start;
+
+        glfwDestroyWindow(window);
+    }
+
+    {
+        GLFWwindow* window =
+            glfwCreateWindow(64, 64, "Extension Query Benchmark", NULL, NULL);
+        if (!window)
+        {
+            glfwTerminate();
+            exit(EXIT_FAILURE);
+        }
+
+        glfwMakeContextCurrent(window);
+
+        start = glfwGetTime();
+        for (i = 0;  i < count;  i++)
+        {
+            supported = 0;
+            for (j = 0;  j < extension_count;  j++)
+                supported += glfwExtensionSupported(extensions[j]);
+        }
+        probe = glfwGetTime() - start;
+
+        glfwDestroyWindow(window);
+    }
+
+    printf("%i of %i extensions supported\n", supported, extension_count);
+    printf("Created a context in %.3f ms on average\n",
+           create * 1000.0 / contexts);
+    printf("First probe of %i extensions took %.3f us on average\n",
+           extension_count, first * 1e6 / contexts);
+    printf("Probed %i extensions in %.3f us on average (%.1f ns per query)\n",
+           extension_count, probe * 1e6 / count,
+           probe * 1e9 / ((double) count * extension_count));
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
+
@@ -0,0 +1,306 @@
+//========================================================================
+// Headless EGL context test
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test creates EGL contexts on the null platform and checks that the
+// framebuffer objects standing in for their default framebuffers behave like
+// one, across buffer swaps and window resizes, and that a windowless shared
+// context can create objects for a window on another thread
+//
+//========================================================================
+
+#include <glad/gl.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#define GLFW_EXPOSE_NATIVE_EGL
+#include <GLFW/glfw3native.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tinycthread.h"
+#include "getopt.h"
+
+static int failures = 0;
+
+static void usage(void)
+{
+    printf("Usage: headless [-h] [-s SAMPLES]\n");
+    printf("Options:\n");
+    printf("  -s the number of samples of the multisampled window (default 4)\n");
+    printf("  -h show this help\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void clear(float r, float g, float b)
+{
+    glClearColor(r, g, b, 1.f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+}
+
+static void check(const char* label, GLuint framebuffer, int x, int y,
+                  unsigned char r, unsigned char g, unsigned char b)
+{
+    unsigned char pixel[4];
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glReadPixels(x, y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+
+    if (pixel[0] != r || pixel[1] != g || pixel[2] != b)
+    {
+        printf("  %s: expected %u,%u,%u at %i,%i but read %u,%u,%u\n",
+               label, r, g, b, x, y, pixel[0], pixel[1], pixel[2]);
+        failures++;
+    }
+}
+
+static void test_window(const char* label, int doublebuffer, int samples)
+{
+    GLFWwindow* window;
+    GLuint back, front, previous;
+    GLint viewport[4];
+
+    printf("Testing %s window\n", label);
+
+    glfwWindowHint(GLFW_DOUBLEBUFFER, doublebuffer);
+    glfwWindowHint(GLFW_SAMPLES, samples);
+
+    window = glfwCreateWindow(64, 48, "Headless Test", NULL, NULL);
+    if (!window)
+    {
+        printf("  Failed to create window\n");
+        failures++;
+        return;
+    }
+
+    glfwMakeContextCurrent(window);
+    gladLoadGL(glfwGetProcAddress);
+
+    glfwGetEGLFramebuffers(window, &back, &front);
+    if (!back || (doublebuffer && !front) || (!doublebuffer && front))
+    {
+        printf("  Unexpected framebuffer objects %u and %u\n", back, front);
+        failures++;
+        glfwDestroyWindow(window);
+        return;
+    }
+
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    if (viewport[2] != 64 || viewport[3] != 48)
+    {
+        printf("  Unexpected initial viewport %ix%i\n", viewport[2], viewport[3]);
+        failures++;
+    }
+
+    clear(1.f, 0.f, 0.f);
+    glfwSwapBuffers(window);
+
+    if (doublebuffer)
+    {
+        glfwGetEGLFramebuffers(window, &back, &front);
+        check("first frame", front, 32, 24, 255, 0, 0);
+
+        // The front buffer must be left alone until the next swap
+        glBindFramebuffer(GL_FRAMEBUFFER, back);
+        clear(0.f, 1.f, 0.f);
+        check("before swap", front, 32, 24, 255, 0, 0);
+
+        previous = back;
+        glfwSwapBuffers(window);
+        glfwGetEGLFramebuffers(window, &back, &front);
+        check("second frame", front, 32, 24, 0, 255, 0);
+
+        // A default framebuffer binding follows the back buffer on swap
+        if (!samples)
+        {
+            GLint binding;
+            glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &binding);
+            if ((GLuint) binding != back || back == previous)
+            {
+                printf("  Back buffer binding %i was not moved to %u\n",
+                       binding, back);
+                failures++;
+            }
+        }
+    }
+    else
+        check("first frame", back, 32, 24, 255, 0, 0);
+
+    glfwSetWindowSize(window, 100, 80);
+    glfwSwapBuffers(window);
+    glfwGetEGLFramebuffers(window, &back, &front);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, back);
+    glViewport(0, 0, 100, 80);
+    clear(0.f, 0.f, 1.f);
+    glfwSwapBuffers(window);
+    glfwGetEGLFramebuffers(window, &back, &front);
+    check("after resize", doublebuffer ? front : back, 99, 79, 0, 0, 255);
+
+    glfwDestroyWindow(window);
+}
+
+static int upload_texture(void* data)
+{
+    GLFWwindow* context = data;
+    const unsigned char pixels[4 * 4 * 4] =
+    {
+        255, 0, 255, 255, 255, 0, 255, 255, 255, 0, 255, 255, 255, 0, 255, 255,
+        255, 0, 255, 255, 255, 0, 255, 255, 255, 0, 255, 255, 255, 0, 255, 255,
+        255, 0, 255, 255, 255, 0, 255, 255, 255, 0, 255, 255, 255, 0, 255, 255,
+        255, 0, 255, 255, 255, 0, 255, 255, 255, 0, 255, 255, 255, 0, 255, 255
+    };
+    GLuint texture;
+
+    glfwMakeContextCurrent(context);
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 4, 4, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+    // The texture must be complete before another context can use it
+    glFinish();
+
+    glfwMakeContextCurrent(NULL);
+    return (int) texture;
+}
+
+static void test_shared_context(void)
+{
+    GLFWwindow* window;
+    GLFWwindow* context;
+    GLuint texture, framebuffer;
+    thrd_t thread;
+    int result;
+
+    printf("Testing shared context\n");
+
+    glfwWindowHint(GLFW_DOUBLEBUFFER, GLFW_TRUE);
+    glfwWindowHint(GLFW_SAMPLES, 0);
+
+    window = glfwCreateWindow(64, 48, "Headless Test", NULL, NULL);
+    if (!window)
+    {
+        printf("  Failed to create window\n");
+        failures++;
+        return;
+    }
+
+    context = glfwCreateSharedContext(window);
+    if (!context)
+    {
+        printf("  Failed to create shared context\n");
+        failures++;
+        glfwDestroyWindow(window);
+        return;
+    }
+
+    if (thrd_create(&thread, upload_texture, context) != thrd_success)
+    {
+        printf("  Failed to create thread\n");
+        failures++;
+        glfwDestroyWindow(context);
+        glfwDestroyWindow(window);
+        return;
+    }
+
+    thrd_join(thread, &result);
+    texture = (GLuint) result;
+
+    glfwMakeContextCurrent(window);
+
+    if (!glIsTexture(texture))
+    {
+        printf("  Texture %u is not shared with the window\n", texture);
+        failures++;
+    }
+    else
+    {
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                               GL_TEXTURE_2D, texture, 0);
+        check("shared texture", framebuffer, 2, 2, 255, 0, 255);
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteTextures(1, &texture);
+    }
+
+    glfwDestroyWindow(context);
+    glfwDestroyWindow(window);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, samples = 4;
+
+    while ((ch = getopt(argc, argv, "hs:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 's':
+                samples = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+    glfwWindowHint(GLFW_DEPTH_BITS, 24);
+    glfwWindowHint(GLFW_STENCIL_BITS, 8);
+
+    test_window("single buffered", GLFW_FALSE, 0);
+    test_window("double buffered", GLFW_TRUE, 0);
+    test_window("multisampled", GLFW_TRUE, samples);
+    test_shared_context();
+
+    glfwTerminate();
+
+    if (failures)
+    {
+        printf("%i checks failed\n", failures);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("All checks passed\n");
+    exit(EXIT_SUCCESS);
+}
+
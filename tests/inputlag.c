@@ -25,6 +25,7 @@
 //
 // This test renders a marker at the cursor position reported by GLFW to
 // check how much it lags behind the hardware mouse cursor
+// It also reports the input-to-swap latency measured by the GLFW probe
 //
 //========================================================================
 
@@ -158,6 +159,7 @@ int main(int argc, char** argv)
     int fullscreen = GLFW_FALSE;
     GLFWmonitor* monitor = NULL;
     GLFWwindow* window;
+    GLFWlatencystats latency;
     struct nk_context* nk;
     struct nk_font_atlas* atlas;
 
@@ -223,6 +225,7 @@ int main(int argc, char** argv)
 
     glfwSetKeyCallback(window, key_callback);
     glfwSetCursorPosCallback(window, cursor_pos_callback);
+    glfwSetInputLatencyProbe(window, GLFW_TRUE);
 
     while (!glfwWindowShouldClose(window))
     {
@@ -275,6 +278,15 @@ int main(int argc, char** argv)
             nk_label(nk, "", 0); // separator
 
             nk_value_float(nk, "FPS", (float) frame_rate);
+            if (glfwGetInputLatency(window, &latency))
+            {
+                nk_labelf(nk, align_left, "Input to swap: p50 %.2f ms, p99 %.2f ms (%u samples)",
+                          latency.p50 * 1000.0, latency.p99 * 1000.0, latency.count);
+            }
+            else
+                nk_label(nk, "Input to swap: no samples yet", align_left);
+            if (nk_button_label(nk, "Reset latency"))
+                glfwResetInputLatency(window);
             if (nk_checkbox_label(nk, "Enable vsync", &enable_vsync))
                 update_vsync();
 
@@ -303,6 +315,15 @@ int main(int argc, char** argv)
         }
     }
 
+    if (glfwGetInputLatency(window, &latency))
+    {
+        printf("Input to swap latency over %u samples:\n", latency.count);
+        printf("  p50 %.3f ms\n", latency.p50 * 1000.0);
+        printf("  p95 %.3f ms\n", latency.p95 * 1000.0);
+        printf("  p99 %.3f ms\n", latency.p99 * 1000.0);
+        printf("  max %.3f ms\n", latency.max * 1000.0);
+    }
+
     glfwTerminate();
     exit(EXIT_SUCCESS);
 }
@@ -0,0 +1,176 @@
+//========================================================================
+// Gamepad mapping database benchmark
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test measures how long it takes to load a gamepad mapping database,
+// either a file like gamecontrollerdb.txt from SDL_GameControllerDB or a
+// generated one of the specified size
+//
+//========================================================================
+
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: mappings [-h] [-n COUNT] [FILE]\n");
+    printf("Options:\n");
+    printf("  -n the number of mappings to generate if no file is given (default 10000)\n");
+    printf("  -h show this help\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static char* read_file(const char* path)
+{
+    long size;
+    char* text;
+    FILE* file = fopen(path, "rb");
+    if (!file)
+        return NULL;
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    text = calloc(size + 1, 1);
+    if (fread(text, 1, size, file) != (size_t) size)
+    {
+        free(text);
+        text = NULL;
+    }
+
+    fclose(file);
+    return text;
+}
+
+// Generates a database in the SDL_GameControllerDB format where each device
+// has one mapping per platform, like the real one
+//
+static char* generate_mappings(int count)
+{
+    static const char* platforms[] = { "Windows", "Mac OS X", "Linux" };
+    const size_t line_size = 512;
+    char* text = calloc(count, line_size);
+    char* line = text;
+    int i;
+
+    for (i = 0;  i < count;  i++)
+    {
+        const unsigned int device = (unsigned int) (i / 3) * 2654435761u;
+
+        line += sprintf(line,
+                        "0300%08x0000%08x00000000,Generated Gamepad %i,"
+                        "a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,"
+                        "dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,"
+                        "lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,"
+                        "rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,"
+                        "start:b7,x:b2,y:b3,platform:%s,\n",
+                        device, device ^ 0x5bd1e995u, i / 3,
+                        platforms[i % 3]);
+    }
+
+    return text;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, count = 10000, lines = 0;
+    double start, first, second;
+    char* text;
+    const char* c;
+
+    while ((ch = getopt(argc, argv, "hn:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                count = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (count < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    if (optind < argc)
+    {
+        text = read_file(argv[optind]);
+        if (!text)
+        {
+            fprintf(stderr, "Failed to read %s\n", argv[optind]);
+            glfwTerminate();
+            exit(EXIT_FAILURE);
+        }
+    }
+    else
+        text = generate_mappings(count);
+
+    for (c = text;  *c;  c++)
+    {
+        if (*c == '\n')
+            lines++;
+    }
+
+    start = glfwGetTime();
+    glfwUpdateGamepadMappings(text);
+    first = glfwGetTime() - start;
+
+    // Loading the same database again replaces every mapping in place
+    start = glfwGetTime();
+    glfwUpdateGamepadMappings(text);
+    second = glfwGetTime() - start;
+
+    printf("Loaded %i lines in %.3f ms\n", lines, first * 1000.0);
+    printf("Reloaded %i lines in %.3f ms\n", lines, second * 1000.0);
+
+    free(text);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
+
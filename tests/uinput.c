@@ -0,0 +1,687 @@
+//========================================================================
+// Virtual joystick test and benchmark
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test creates virtual gamepads with uinput and uses them to check and
+// measure the Linux joystick code without any real hardware or windows
+//
+// It first plugs and unplugs the gamepads a number of times, measuring how
+// long it takes for GLFW to report them, then floods them with reports and
+// measures how quickly and with how many read system calls GLFW drains them,
+// then overflows the kernel event buffers and measures how long GLFW takes to
+// resynchronize after the dropped events, and finally measures the latency
+// from writing a single report to the uinput device until the joystick axis
+// callback is called
+//
+// It needs write access to /dev/uinput and read access to the event devices
+// the kernel creates for it
+//
+//========================================================================
+
+#define _GNU_SOURCE
+
+#include <GLFW/glfw3.h>
+
+#include <linux/input.h>
+#include <linux/uinput.h>
+
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "getopt.h"
+
+#define MAX_DEVICES 4
+#define MAX_AXES 11
+#define MAX_BUTTONS 55
+#define MAX_HATS 4
+
+// More reports than fit in the event buffer of an evdev client, so that the
+// kernel drops events and reports SYN_DROPPED
+#define OVERFLOW_REPORTS 4096
+
+static const int axis_codes[MAX_AXES] =
+{
+    ABS_X, ABS_Y, ABS_Z, ABS_RX, ABS_RY, ABS_RZ,
+    ABS_THROTTLE, ABS_RUDDER, ABS_WHEEL, ABS_GAS, ABS_BRAKE
+};
+
+typedef struct Device
+{
+    int fd;
+    int jid;
+    double created;
+    double destroyed;
+    double reported;
+} Device;
+
+static Device devices[MAX_DEVICES];
+static int device_count = 1;
+static int axis_count = 6;
+static int button_count = 11;
+static int hat_count = 1;
+
+static double latency_sent;
+static double latency_received;
+static float latency_value;
+
+static void usage(void)
+{
+    printf("Usage: uinput [-h] [-d DEVICES] [-a AXES] [-b BUTTONS] [-s HATS]\n");
+    printf("              [-n REPORTS] [-p REPORTS] [-r RATE] [-c CYCLES] [-l SAMPLES]\n");
+    printf("Options:\n");
+    printf("  -d the number of virtual gamepads (default 1, max %i)\n", MAX_DEVICES);
+    printf("  -a the number of axes per gamepad (default 6, max %i)\n", MAX_AXES);
+    printf("  -b the number of buttons per gamepad (default 11, max %i)\n", MAX_BUTTONS);
+    printf("  -s the number of hats per gamepad (default 1, max %i)\n", MAX_HATS);
+    printf("  -n the number of reports to send per gamepad (default 100000)\n");
+    printf("  -p the number of reports to send between polls (default as many as the\n");
+    printf("     kernel can buffer without dropping events)\n");
+    printf("  -r the number of reports to send per second (default 0 for unlimited)\n");
+    printf("  -c the number of hotplug cycles (default 3)\n");
+    printf("  -l the number of latency samples (default 1000)\n");
+    printf("  -h show this help\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static int find_device(const char* name)
+{
+    int i;
+
+    for (i = 0;  i < device_count;  i++)
+    {
+        char expected[UINPUT_MAX_NAME_SIZE];
+        snprintf(expected, sizeof(expected), "GLFW virtual gamepad %i", i + 1);
+        if (strcmp(name, expected) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+static void joystick_callback(int jid, int event)
+{
+    int i;
+
+    if (event == GLFW_CONNECTED)
+    {
+        i = find_device(glfwGetJoystickName(jid));
+        if (i != -1)
+        {
+            devices[i].jid = jid;
+            devices[i].reported = glfwGetTime();
+        }
+    }
+    else if (event == GLFW_DISCONNECTED)
+    {
+        for (i = 0;  i < device_count;  i++)
+        {
+            if (devices[i].jid == jid)
+            {
+                devices[i].jid = -1;
+                devices[i].reported = glfwGetTime();
+            }
+        }
+    }
+}
+
+static void joystick_axis_callback(int jid, int axis, float value)
+{
+    if (jid == devices[0].jid && axis == 0 && value == latency_value)
+        latency_received = glfwGetTime();
+}
+
+// Returns the number of read system calls made by this process so far
+//
+static unsigned long long read_syscalls(void)
+{
+    char line[256];
+    unsigned long long count = 0;
+    FILE* file = fopen("/proc/self/io", "r");
+    if (!file)
+        return 0;
+
+    while (fgets(line, sizeof(line), file))
+    {
+        if (sscanf(line, "syscr: %llu", &count) == 1)
+            break;
+    }
+
+    fclose(file);
+    return count;
+}
+
+// Returns the number of reports that fit in the event buffer of an evdev client
+// This mirrors input_estimate_events_per_packet and evdev_compute_buffer_size in
+// the kernel, which also splits reports larger than the estimated packet size
+//
+static int buffered_reports(void)
+{
+    const int packet = 1 + axis_count + hat_count * 2 + 7;
+    const int values = axis_count + button_count + hat_count * 2;
+    const int events = values + (values + packet - 1) / packet;
+    int size = 64, count;
+
+    while (size < packet * 8)
+        size *= 2;
+
+    // The buffer overflows when its last slot is filled
+    count = (size - 1) / events;
+    return count ? count : 1;
+}
+
+static int button_code(int index)
+{
+    if (index < BTN_THUMBR - BTN_SOUTH + 1)
+        return BTN_SOUTH + index;
+    else
+        return BTN_TRIGGER_HAPPY1 + index - (BTN_THUMBR - BTN_SOUTH + 1);
+}
+
+// Returns the axis value GLFW will report for the specified uinput value
+//
+static float normalize(int value)
+{
+    return ((float) (value + 32768) / 65535.f) * 2.f - 1.f;
+}
+
+static void set_event(struct input_event* event, int type, int code, int value)
+{
+    memset(event, 0, sizeof(struct input_event));
+    event->type = type;
+    event->code = code;
+    event->value = value;
+}
+
+static void write_events(int fd, const struct input_event* events, int count)
+{
+    const ssize_t size = sizeof(struct input_event) * count;
+
+    if (write(fd, events, size) != size)
+    {
+        perror("Failed to write uinput events");
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Writes a report where every axis, button and hat has changed
+//
+static void write_report(const Device* device, int report)
+{
+    struct input_event events[MAX_AXES + MAX_BUTTONS + MAX_HATS * 2 + 1];
+    int i, count = 0;
+
+    for (i = 0;  i < axis_count;  i++)
+    {
+        set_event(events + count++, EV_ABS, axis_codes[i],
+                  (report * 7 + i) % 65536 - 32768);
+    }
+
+    for (i = 0;  i < button_count;  i++)
+        set_event(events + count++, EV_KEY, button_code(i), (report + i) & 1);
+
+    for (i = 0;  i < hat_count;  i++)
+    {
+        set_event(events + count++, EV_ABS, ABS_HAT0X + i * 2, report % 3 - 1);
+        set_event(events + count++, EV_ABS, ABS_HAT0Y + i * 2, (report + 1) % 3 - 1);
+    }
+
+    set_event(events + count++, EV_SYN, SYN_REPORT, 0);
+    write_events(device->fd, events, count);
+}
+
+static void create_device(Device* device, int index)
+{
+    struct uinput_user_dev dev;
+    int i;
+
+    device->fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+    if (device->fd == -1)
+    {
+        perror("Failed to open /dev/uinput");
+        exit(EXIT_FAILURE);
+    }
+
+    memset(&dev, 0, sizeof(dev));
+    snprintf(dev.name, UINPUT_MAX_NAME_SIZE, "GLFW virtual gamepad %i", index + 1);
+    dev.id.bustype = BUS_VIRTUAL;
+    dev.id.vendor = 0x1234;
+    dev.id.product = 0x5678 + index;
+    dev.id.version = 1;
+
+    ioctl(device->fd, UI_SET_EVBIT, EV_KEY);
+    ioctl(device->fd, UI_SET_EVBIT, EV_ABS);
+    ioctl(device->fd, UI_SET_EVBIT, EV_SYN);
+
+    for (i = 0;  i < button_count;  i++)
+        ioctl(device->fd, UI_SET_KEYBIT, button_code(i));
+
+    for (i = 0;  i < axis_count;  i++)
+    {
+        ioctl(device->fd, UI_SET_ABSBIT, axis_codes[i]);
+        dev.absmin[axis_codes[i]] = -32768;
+        dev.absmax[axis_codes[i]] = 32767;
+    }
+
+    for (i = 0;  i < hat_count * 2;  i++)
+    {
+        ioctl(device->fd, UI_SET_ABSBIT, ABS_HAT0X + i);
+        dev.absmin[ABS_HAT0X + i] = -1;
+        dev.absmax[ABS_HAT0X + i] = 1;
+    }
+
+    if (write(device->fd, &dev, sizeof(dev)) != sizeof(dev) ||
+        ioctl(device->fd, UI_DEV_CREATE) < 0)
+    {
+        perror("Failed to create uinput device");
+        exit(EXIT_FAILURE);
+    }
+
+    device->jid = -1;
+    device->created = glfwGetTime();
+}
+
+static void destroy_device(Device* device)
+{
+    device->destroyed = glfwGetTime();
+    ioctl(device->fd, UI_DEV_DESTROY);
+    close(device->fd);
+    device->fd = -1;
+}
+
+// Waits until every virtual gamepad is connected or disconnected and returns
+// the sum of the time it took for GLFW to report each of them
+//
+static double wait_for_devices(int connected)
+{
+    const double start = glfwGetTime();
+    double total = 0.0;
+    int i, pending[MAX_DEVICES];
+
+    for (i = 0;  i < device_count;  i++)
+        pending[i] = GLFW_TRUE;
+
+    for (;;)
+    {
+        int remaining = 0;
+
+        for (i = 0;  i < device_count;  i++)
+        {
+            if (pending[i] && (devices[i].jid != -1) == connected)
+            {
+                if (connected)
+                    total += devices[i].reported - devices[i].created;
+                else
+                    total += devices[i].reported - devices[i].destroyed;
+
+                pending[i] = GLFW_FALSE;
+            }
+
+            remaining += pending[i];
+        }
+
+        if (!remaining)
+            break;
+
+        // Wait for udev to make new event devices accessible
+        if (glfwGetTime() - start > 5.0)
+        {
+            fprintf(stderr, "Virtual gamepads did not %s\n",
+                    connected ? "show up as joysticks" : "disconnect");
+            glfwTerminate();
+            exit(EXIT_FAILURE);
+        }
+
+        glfwWaitEventsTimeout(0.01);
+    }
+
+    return total;
+}
+
+static void sleep_until(double time)
+{
+    const double delay = time - glfwGetTime();
+    if (delay > 0.0)
+    {
+        struct timespec ts;
+        ts.tv_sec = (time_t) delay;
+        ts.tv_nsec = (long) ((delay - ts.tv_sec) * 1e9);
+        nanosleep(&ts, NULL);
+    }
+}
+
+static int compare_doubles(const void* first, const void* second)
+{
+    const double a = *((const double*) first);
+    const double b = *((const double*) second);
+    return (a > b) - (a < b);
+}
+
+// Checks that GLFW reports the state written by the specified report
+//
+static int check_state(const Device* device, int report)
+{
+    int i, axes, buttons, hats, result = GLFW_TRUE;
+    const float* axis_state = glfwGetJoystickAxes(device->jid, &axes);
+    const unsigned char* button_state = glfwGetJoystickButtons(device->jid, &buttons);
+    const unsigned char* hat_state = glfwGetJoystickHats(device->jid, &hats);
+
+    if (!axis_state || axes != axis_count ||
+        !hat_state || hats != hat_count ||
+        !button_state || buttons < button_count)
+    {
+        fprintf(stderr, "Joystick %i has the wrong layout\n", device->jid + 1);
+        return GLFW_FALSE;
+    }
+
+    for (i = 0;  i < axis_count;  i++)
+    {
+        const float expected = normalize((report * 7 + i) % 65536 - 32768);
+        if (axis_state[i] != expected)
+        {
+            fprintf(stderr, "Joystick %i axis %i is %f, expected %f\n",
+                    device->jid + 1, i, axis_state[i], expected);
+            result = GLFW_FALSE;
+        }
+    }
+
+    for (i = 0;  i < button_count;  i++)
+    {
+        if (button_state[i] != ((report + i) & 1))
+        {
+            fprintf(stderr, "Joystick %i button %i is %i, expected %i\n",
+                    device->jid + 1, i, button_state[i], (report + i) & 1);
+            result = GLFW_FALSE;
+        }
+    }
+
+    for (i = 0;  i < hat_count;  i++)
+    {
+        static const unsigned char x_bits[3] = { GLFW_HAT_LEFT, 0, GLFW_HAT_RIGHT };
+        static const unsigned char y_bits[3] = { GLFW_HAT_UP, 0, GLFW_HAT_DOWN };
+        const unsigned char expected = x_bits[report % 3] | y_bits[(report + 1) % 3];
+
+        if (hat_state[i] != expected)
+        {
+            fprintf(stderr, "Joystick %i hat %i is %i, expected %i\n",
+                    device->jid + 1, i, hat_state[i], expected);
+            result = GLFW_FALSE;
+        }
+    }
+
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, report, sample, cycle, count;
+    int report_count = 100000, batch_size = 0, cycle_count = 3;
+    int sample_count = 1000, polls = 0, result = EXIT_SUCCESS;
+    double rate = 0.0, start, elapsed;
+    double connect_time = 0.0, disconnect_time = 0.0;
+    double* latencies;
+    unsigned long long reads, overhead;
+
+    while ((ch = getopt(argc, argv, "a:b:c:d:hl:n:p:r:s:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'a':
+                axis_count = atoi(optarg);
+                break;
+
+            case 'b':
+                button_count = atoi(optarg);
+                break;
+
+            case 'c':
+                cycle_count = atoi(optarg);
+                break;
+
+            case 'd':
+                device_count = atoi(optarg);
+                break;
+
+            case 'l':
+                sample_count = atoi(optarg);
+                break;
+
+            case 'n':
+                report_count = atoi(optarg);
+                break;
+
+            case 'p':
+                batch_size = atoi(optarg);
+                break;
+
+            case 'r':
+                rate = atof(optarg);
+                break;
+
+            case 's':
+                hat_count = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (device_count < 1 || device_count > MAX_DEVICES ||
+        axis_count < 1 || axis_count > MAX_AXES ||
+        button_count < 1 || button_count > MAX_BUTTONS ||
+        hat_count < 0 || hat_count > MAX_HATS ||
+        report_count < 1 || batch_size < 0 || rate < 0.0 ||
+        cycle_count < 0 || sample_count < 0)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    // Larger batches overflow the kernel buffers and measure resynchronization
+    if (!batch_size)
+        batch_size = buffered_reports();
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwSetJoystickCallback(joystick_callback);
+    glfwSetJoystickAxisCallback(joystick_axis_callback);
+
+    // Plug and unplug the gamepads to exercise device discovery
+
+    for (cycle = 0;  cycle < cycle_count;  cycle++)
+    {
+        for (i = 0;  i < device_count;  i++)
+            create_device(devices + i, i);
+
+        connect_time += wait_for_devices(GLFW_TRUE);
+
+        for (i = 0;  i < device_count;  i++)
+            destroy_device(devices + i);
+
+        disconnect_time += wait_for_devices(GLFW_FALSE);
+    }
+
+    if (cycle_count)
+    {
+        printf("Hotplug: %i cycles of %i gamepads, %.3f ms to connect, %.3f ms to disconnect\n",
+               cycle_count, device_count,
+               connect_time * 1000.0 / (cycle_count * device_count),
+               disconnect_time * 1000.0 / (cycle_count * device_count));
+    }
+
+    for (i = 0;  i < device_count;  i++)
+        create_device(devices + i, i);
+
+    wait_for_devices(GLFW_TRUE);
+
+    for (i = 0;  i < device_count;  i++)
+        printf("Virtual gamepad %i is joystick %i\n", i + 1, devices[i].jid + 1);
+
+    // Flood the gamepads with reports and measure how GLFW drains them
+
+    // Reading the counter is itself a read call, so measure that overhead
+    overhead = read_syscalls();
+    overhead = read_syscalls() - overhead;
+
+    reads = 0;
+    elapsed = 0.0;
+    start = glfwGetTime();
+
+    for (report = 0;  report < report_count;  report++)
+    {
+        if (rate > 0.0)
+            sleep_until(start + report / rate);
+
+        for (i = 0;  i < device_count;  i++)
+            write_report(devices + i, report);
+
+        if ((report + 1) % batch_size == 0 || report + 1 == report_count)
+        {
+            const unsigned long long before = read_syscalls();
+            const double poll_start = glfwGetTime();
+
+            glfwPollEvents();
+            for (i = 0;  i < device_count;  i++)
+                glfwGetJoystickAxes(devices[i].jid, &count);
+
+            elapsed += glfwGetTime() - poll_start;
+            reads += read_syscalls() - before - overhead;
+            polls++;
+        }
+    }
+
+    for (i = 0;  i < device_count;  i++)
+    {
+        if (devices[i].jid == -1)
+        {
+            fprintf(stderr, "Lost virtual gamepad %i during the run\n", i + 1);
+            result = EXIT_FAILURE;
+        }
+        else if (!check_state(devices + i, report_count - 1))
+            result = EXIT_FAILURE;
+    }
+
+    printf("Throughput: %i reports from %i gamepads in %i polls of %i took %.3f ms (%.3f us per report)\n",
+           report_count, device_count, polls, batch_size, elapsed * 1000.0,
+           elapsed * 1e6 / ((double) report_count * device_count));
+    printf("Throughput: %llu read calls (%.3f per report)\n",
+           reads, (double) reads / ((double) report_count * device_count));
+
+    // Overflow the event buffers and measure how GLFW recovers the state
+
+    for (report = report_count;  report < report_count + OVERFLOW_REPORTS;  report++)
+    {
+        for (i = 0;  i < device_count;  i++)
+            write_report(devices + i, report);
+    }
+
+    start = glfwGetTime();
+
+    glfwPollEvents();
+    for (i = 0;  i < device_count;  i++)
+        glfwGetJoystickAxes(devices[i].jid, &count);
+
+    elapsed = glfwGetTime() - start;
+
+    for (i = 0;  i < device_count;  i++)
+    {
+        if (devices[i].jid != -1 && !check_state(devices + i, report - 1))
+        {
+            fprintf(stderr, "Joystick %i did not recover from dropped events\n",
+                    devices[i].jid + 1);
+            result = EXIT_FAILURE;
+        }
+    }
+
+    printf("Overflow: %i reports from %i gamepads took %.3f ms to drain and resynchronize\n",
+           OVERFLOW_REPORTS, device_count, elapsed * 1000.0);
+
+    // Send single reports and measure how long until the callback sees them
+
+    latencies = calloc(sample_count ? sample_count : 1, sizeof(double));
+
+    for (sample = 0;  sample < sample_count && devices[0].jid != -1;  sample++)
+    {
+        struct input_event events[2];
+        const int value = (sample & 1) ? 16384 : -16384;
+
+        set_event(events + 0, EV_ABS, axis_codes[0], value);
+        set_event(events + 1, EV_SYN, SYN_REPORT, 0);
+
+        latency_value = normalize(value);
+        latency_received = 0.0;
+        latency_sent = glfwGetTime();
+        write_events(devices[0].fd, events, 2);
+
+        while (latency_received == 0.0 && glfwGetTime() - latency_sent < 1.0)
+            glfwWaitEventsTimeout(1.0);
+
+        if (latency_received == 0.0)
+        {
+            fprintf(stderr, "Axis callback not called within a second\n");
+            result = EXIT_FAILURE;
+            break;
+        }
+
+        latencies[sample] = latency_received - latency_sent;
+
+        if (rate > 0.0)
+            sleep_until(latency_sent + 1.0 / rate);
+    }
+
+    if (sample)
+    {
+        qsort(latencies, sample, sizeof(double), compare_doubles);
+        printf("Latency: %i samples, p50 %.1f us, p99 %.1f us, max %.1f us\n",
+               sample,
+               latencies[sample / 2] * 1e6,
+               latencies[sample * 99 / 100] * 1e6,
+               latencies[sample - 1] * 1e6);
+    }
+
+    free(latencies);
+
+    for (i = 0;  i < device_count;  i++)
+        destroy_device(devices + i);
+
+    glfwTerminate();
+    exit(result);
+}
+